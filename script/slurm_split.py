@@ -4,8 +4,18 @@ import os
 import sys
 
 if __name__ == "__main__":
+    # With --dynamic [chunk size] all processes share the whole range and claim chunks dynamically instead
+    chunkSize = 0
+    if len(sys.argv) > 2 and sys.argv[1] == "--dynamic":
+        chunkSize = int(sys.argv[2])
+        if chunkSize <= 0:
+            print("Incorrect chunk size")
+            sys.exit(1)
+        del sys.argv[1:3]
+
     if len(sys.argv) < 6:
-        print("Usage: {} [nodes] [processes per node] [cores per process] [total] (mbl command)".format(sys.argv[0]))
+        print("Usage: {} (--dynamic [chunk size]) [nodes] [processes per node] [cores per process] [total] "
+              "(mbl command)".format(sys.argv[0]))
         sys.exit(1)
 
     nodes = int(sys.argv[1])
@@ -34,7 +44,12 @@ if __name__ == "__main__":
         srunCommand = "srun -N 1 -n 1 -c {} bash -c '\n".format(processesPerNode * coresPerProcess)
         for process in range(processesPerNode):
             toParam = min(fromParam + simulationsPerProcess, totalParam)
-            srunCommand += "    {} -P from={} -P to={} &\n".format(mblCommand, int(round(fromParam)), int(round(toParam)))
+            if chunkSize > 0:
+                srunCommand += "    {} -P from=0 -P to={} -P splitWorkload=true -P schedulerChunkSize={} &\n"\
+                    .format(mblCommand, totalParam, chunkSize)
+            else:
+                srunCommand += "    {} -P from={} -P to={} &\n".format(mblCommand, int(round(fromParam)),
+                                                                     int(round(toParam)))
             fromParam += simulationsPerProcess
         srunCommand += "    wait\n' &\n\n"
         fullCommand += srunCommand
@@ -3,6 +3,7 @@
 //
 
 #include <functional>
+#include <algorithm>
 
 #include "Analyzer.h"
 
@@ -20,6 +21,20 @@ void Analyzer::analyze(const Eigensystem &eigensystem, Logger &logger) {
         task->analyze(eigensystem, logger);
 }
 
+std::optional<std::vector<std::size_t>> Analyzer::getRequiredEigenvectors(const Eigensystem &eigensystem) const {
+    std::vector<std::size_t> indices;
+    for (const auto &task : this->tasks) {
+        auto taskIndices = task->getRequiredEigenvectors(eigensystem);
+        if (!taskIndices.has_value())
+            return std::nullopt;
+        indices.insert(indices.end(), taskIndices->begin(), taskIndices->end());
+    }
+
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+    return indices;
+}
+
 void Analyzer::storeBulkResults(const std::string &fileSignature) const {
     for (const auto &task : this->tasks) {
         try {
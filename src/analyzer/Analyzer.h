@@ -8,6 +8,7 @@
 
 #include <vector>
 #include <memory>
+#include <optional>
 
 #include "core/Eigensystem.h"
 #include "AnalyzerTask.h"
@@ -48,6 +49,12 @@ public:
      */
     void analyze(const Eigensystem &eigensystem, Logger &logger);
 
+    /**
+     * @brief Returns ascending indices of eigenvectors needed by any of the tasks (see
+     * AnalyzerTask::getRequiredEigenvectors) or std::nullopt if all of them are needed.
+     */
+    [[nodiscard]] std::optional<std::vector<std::size_t>> getRequiredEigenvectors(const Eigensystem &eigensystem) const;
+
     /**
      * @brief Returns a vector of names of fields imploded from all InlineAnalyzerTask -s. The order is the same
      * as in Analyzer::getInlineResultsFields.
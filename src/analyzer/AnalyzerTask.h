@@ -7,6 +7,7 @@
 
 #include <vector>
 #include <string>
+#include <optional>
 
 #include "core/Eigensystem.h"
 #include "simulation/Restorable.h"
@@ -27,6 +28,19 @@ public:
      */
     virtual void analyze(const Eigensystem &eigensystem, Logger &logger) = 0;
 
+    /**
+     * @brief Returns ascending indices of eigenvectors, which analyze() will need for the Eigensystem with
+     * eigenenergies given by @a eigensystem (which may contain no eigenvectors), or std::nullopt if all of them are
+     * needed.
+     * @details It enables calculating only the eigenvectors which are actually used. The default implementation
+     * requests all of them.
+     */
+    [[nodiscard]] virtual std::optional<std::vector<std::size_t>>
+    getRequiredEigenvectors([[maybe_unused]] const Eigensystem &eigensystem) const
+    {
+        return std::nullopt;
+    }
+
     /**
      * @brief Returns the name of the analyzer task. It can be used for example for file name suffixes.
      */
@@ -2,6 +2,8 @@
 // Created by Piotr Kubala on 28/03/2021.
 //
 
+#include <sstream>
+
 #include "BandExtractor.h"
 #include "utils/Assertions.h"
 
@@ -44,11 +46,24 @@ std::vector<std::size_t> BandExtractor::getBandIndices(const Eigensystem &eigens
         throw std::runtime_error("Internal error");
 }
 
+std::optional<std::vector<std::size_t>> BandExtractor::getRequiredBandIndices(const Eigensystem &eigensystem) const {
+    // The middle energy of VectorRange is calculated from eigenvectors
+    if (std::holds_alternative<VectorRange>(this->range))
+        return std::nullopt;
+
+    std::ostringstream discardedLog;
+    Logger silentLogger(discardedLog);
+    return this->getBandIndices(eigensystem, silentLogger);
+}
+
 std::vector<std::size_t> BandExtractor::getIndicesForCDFRange(const Eigensystem &eigensystem,
                                                               const arma::vec &normalizedEnergies,
                                                               const BandExtractor::CDFRange &cdfRange,
                                                               Logger &logger) const
 {
+    if (!eigensystem.hasFullSpectrum())
+        throw std::runtime_error("CDF range cannot be used for only a window of the spectrum");
+
     double relativeIndexStart = cdfRange.cdfMiddle - cdfRange.cdfMargin / 2;
     double relativeIndexEnd = cdfRange.cdfMiddle + cdfRange.cdfMargin / 2;
     auto indexStart = static_cast<std::size_t>(eigensystem.size() * relativeIndexStart);
@@ -115,10 +130,12 @@ double BandExtractor::calculateEnergyOfFockState(const FockBasis::Vector &state,
 {
     Assert(eigensystem.hasFockBasis());
     Assert(eigensystem.hasEigenvectors());
+    if (!eigensystem.hasFullSpectrum())
+        throw std::runtime_error("Energy of the Fock state cannot be calculated from only a window of the spectrum");
 
     const auto &basis = eigensystem.getFockBasis();
     std::size_t basisIndex = *basis.findIndex(state);
-    arma::vec fockVector(eigensystem.size(), arma::fill::zeros);
+    arma::vec fockVector(basis.size(), arma::fill::zeros);
     fockVector[basisIndex] = 1;
 
     const arma::mat &eigvec = eigensystem.getEigenstates();
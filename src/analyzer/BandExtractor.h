@@ -8,6 +8,7 @@
 #include <utility>
 #include <variant>
 #include <vector>
+#include <optional>
 
 #include "core/FockBasis.h"
 #include "core/Eigensystem.h"
@@ -100,6 +101,13 @@ public:
      * @brief Returns the (subsequent) indices of states in @a eigensystem in the band specified in a constructor.
      */
     std::vector<std::size_t> getBandIndices(const Eigensystem &eigensystem,  Logger &logger) const;
+
+    /**
+     * @brief Returns the same indices as getBandIndices(), but without logging anything, or std::nullopt if they
+     * cannot be determined without eigenvectors (VectorRange).
+     * @details It is used to tell which eigenvectors will be needed when @a eigensystem contains only eigenenergies.
+     */
+    [[nodiscard]] std::optional<std::vector<std::size_t>> getRequiredBandIndices(const Eigensystem &eigensystem) const;
 };
 
 
@@ -38,27 +38,33 @@ void BulkMeanGapRatio::analyze(const Eigensystem &eigensystem, Logger &logger) {
             numEntries++;
         }
         if (numEntries > 0)
-            this->gapRatios[binIdx].push_back(singleGapRatio / numEntries);
+            this->gapRatios[binIdx].add(singleGapRatio / numEntries);
     }
 }
 
+std::optional<std::vector<std::size_t>>
+BulkMeanGapRatio::getRequiredEigenvectors([[maybe_unused]] const Eigensystem &eigensystem) const
+{
+    return std::vector<std::size_t>{};
+}
+
 void BulkMeanGapRatio::storeResult(std::ostream &out) const {
     std::size_t numBins = this->gapRatios.size();
     for (std::size_t binIdx{}; binIdx < numBins; binIdx++) {
         double binBeg = static_cast<double>(binIdx) / numBins;
         Quantity binValue;
-        binValue.calculateFromSamples(this->gapRatios[binIdx]);
+        binValue.calculateFromCollector(this->gapRatios[binIdx]);
         binValue.separator = Quantity::Separator::SPACE;
         out << binBeg << " " << binValue << std::endl;
     }
 }
 
 void BulkMeanGapRatio::storeState(std::ostream &binaryOut) const {
-    RestorableHelper::storeStateForHistogram(this->gapRatios, binaryOut);
+    RestorableHelper::storeStateForSampleCollectors(this->gapRatios, binaryOut);
 }
 
 void BulkMeanGapRatio::joinRestoredState(std::istream &binaryIn) {
-    RestorableHelper::joinRestoredStateForHistogram(this->gapRatios, binaryIn);
+    RestorableHelper::joinRestoredStateForSampleCollectors(this->gapRatios, binaryIn);
 }
 
 void BulkMeanGapRatio::clear() {
@@ -9,6 +9,7 @@
 #include "analyzer/BulkAnalyzerTask.h"
 
 #include "utils/Assertions.h"
+#include "utils/SampleCollector.h"
 
 /**
  * @brief Task like MeanGapRatio, but whole spectrum is divided in bins and it is calculated separately for each.
@@ -16,12 +17,23 @@
  */
 class BulkMeanGapRatio : public BulkAnalyzerTask {
 private:
-    std::vector<std::vector<double>> gapRatios;
+    std::vector<SampleCollector> gapRatios;
 
 public:
-    explicit BulkMeanGapRatio(std::size_t numBins) : gapRatios(numBins) { Expects(numBins > 0); }
+    /**
+     * @param numBins number of bins to divide the spectrum into
+     * @param streamStatistics if true, only the statistics of the samples are kept instead of all of them (see
+     * SampleCollector)
+     */
+    explicit BulkMeanGapRatio(std::size_t numBins, bool streamStatistics = false)
+            : gapRatios(numBins, SampleCollector(streamStatistics))
+    {
+        Expects(numBins > 0);
+    }
 
     void analyze(const Eigensystem &eigensystem, Logger &logger) override;
+    [[nodiscard]] std::optional<std::vector<std::size_t>>
+    getRequiredEigenvectors(const Eigensystem &eigensystem) const override;
     [[nodiscard]] std::string getName() const override { return "mgrs"; }
 
     /**
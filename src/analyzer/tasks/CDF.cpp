@@ -25,7 +25,13 @@ void CDF::analyze(const Eigensystem &eigensystem, [[maybe_unused]] Logger &logge
     }
 
     for (std::size_t i{}; i < this->cdfTable.size(); i++)
-        this->cdfTable[i].push_back(binsValue[i] / eigensystem.size());
+        this->cdfTable[i].add(binsValue[i] / eigensystem.size());
+}
+
+std::optional<std::vector<std::size_t>>
+CDF::getRequiredEigenvectors([[maybe_unused]] const Eigensystem &eigensystem) const
+{
+    return std::vector<std::size_t>{};
 }
 
 std::string CDF::getName() const {
@@ -37,22 +43,21 @@ void CDF::storeResult(std::ostream &out) const {
     for (std::size_t i = 0; i < steps; i++) {
         out << (static_cast<double>(i) / static_cast<double>(steps - 1));
         out << " ";
-        auto &entry = this->cdfTable[i];
-        out << std::accumulate(entry.begin(), entry.end(), 0.) / entry.size();
+        out << this->cdfTable[i].getMean();
         out << std::endl;
     }
 }
 
-CDF::CDF(std::size_t bins) : cdfTable(bins) {
+CDF::CDF(std::size_t bins, bool streamStatistics) : cdfTable(bins, SampleCollector(streamStatistics)) {
     Expects(bins >= 2);
 }
 
 void CDF::storeState(std::ostream &binaryOut) const {
-    RestorableHelper::storeStateForHistogram(this->cdfTable, binaryOut);
+    RestorableHelper::storeStateForSampleCollectors(this->cdfTable, binaryOut);
 }
 
 void CDF::joinRestoredState(std::istream &binaryIn) {
-    RestorableHelper::joinRestoredStateForHistogram(this->cdfTable, binaryIn);
+    RestorableHelper::joinRestoredStateForSampleCollectors(this->cdfTable, binaryIn);
 }
 
 void CDF::clear() {
@@ -7,20 +7,23 @@
 
 
 #include "analyzer/BulkAnalyzerTask.h"
+#include "utils/SampleCollector.h"
 
 /**
  * @brief BulkAnalyzerTask, which draws cumulative distribution function for normalized eigenenergies (from [0, 1])
  */
 class CDF : public BulkAnalyzerTask {
 private:
-    std::vector<std::vector<double>> cdfTable;
+    std::vector<SampleCollector> cdfTable;
 
 public:
     /**
      * @brief Constructs the class.
      * @param bins Number of bins that will be filled.
+     * @param streamStatistics if true, only the statistics of the samples are kept instead of all of them (see
+     * SampleCollector)
      */
-    explicit CDF(std::size_t bins);
+    explicit CDF(std::size_t bins, bool streamStatistics = false);
 
     /**
      * @brief Takes normalized eigenenergies from the Eigensystem and inserts it into the histogram.
@@ -31,6 +34,8 @@ public:
      * @param logger unused
      */
     void analyze(const Eigensystem &binValue, Logger &logger) override;
+    [[nodiscard]] std::optional<std::vector<std::size_t>>
+    getRequiredEigenvectors(const Eigensystem &eigensystem) const override;
     [[nodiscard]] std::string getName() const override;
     void storeResult(std::ostream &out) const override;
 
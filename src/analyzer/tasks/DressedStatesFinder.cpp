@@ -37,6 +37,12 @@ void DressedStatesFinder::analyze(const Eigensystem &eigensystem, Logger &logger
     this->simulationIdx++;
 }
 
+std::optional<std::vector<std::size_t>>
+DressedStatesFinder::getRequiredEigenvectors(const Eigensystem &eigensystem) const
+{
+    return this->extractor.getRequiredBandIndices(eigensystem);
+}
+
 std::string DressedStatesFinder::getName() const {
     return "dressed";
 }
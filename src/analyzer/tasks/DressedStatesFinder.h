@@ -47,6 +47,8 @@ public:
     DressedStatesFinder(double coefficientThreshold, BandExtractor::Range range);
 
     void analyze(const Eigensystem &eigensystem, Logger &logger) override;
+    [[nodiscard]] std::optional<std::vector<std::size_t>>
+    getRequiredEigenvectors(const Eigensystem &eigensystem) const override;
     [[nodiscard]] std::string getName() const override;
 
     /**
@@ -15,14 +15,15 @@
 EigenstateObservables::EigenstateObservables(std::size_t numOfBins,
                                              std::vector<std::shared_ptr<PrimaryObservable>> primaryObservables,
                                              std::vector<std::shared_ptr<SecondaryObservable>> secondaryObservables,
-                                             std::vector<std::shared_ptr<Observable>> storedObservables)
+                                             std::vector<std::shared_ptr<Observable>> storedObservables,
+                                             bool streamStatistics)
         : binEntries(numOfBins), primaryObservables(std::move(primaryObservables)),
           secondaryObservables(std::move(secondaryObservables)), storedObservables(std::move(storedObservables))
 {
     Expects(numOfBins > 0);
     this->numValues = this->countStoredObservableValues();
     for (auto &binEntry : this->binEntries)
-        binEntry.observableValues.resize(this->numValues);
+        binEntry.observableValues.resize(this->numValues, SampleCollector(streamStatistics));
     this->header = "binStart " + this->generateStoredObservablesHeader();
 }
 
@@ -64,7 +65,7 @@ void EigenstateObservables::analyze(const Eigensystem &eigensystem, [[maybe_unus
         for (std::size_t i{}; i < observableValues.size(); i++) {
             auto &binObservableValues = this->binEntries[binIdx].observableValues;
             Assert(binObservableValues.size() == observableValues.size());
-            binObservableValues[i].push_back(observableValues[i]);
+            binObservableValues[i].add(observableValues[i]);
         }
     }
 
@@ -125,7 +126,7 @@ void EigenstateObservables::storeResult(std::ostream &out) const {
         out << binBeg << " ";
         for (const auto &concreteObservableValues : this->binEntries[binIdx].observableValues) {
             Quantity binValue;
-            binValue.calculateFromSamples(concreteObservableValues);
+            binValue.calculateFromCollector(concreteObservableValues);
             binValue.separator = Quantity::Separator::SPACE;
             out << binValue << " ";
         }
@@ -169,11 +170,11 @@ std::string EigenstateObservables::generateStoredObservablesHeader() const {
 }
 
 void EigenstateObservables::BinEntry::storeState(std::ostream &binaryOut) const {
-    RestorableHelper::storeStateForHistogram(this->observableValues, binaryOut);
+    RestorableHelper::storeStateForSampleCollectors(this->observableValues, binaryOut);
 }
 
 void EigenstateObservables::BinEntry::joinRestoredState(std::istream &binaryIn) {
-    RestorableHelper::joinRestoredStateForHistogram(this->observableValues, binaryIn);
+    RestorableHelper::joinRestoredStateForSampleCollectors(this->observableValues, binaryIn);
 }
 
 void EigenstateObservables::BinEntry::clear() {
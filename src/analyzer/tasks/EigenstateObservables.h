@@ -13,6 +13,7 @@
 #include "core/PrimaryObservable.h"
 #include "core/SecondaryObservable.h"
 #include "utils/FileUtils.h"
+#include "utils/SampleCollector.h"
 
 /**
  * @brief A BulkAnalyzerTask calculating values of given observables for epsilons in a specified number of bins.
@@ -23,7 +24,7 @@
 class EigenstateObservables : public BulkAnalyzerTask {
 private:
     struct BinEntry : public Restorable {
-        std::vector<std::vector<double>> observableValues;
+        std::vector<SampleCollector> observableValues;
 
         void storeState(std::ostream &binaryOut) const override;
         void joinRestoredState(std::istream &binaryIn) override;
@@ -55,7 +56,7 @@ private:
 public:
     EigenstateObservables(std::size_t numOfBins, std::vector<std::shared_ptr<PrimaryObservable>> primaryObservables,
                           std::vector<std::shared_ptr<SecondaryObservable>> secondaryObservables,
-                          std::vector<std::shared_ptr<Observable>> storedObservables);
+                          std::vector<std::shared_ptr<Observable>> storedObservables, bool streamStatistics = false);
 
     void startStoringObservables(std::string fileSignature_, std::unique_ptr<FileOstreamProvider> ostreamProvider_
                                  = std::make_unique<FileOstreamProvider>())
@@ -28,6 +28,12 @@ void InverseParticipationRatio::analyze(const Eigensystem &eigensystem, Logger &
     }
 }
 
+std::optional<std::vector<std::size_t>>
+InverseParticipationRatio::getRequiredEigenvectors(const Eigensystem &eigensystem) const
+{
+    return this->extractor.getRequiredBandIndices(eigensystem);
+}
+
 std::string InverseParticipationRatio::getName() const {
     return "ipr";
 }
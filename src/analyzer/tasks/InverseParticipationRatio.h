@@ -50,6 +50,8 @@ public:
      * @param logger unused
      */
     void analyze(const Eigensystem &eigensystem, Logger &logger) override;
+    [[nodiscard]] std::optional<std::vector<std::size_t>>
+    getRequiredEigenvectors(const Eigensystem &eigensystem) const override;
     [[nodiscard]] std::string getName() const override;
     void storeResult(std::ostream &out) const override;
 
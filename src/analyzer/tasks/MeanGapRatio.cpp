@@ -27,12 +27,18 @@ void MeanGapRatio::analyze(const Eigensystem &eigensystem, Logger &logger) {
         numEntries++;
     }
     if (numEntries > 0)
-        this->gapRatios.push_back(singleGapRatio / numEntries);
+        this->gapRatios.add(singleGapRatio / numEntries);
+}
+
+std::optional<std::vector<std::size_t>>
+MeanGapRatio::getRequiredEigenvectors([[maybe_unused]] const Eigensystem &eigensystem) const
+{
+    return std::vector<std::size_t>{};
 }
 
 Quantity MeanGapRatio::calculateMean() const {
     Quantity result;
-    result.calculateFromSamples(this->gapRatios);
+    result.calculateFromCollector(this->gapRatios);
     return result;
 }
 
@@ -55,11 +61,11 @@ std::vector<std::string> MeanGapRatio::getResultFields() const {
 }
 
 void MeanGapRatio::storeState(std::ostream &binaryOut) const {
-    RestorableHelper::storeStateForVector(this->gapRatios, binaryOut);
+    RestorableHelper::storeStateForSampleCollector(this->gapRatios, binaryOut);
 }
 
 void MeanGapRatio::joinRestoredState(std::istream &binaryIn) {
-    RestorableHelper::joinRestoredStateForVector(this->gapRatios, binaryIn);
+    RestorableHelper::joinRestoredStateForSampleCollector(this->gapRatios, binaryIn);
 }
 
 void MeanGapRatio::clear() {
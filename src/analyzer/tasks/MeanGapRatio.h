@@ -12,6 +12,7 @@
 
 #include "core/Eigensystem.h"
 #include "utils/Quantity.h"
+#include "utils/SampleCollector.h"
 #include "analyzer/InlineAnalyzerTask.h"
 #include "analyzer/BandExtractor.h"
 
@@ -36,12 +37,19 @@
 class MeanGapRatio : public InlineAnalyzerTask {
 private:
     BandExtractor extractor;
-    std::vector<double> gapRatios{};
+    SampleCollector gapRatios;
 
     [[nodiscard]] Quantity calculateMean() const;
 
 public:
-    explicit MeanGapRatio(BandExtractor::Range range) : extractor(std::move(range), "Mgr") { }
+    /**
+     * @param range the range to choose eigenstates from
+     * @param streamStatistics if true, only the statistics of the samples are kept instead of all of them (see
+     * SampleCollector)
+     */
+    explicit MeanGapRatio(BandExtractor::Range range, bool streamStatistics = false)
+            : extractor(std::move(range), "Mgr"), gapRatios(streamStatistics)
+    { }
 
     /**
      * @brief Adds value for a given @a eigensystem to the average mean gap ratio.
@@ -49,6 +57,8 @@ public:
      * @param logger unused
      */
     void analyze(const Eigensystem &eigensystem, Logger &logger) override;
+    [[nodiscard]] std::optional<std::vector<std::size_t>>
+    getRequiredEigenvectors(const Eigensystem &eigensystem) const override;
     [[nodiscard]] std::string getName() const override;
     [[nodiscard]] std::vector<std::string> getResultHeader() const override;
     [[nodiscard]] std::vector<std::string> getResultFields() const override;
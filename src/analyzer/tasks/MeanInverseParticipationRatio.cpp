@@ -26,12 +26,18 @@ void MeanInverseParticipationRatio::analyze(const Eigensystem &eigensystem, Logg
         numEntries++;
     }
     if (numEntries > 0)
-        this->ratios.push_back(singleRatio / numEntries);
+        this->ratios.add(singleRatio / numEntries);
+}
+
+std::optional<std::vector<std::size_t>>
+MeanInverseParticipationRatio::getRequiredEigenvectors(const Eigensystem &eigensystem) const
+{
+    return this->extractor.getRequiredBandIndices(eigensystem);
 }
 
 Quantity MeanInverseParticipationRatio::calculateMean() const {
     Quantity result;
-    result.calculateFromSamples(this->ratios);
+    result.calculateFromCollector(this->ratios);
     return result;
 }
 
@@ -54,11 +60,11 @@ std::vector<std::string> MeanInverseParticipationRatio::getResultFields() const
 }
 
 void MeanInverseParticipationRatio::storeState(std::ostream &binaryOut) const {
-    RestorableHelper::storeStateForVector(this->ratios, binaryOut);
+    RestorableHelper::storeStateForSampleCollector(this->ratios, binaryOut);
 }
 
 void MeanInverseParticipationRatio::joinRestoredState(std::istream &binaryIn) {
-    RestorableHelper::joinRestoredStateForVector(this->ratios, binaryIn);
+    RestorableHelper::joinRestoredStateForSampleCollector(this->ratios, binaryIn);
 }
 
 void MeanInverseParticipationRatio::clear() {
@@ -8,6 +8,7 @@
 #include "analyzer/InlineAnalyzerTask.h"
 #include "analyzer/BandExtractor.h"
 #include "utils/Quantity.h"
+#include "utils/SampleCollector.h"
 
 /**
  * @brief InlineAnalyzerTask which computer inverse participation ratio of eigenenergies normalized to [0, 1] from a
@@ -22,7 +23,7 @@
 class MeanInverseParticipationRatio : public InlineAnalyzerTask {
 private:
     BandExtractor extractor;
-    std::vector<double> ratios{};
+    SampleCollector ratios;
 
     [[nodiscard]] Quantity calculateMean() const;
 
@@ -31,8 +32,12 @@ public:
      * @brief Constructs the class, which will compute inverse participation ratio only for normalized eigenenergies
      * from a specific energy band.
      * @param range the range to choose eigenstates from
+     * @param streamStatistics if true, only the statistics of the samples are kept instead of all of them (see
+     * SampleCollector)
      */
-    explicit MeanInverseParticipationRatio(BandExtractor::Range range) : extractor(std::move(range), "Mean ipr") { }
+    explicit MeanInverseParticipationRatio(BandExtractor::Range range, bool streamStatistics = false)
+            : extractor(std::move(range), "Mean ipr"), ratios(streamStatistics)
+    { }
 
     /**
      * @brief Adds a value for a given @a eigensystem to the average inverse participation ratio.
@@ -40,6 +45,8 @@ public:
      * @param logger unused
      */
     void analyze(const Eigensystem &eigensystem, Logger &logger) override;
+    [[nodiscard]] std::optional<std::vector<std::size_t>>
+    getRequiredEigenvectors(const Eigensystem &eigensystem) const override;
     [[nodiscard]] std::string getName() const override;
     [[nodiscard]] std::vector<std::string> getResultHeader() const override;
     [[nodiscard]] std::vector<std::string> getResultFields() const override;
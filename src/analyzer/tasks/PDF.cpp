@@ -26,7 +26,13 @@ void PDF::analyze(const Eigensystem &eigensystem, [[maybe_unused]] Logger &logge
     }
 
     for (std::size_t i{}; i < this->pdfTable.size(); i++)
-        this->pdfTable[i].push_back(binsValue[i] / eigensystem.size());
+        this->pdfTable[i].add(binsValue[i] / eigensystem.size());
+}
+
+std::optional<std::vector<std::size_t>>
+PDF::getRequiredEigenvectors([[maybe_unused]] const Eigensystem &eigensystem) const
+{
+    return std::vector<std::size_t>{};
 }
 
 std::string PDF::getName() const {
@@ -38,22 +44,21 @@ void PDF::storeResult(std::ostream &out) const {
     for (std::size_t i = 0; i < steps; i++) {
         out << ((i + 0.5) / steps);
         out << " ";
-        auto &entry = this->pdfTable[i];
-        out << std::accumulate(entry.begin(), entry.end(), 0.) / entry.size();
+        out << this->pdfTable[i].getMean();
         out << std::endl;
     }
 }
 
-PDF::PDF(std::size_t bins) : pdfTable(bins) {
+PDF::PDF(std::size_t bins, bool streamStatistics) : pdfTable(bins, SampleCollector(streamStatistics)) {
     Expects(bins >= 2);
 }
 
 void PDF::storeState(std::ostream &binaryOut) const {
-    RestorableHelper::storeStateForHistogram(this->pdfTable, binaryOut);
+    RestorableHelper::storeStateForSampleCollectors(this->pdfTable, binaryOut);
 }
 
 void PDF::joinRestoredState(std::istream &binaryIn) {
-    RestorableHelper::joinRestoredStateForHistogram(this->pdfTable, binaryIn);
+    RestorableHelper::joinRestoredStateForSampleCollectors(this->pdfTable, binaryIn);
 }
 
 void PDF::clear() {
@@ -6,17 +6,20 @@
 #define MBL_ED_PDF_H
 
 #include "analyzer/BulkAnalyzerTask.h"
+#include "utils/SampleCollector.h"
 
 class PDF : public BulkAnalyzerTask {
 private:
-    std::vector<std::vector<double>> pdfTable;
+    std::vector<SampleCollector> pdfTable;
 
 public:
     /**
      * @brief Constructs the class.
      * @param bins Number of bins that will be filled.
+     * @param streamStatistics if true, only the statistics of the samples are kept instead of all of them (see
+     * SampleCollector)
      */
-    explicit PDF(std::size_t bins);
+    explicit PDF(std::size_t bins, bool streamStatistics = false);
 
     /**
      * @brief Takes normalized eigenenergies from the Eigensystem and inserts it into the PDF histogram.
@@ -25,6 +28,8 @@ public:
      * averages all this separate graphs (note, that the final graph is also normalized).
      */
     void analyze(const Eigensystem &binValue, Logger &logger) override;
+    [[nodiscard]] std::optional<std::vector<std::size_t>>
+    getRequiredEigenvectors(const Eigensystem &eigensystem) const override;
     [[nodiscard]] std::string getName() const override;
     void storeResult(std::ostream &out) const override;
 
@@ -7,8 +7,8 @@
 #include "ParticipationEntropy.h"
 #include "simulation/RestorableHelper.h"
 
-ParticipationEntropy::ParticipationEntropy(double q, BandExtractor::Range range)
-        : extractor(std::move(range), "Participation entropy"), q{q}
+ParticipationEntropy::ParticipationEntropy(double q, BandExtractor::Range range, bool streamStatistics)
+        : extractor(std::move(range), "Participation entropy"), q{q}, entropies(streamStatistics)
 {
     Expects(q > 0);
 }
@@ -40,7 +40,13 @@ void ParticipationEntropy::analyze(const Eigensystem &eigensystem, [[maybe_unuse
         numEntries++;
     }
     if (numEntries > 0)
-        this->entropies.push_back(singleEntropy / numEntries);
+        this->entropies.add(singleEntropy / numEntries);
+}
+
+std::optional<std::vector<std::size_t>>
+ParticipationEntropy::getRequiredEigenvectors(const Eigensystem &eigensystem) const
+{
+    return this->extractor.getRequiredBandIndices(eigensystem);
 }
 
 std::string ParticipationEntropy::getName() const {
@@ -62,11 +68,11 @@ std::vector<std::string> ParticipationEntropy::getResultFields() const {
 }
 
 void ParticipationEntropy::storeState(std::ostream &binaryOut) const {
-    RestorableHelper::storeStateForVector(this->entropies, binaryOut);
+    RestorableHelper::storeStateForSampleCollector(this->entropies, binaryOut);
 }
 
 void ParticipationEntropy::joinRestoredState(std::istream &binaryIn) {
-    RestorableHelper::joinRestoredStateForVector(this->entropies, binaryIn);
+    RestorableHelper::joinRestoredStateForSampleCollector(this->entropies, binaryIn);
 }
 
 void ParticipationEntropy::clear() {
@@ -75,6 +81,6 @@ void ParticipationEntropy::clear() {
 
 Quantity ParticipationEntropy::calculateMean() const {
     Quantity result;
-    result.calculateFromSamples(this->entropies);
+    result.calculateFromCollector(this->entropies);
     return result;
 }
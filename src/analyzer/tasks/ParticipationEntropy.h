@@ -8,6 +8,7 @@
 #include "analyzer/InlineAnalyzerTask.h"
 #include "analyzer/BandExtractor.h"
 #include "utils/Quantity.h"
+#include "utils/SampleCollector.h"
 
 /**
  * @brief InlineAnalyzerTask calculating participation entropy.
@@ -21,7 +22,7 @@ class ParticipationEntropy : public InlineAnalyzerTask {
 private:
     BandExtractor extractor;
     double q{};
-    std::vector<double> entropies{};
+    SampleCollector entropies;
 
     [[nodiscard]] Quantity calculateMean() const;
 
@@ -31,8 +32,10 @@ public:
      * specific energy band.
      * @param range the range to choose eigenstates from
      * @param q participation entropy rank
+     * @param streamStatistics if true, only the statistics of the samples are kept instead of all of them (see
+     * SampleCollector)
      */
-    ParticipationEntropy(double q, BandExtractor::Range range);
+    ParticipationEntropy(double q, BandExtractor::Range range, bool streamStatistics = false);
 
     /**
      * @brief Adds another S_q point to the average from a given @a eigensystem.
@@ -40,6 +43,8 @@ public:
      * is the point for final averaging and calculating final error from many eigensystems.
      */
     void analyze(const Eigensystem &eigensystem, Logger &logger) override;
+    [[nodiscard]] std::optional<std::vector<std::size_t>>
+    getRequiredEigenvectors(const Eigensystem &eigensystem) const override;
     [[nodiscard]] std::string getName() const override;
     [[nodiscard]] std::vector<std::string> getResultHeader() const override;
     [[nodiscard]] std::vector<std::string> getResultFields() const override;
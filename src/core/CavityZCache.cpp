@@ -0,0 +1,38 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#include <algorithm>
+
+#include "CavityZCache.h"
+#include "HamiltonianGenerator.h"
+#include "utils/Assertions.h"
+
+CavityZCache::CavityZCache(const HamiltonianGenerator &generator)
+        : fockBasis{generator.getFockBasis()}, occupations{generator.getSiteOccupations()}
+{ }
+
+std::shared_ptr<const arma::vec> CavityZCache::getValues(const CavityConstants::Realisation &realisation) {
+    std::size_t numberOfSites = this->occupations.getNumberOfSites();
+    Expects(numberOfSites <= realisation.siteEntries.size());
+
+    std::vector<double> wanniers(numberOfSites);
+    for (std::size_t i{}; i < numberOfSites; i++)
+        wanniers[i] = realisation.siteEntries[i].wannier;
+
+    std::lock_guard<std::mutex> lock(this->valuesMutex);
+    auto isExpired = [](const auto &entry) { return entry.second.expired(); };
+    this->values.erase(std::remove_if(this->values.begin(), this->values.end(), isExpired), this->values.end());
+
+    auto sameWanniers = [&wanniers](const auto &entry) { return entry.first == wanniers; };
+    auto cached = std::find_if(this->values.begin(), this->values.end(), sameWanniers);
+    if (cached != this->values.end()) {
+        auto cachedValues = cached->second.lock();
+        if (cachedValues != nullptr)
+            return cachedValues;
+    }
+
+    auto zValues = std::make_shared<const arma::vec>(this->occupations.calculateWeightedSum(wanniers));
+    this->values.emplace_back(std::move(wanniers), zValues);
+    return zValues;
+}
@@ -0,0 +1,54 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#ifndef MBL_ED_CAVITYZCACHE_H
+#define MBL_ED_CAVITYZCACHE_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <utility>
+
+#include <armadillo>
+
+#include "CavityConstants.h"
+#include "FockBasis.h"
+#include "SiteOccupations.h"
+
+class HamiltonianGenerator;
+
+/**
+ * @brief Eigenvalues of \f$ \hat{Z} = \sum_i c_i \hat{n}_i \f$ (see LookupCavityYZ) for all vectors of FockBasis,
+ * shared by LookupCavityZ2 and LookupCavityYZ of a given HamiltonianGenerator (see HamiltonianGeneratorBuilder).
+ * @details The values are computed for the whole basis at once from the SiteOccupations of the generator (which is
+ * not copied, so the generator has to outlive the cache), so that the terms can read them in O(1) by the index of the
+ * vector, instead of recomputing the O(K) sum for every matrix element. The values are keyed by the Wannier integrals
+ * of the realisation: when many terms change to the same realisation, they are computed only once and all terms
+ * hold the same vector. The vectors are released when no term uses them anymore.
+ */
+class CavityZCache {
+private:
+    std::shared_ptr<const FockBasis> fockBasis;
+    const SiteOccupations &occupations;
+
+    std::mutex valuesMutex;
+    std::vector<std::pair<std::vector<double>, std::weak_ptr<const arma::vec>>> values;
+
+public:
+    explicit CavityZCache(const HamiltonianGenerator &generator);
+
+    /**
+     * @brief Returns the values for @a realisation, which must have enough sites defined, indexed as the vectors of
+     * the basis. They are computed only if no other holder of the values for the same realisation exists.
+     */
+    [[nodiscard]] std::shared_ptr<const arma::vec> getValues(const CavityConstants::Realisation &realisation);
+
+    /**
+     * @brief Returns @a true if the values are computed for @a basis (it compares the addresses).
+     */
+    [[nodiscard]] bool isFor(const FockBasis &basis) const { return this->fockBasis.get() == &basis; }
+};
+
+
+#endif //MBL_ED_CAVITYZCACHE_H
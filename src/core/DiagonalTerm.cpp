@@ -0,0 +1,18 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#include "DiagonalTerm.h"
+#include "HamiltonianGenerator.h"
+#include "utils/Assertions.h"
+
+void DiagonalTerm::addToDiagonal(const SiteOccupations &occupations, const HamiltonianGenerator &generator,
+                                 arma::vec &diagonal) const
+{
+    const auto &basis = *generator.getFockBasis();
+    Expects(occupations.size() == basis.size());
+    Expects(diagonal.size() == basis.size());
+
+    for (std::size_t vectorIdx{}; vectorIdx < basis.size(); vectorIdx++)
+        diagonal[vectorIdx] += this->calculate(basis[vectorIdx], generator);
+}
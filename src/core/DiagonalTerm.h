@@ -5,7 +5,10 @@
 #ifndef MBL_ED_DIAGONALTERM_H
 #define MBL_ED_DIAGONALTERM_H
 
+#include <armadillo>
+
 #include "FockBasis.h"
+#include "SiteOccupations.h"
 
 class HamiltonianGenerator;
 
@@ -18,9 +21,20 @@ public:
 
     /**
      * @brief Given fock basis vector it is supposed to calculate its diagonal entry.
-     * @details @a generator is passed in case it is needed.
+     * @details @a generator is passed in case it is needed. The method may be called concurrently from many threads
+     * (see HamiltonianGenerator::generate()), so it should not modify the state of the term.
+     */
+    virtual double calculate(FockBasis::VectorView vector, const HamiltonianGenerator &generator) const = 0;
+
+    /**
+     * @brief Adds the diagonal entries of this term for all basis vectors to @a diagonal at once.
+     * @details @a occupations are the occupations of all vectors from the basis of @a generator. The default
+     * implementation calls calculate() for each vector, one by one. Terms can override it to evaluate the whole basis
+     * in a few vectorized loops using SiteOccupations, with all per-site coefficients computed only once. The result
+     * has to be the same as from calculate(), up to rounding errors.
      */
-    virtual double calculate(const FockBasis::Vector &vector, const HamiltonianGenerator &generator) = 0;
+    virtual void addToDiagonal(const SiteOccupations &occupations, const HamiltonianGenerator &generator,
+                               arma::vec &diagonal) const;
 };
 
 #endif //MBL_ED_DIAGONALTERM_H
@@ -5,6 +5,8 @@
 #ifndef MBL_ED_DOUBLEHOPPINGTERM_H
 #define MBL_ED_DOUBLEHOPPINGTERM_H
 
+#include <stdexcept>
+
 class HamiltonianGenerator;
 struct HopData;
 
@@ -21,10 +23,41 @@ public:
      *        \hat{b}^\dagger_\text{firstHopData.toSite} \hat{b}_\text{firstHopData.fromSite}\f$ when acting on vector
      * \f$|\text{firstHopData.fromVector}\rangle \f$ and moving it to \f$ |\text{secondHopData.toVector}\rangle \f$.
      * @details This constant may depend on all sites' occupance during each step of hopping. Note, that factors which
-     * appear just from ladder operators should not be included, only this additional \f$ Y \f$ factor.
+     * appear just from ladder operators should not be included, only this additional \f$ Y \f$ factor. The method may
+     * be called concurrently from many threads (see HamiltonianGenerator::generate()), so it should not modify the
+     * state of the term.
      */
     virtual double calculate(const HopData &firstHopData, const HopData &secondHopData,
-                             const HamiltonianGenerator &generator) = 0;
+                             const HamiltonianGenerator &generator) const = 0;
+
+    /**
+     * @brief Returns @a true if the term is of the form \f$ c \hat{Y}^2 \f$, where \f$ \hat{Y} \f$ is a one-body
+     * operator of nearest-neighbour hops.
+     * @details Then calculate() has to be equal to getSquareFactor() * calculateSingleHop(firstHopData) *
+     * calculateSingleHop(secondHopData) and HamiltonianGenerator builds the term as a product of sparse matrices
+     * \f$ \hat{Y} \f$ instead of enumerating all pairs of hops.
+     */
+    [[nodiscard]] virtual bool isSquareOfHoppingOperator() const { return false; }
+
+    /**
+     * @brief Returns the constant \f$ c \f$ from \f$ c \hat{Y}^2 \f$ - see isSquareOfHoppingOperator().
+     */
+    [[nodiscard]] virtual double getSquareFactor(const HamiltonianGenerator &generator) const {
+        static_cast<void>(generator);
+        throw std::logic_error("DoubleHoppingTerm: the term is not a square of hopping operator");
+    }
+
+    /**
+     * @brief Returns the constant of \f$ \hat{Y} \f$ for a single hop @a hopData, without the factors from ladder
+     * operators - see isSquareOfHoppingOperator().
+     */
+    [[nodiscard]] virtual double calculateSingleHop(const HopData &hopData,
+                                                    const HamiltonianGenerator &generator) const
+    {
+        static_cast<void>(hopData);
+        static_cast<void>(generator);
+        throw std::logic_error("DoubleHoppingTerm: the term is not a square of hopping operator");
+    }
 };
 
 #endif //MBL_ED_DOUBLEHOPPINGTERM_H
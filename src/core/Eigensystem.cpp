@@ -2,6 +2,8 @@
 // Created by Piotr Kubala on 22/01/2020.
 //
 
+#include <algorithm>
+#include <string>
 #include <utility>
 #include <iterator>
 
@@ -27,6 +29,43 @@ Eigensystem::Eigensystem(arma::vec eigenvalues, arma::mat eigenstates, std::shar
     this->sortEigenenergiesAndNormalizeEigenstates();
 }
 
+Eigensystem::Eigensystem(arma::vec eigenvalues, arma::mat eigenstates, std::size_t firstEigenvectorIdx,
+                         std::shared_ptr<const FockBasis> fockBasis)
+        : eigenenergies{std::move(eigenvalues)}, eigenstates{std::move(eigenstates)},
+          firstEigenvectorIdx{firstEigenvectorIdx}, fockBasis{std::move(fockBasis)}
+{
+    std::size_t size = this->eigenenergies.size();
+    if (this->fockBasis != nullptr)
+        Expects(this->fockBasis->size() == size);
+    Expects(this->eigenstates.n_rows == size);
+    Expects(this->firstEigenvectorIdx + this->eigenstates.n_cols <= size);
+    Expects(std::is_sorted(this->eigenenergies.begin(), this->eigenenergies.end()));
+    for (std::size_t i{}; i < this->eigenstates.n_cols; i++)
+        Expects(arma::any(this->eigenstates.col(i)));
+
+    this->hasEigenvectors_ = (this->eigenstates.n_cols > 0);
+    for (std::size_t i{}; i < this->eigenstates.n_cols; i++)
+        this->eigenstates.col(i) = arma::normalise(this->eigenstates.col(i));
+}
+
+Eigensystem::Eigensystem(arma::vec eigenvalues, arma::mat eigenstates, std::pair<double, double> spectrumBounds,
+                         std::shared_ptr<const FockBasis> fockBasis)
+        : eigenenergies{std::move(eigenvalues)}, eigenstates{std::move(eigenstates)}, spectrumBounds{spectrumBounds},
+          fockBasis{std::move(fockBasis)}
+{
+    std::size_t size = this->eigenenergies.size();
+    if (this->fockBasis != nullptr)
+        Expects(this->fockBasis->size() == this->eigenstates.n_rows);
+    Expects(this->eigenstates.n_cols == size);
+    Expects(this->eigenstates.n_rows >= size);
+    Expects(spectrumBounds.first < spectrumBounds.second);
+    for (std::size_t i{}; i < size; i++)
+        Expects(arma::any(this->eigenstates.col(i)));
+
+    this->hasEigenvectors_ = (size > 0);
+    this->sortEigenenergiesAndNormalizeEigenstates();
+}
+
 Eigensystem::Eigensystem(arma::vec eigenvalues, std::shared_ptr<const FockBasis> fockBasis)
         : eigenenergies{std::move(eigenvalues)}, hasEigenvectors_{false}, fockBasis{std::move(fockBasis)}
 {
@@ -47,6 +86,35 @@ bool Eigensystem::hasEigenvectors() const {
     return this->hasEigenvectors_;
 }
 
+bool Eigensystem::hasAllEigenvectors() const {
+    return this->hasEigenvectors_ && this->eigenstates.n_cols == this->size();
+}
+
+bool Eigensystem::hasEigenvector(std::size_t i) const {
+    return this->hasEigenvectors_ && i >= this->firstEigenvectorIdx
+           && i < this->firstEigenvectorIdx + this->eigenstates.n_cols;
+}
+
+std::size_t Eigensystem::getFirstEigenvectorIndex() const {
+    return this->firstEigenvectorIdx;
+}
+
+std::size_t Eigensystem::getNumberOfEigenvectors() const {
+    return this->hasEigenvectors_ ? this->eigenstates.n_cols : 0;
+}
+
+bool Eigensystem::hasFullSpectrum() const {
+    return !this->spectrumBounds.has_value();
+}
+
+std::pair<double, double> Eigensystem::getSpectrumBounds() const {
+    if (this->spectrumBounds.has_value())
+        return *this->spectrumBounds;
+
+    Expects(!this->empty());
+    return {this->eigenenergies.front(), this->eigenenergies.back()};
+}
+
 const arma::vec &Eigensystem::getEigenenergies() const {
     return this->eigenenergies;
 }
@@ -54,6 +122,8 @@ const arma::vec &Eigensystem::getEigenenergies() const {
 const arma::mat &Eigensystem::getEigenstates() const {
     if (!this->hasEigenvectors_)
         throw std::runtime_error("Eigensystem does not contain eigenvectors");
+    if (!this->hasAllEigenvectors())
+        throw std::runtime_error("Eigensystem contains only a part of eigenvectors");
     return this->eigenstates;
 }
 
@@ -61,12 +131,17 @@ arma::vec Eigensystem::getEigenstate(std::size_t i) const {
     if (!this->hasEigenvectors_)
         throw std::runtime_error("Eigensystem does not contain eigenvectors");
     Expects(i < this->size());
-    return this->eigenstates.col(i);
+    if (!this->hasEigenvector(i))
+        throw std::runtime_error("Eigensystem does not contain eigenvector " + std::to_string(i));
+    return this->eigenstates.col(i - this->firstEigenvectorIdx);
 }
 
 arma::vec Eigensystem::getNormalizedEigenenergies() const {
     if (this->empty())
         return {};
+    else if (!this->hasFullSpectrum())
+        return (this->eigenenergies - this->spectrumBounds->first)
+               / (this->spectrumBounds->second - this->spectrumBounds->first);
     else if (this->size() == 1)
         return {1};
     else if (arma::all(this->eigenenergies == this->eigenenergies.front()))
@@ -78,11 +153,17 @@ arma::vec Eigensystem::getNormalizedEigenenergies() const {
 }
 
 void Eigensystem::store(std::ostream &eigenenergiesOut, arma::file_type fileType) const {
+    if (!this->hasFullSpectrum())
+        throw std::runtime_error("Eigensystem with only a window of the spectrum cannot be stored");
     if (!this->eigenenergies.save(eigenenergiesOut, fileType))
         throw std::runtime_error("Eigenenergies store procedure failed");
 }
 
 void Eigensystem::store(std::ostream &eigenenergiesOut, std::ostream &eigenstatesOut, arma::file_type fileType) const {
+    if (!this->hasFullSpectrum())
+        throw std::runtime_error("Eigensystem with only a window of the spectrum cannot be stored");
+    if (this->hasEigenvectors_ && !this->hasAllEigenvectors())
+        throw std::runtime_error("Eigensystem with only a part of eigenvectors cannot be stored");
     if (!this->eigenenergies.save(eigenenergiesOut, fileType))
         throw std::runtime_error("Eigenenergies store procedure failed");
     if (!this->eigenstates.save(eigenstatesOut, fileType))
@@ -109,7 +190,8 @@ void Eigensystem::restore(std::istream &eigenenergiesIn, std::istream &eigenstat
 }
 
 bool operator==(const Eigensystem &lhs, const Eigensystem &rhs) {
-    return arma::approx_equal(lhs.eigenenergies, rhs.eigenenergies, "absdiff", 1e-12) &&
+    return lhs.firstEigenvectorIdx == rhs.firstEigenvectorIdx && lhs.spectrumBounds == rhs.spectrumBounds &&
+           arma::approx_equal(lhs.eigenenergies, rhs.eigenenergies, "absdiff", 1e-12) &&
            arma::approx_equal(lhs.eigenstates, rhs.eigenstates, "absdiff", 1e-12);
 }
 
@@ -122,7 +204,7 @@ void Eigensystem::sortEigenenergiesAndNormalizeEigenstates() {
     auto zipped = Zip(this->eigenenergies, indices);
     std::sort(zipped.begin(), zipped.end());
 
-    arma::mat newEigenstates(this->size(), this->size());
+    arma::mat newEigenstates(this->eigenstates.n_rows, this->size());
     for (std::size_t i{}; i < this->size(); i++)
         newEigenstates.col(i) = arma::normalise(this->eigenstates.col(indices[i]));
     this->eigenstates = newEigenstates;
@@ -193,9 +275,9 @@ bool Eigensystem::isOrthonormal() const {
     // we have up to this->fockBasis->size() additions
     double epsilon = std::numeric_limits<double>::epsilon() * this->size();
 
-    for (std::size_t i{}; i < this->size(); i++) {
-        for (std::size_t j = i + 1; j < this->size(); j++) {
-            double product = arma::dot(this->getEigenstate(i), this->getEigenstate(j));
+    for (std::size_t i{}; i < this->eigenstates.n_cols; i++) {
+        for (std::size_t j = i + 1; j < this->eigenstates.n_cols; j++) {
+            double product = arma::dot(this->eigenstates.col(i), this->eigenstates.col(j));
             if (std::abs(product) > epsilon)
                 return false;
         }
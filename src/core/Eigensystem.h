@@ -7,6 +7,8 @@
 
 #include <vector>
 #include <memory>
+#include <optional>
+#include <utility>
 
 #include <armadillo>
 
@@ -15,13 +17,17 @@
 /**
  * @brief A system of eigenenergies in ascending order with corresponding eigenvectors normalized to a unity.
  *
- * The system optionaly may not contain eigenvectors.
+ * The system optionaly may not contain eigenvectors or contain eigenvectors only for a subsequent range of
+ * eigenenergies (see hasEigenvector()). It may also contain only a window of subsequent eigenenergies from the
+ * spectrum together with their eigenvectors (see hasFullSpectrum()).
  */
 class Eigensystem {
 private:
     arma::vec eigenenergies;
     arma::mat eigenstates;
     bool hasEigenvectors_{};
+    std::size_t firstEigenvectorIdx{};
+    std::optional<std::pair<double, double>> spectrumBounds;
     std::shared_ptr<const FockBasis> fockBasis;
 
     void sortEigenenergiesAndNormalizeEigenstates();
@@ -46,10 +52,70 @@ public:
      */
     explicit Eigensystem(arma::vec eigenvalues, std::shared_ptr<const FockBasis> fockBasis = nullptr);
 
+    /**
+     * @brief Constructs a system with only a part of eigenvectors: eigenvalues are entries in @a eigenvalues vector
+     * and columns of @a eigenstates are eigenvectors for subsequent eigenvalues starting from index
+     * @a firstEigenvectorIdx.
+     *
+     * Eigenvalues have to be already sorted in ascending order. Eigenvectors are normalized to unity.
+     */
+    Eigensystem(arma::vec eigenvalues, arma::mat eigenstates, std::size_t firstEigenvectorIdx,
+                std::shared_ptr<const FockBasis> fockBasis = nullptr);
+
+    /**
+     * @brief Constructs a system with only a window of the spectrum: eigenvalues are entries in @a eigenvalues vector
+     * and eigenvectors are corresponding columns in @a eigenstates matrix, while @a spectrumBounds are the lowest and
+     * the highest eigenvalue of the whole spectrum.
+     *
+     * Eigenvalues are sorted in ascending order and eigenvectors are normalized to unity. The number of rows of
+     * @a eigenstates is the dimension of the whole space and it has to match the size of @a fockBasis, if given.
+     */
+    Eigensystem(arma::vec eigenvalues, arma::mat eigenstates, std::pair<double, double> spectrumBounds,
+                std::shared_ptr<const FockBasis> fockBasis = nullptr);
+
     [[nodiscard]] std::size_t size() const;
     [[nodiscard]] bool empty() const;
+    /**
+     * @brief Returns true if the system contains any eigenvectors (not necessarily all of them).
+     */
     [[nodiscard]] bool hasEigenvectors() const;
+
+    /**
+     * @brief Returns true if the system contains eigenvectors for all eigenvalues.
+     */
+    [[nodiscard]] bool hasAllEigenvectors() const;
+
+    /**
+     * @brief Returns true if the system contains eigenvector for eigenenergy of index @a i.
+     */
+    [[nodiscard]] bool hasEigenvector(std::size_t i) const;
+
+    /**
+     * @brief Returns the index of the first eigenenergy, for which the eigenvector is present.
+     */
+    [[nodiscard]] std::size_t getFirstEigenvectorIndex() const;
+
+    /**
+     * @brief Returns the number of eigenvectors present.
+     */
+    [[nodiscard]] std::size_t getNumberOfEigenvectors() const;
+
+    /**
+     * @brief Returns false if the system contains only a window of the spectrum.
+     */
+    [[nodiscard]] bool hasFullSpectrum() const;
+
+    /**
+     * @brief Returns the lowest and the highest eigenenergy of the whole spectrum, also when the system contains only a
+     * window of it.
+     */
+    [[nodiscard]] std::pair<double, double> getSpectrumBounds() const;
+
     [[nodiscard]] const arma::vec &getEigenenergies() const;
+
+    /**
+     * @brief Returns all eigenvectors as columns of a matrix. Throws, if not all eigenvectors are present.
+     */
     [[nodiscard]] const arma::mat &getEigenstates() const;
     [[nodiscard]] bool hasFockBasis() const;
     [[nodiscard]] const FockBasis &getFockBasis() const;
@@ -57,11 +123,13 @@ public:
 
     /**
      * @brief Returns eigenstate as column vector for eigenenergy of index @a i (in ascending order)
+     * @details It throws if the eigenvector is not present, see hasEigenvector().
      */
     [[nodiscard]] arma::vec getEigenstate(std::size_t i) const;
 
     /**
      * @brief Returns eigenenrgies in the ascending order, but linearly normalized to be from [0, 1]
+     * @details For a window of the spectrum the whole spectrum is normalized to [0, 1], see getSpectrumBounds().
      */
     [[nodiscard]] arma::vec getNormalizedEigenenergies() const;
 
@@ -4,35 +4,126 @@
 
 #include <cmath>
 #include <numeric>
+#include <algorithm>
 
 #include "FockBasis.h"
 #include "utils/Assertions.h"
 
-void FockBasis::add(FockBasis::Vector vector) {
+namespace {
+    /**
+     * @brief The vector obtained from @a vector by moving one particle from @a fromSite to @a toSite, which computes
+     * the occupations on the fly instead of storing them.
+     */
+    class HoppedVector {
+    private:
+        FockVectorView vector;
+        std::size_t fromSite{};
+        std::size_t toSite{};
+
+    public:
+        HoppedVector(FockVectorView vector, std::size_t fromSite, std::size_t toSite)
+                : vector{vector}, fromSite{fromSite}, toSite{toSite}
+        { }
+
+        [[nodiscard]] std::size_t size() const { return this->vector.size(); }
+
+        [[nodiscard]] int operator[](std::size_t idx) const {
+            int occupation = this->vector[idx];
+            if (idx == this->fromSite)
+                occupation--;
+            if (idx == this->toSite)
+                occupation++;
+            return occupation;
+        }
+
+        [[nodiscard]] int back() const { return (*this)[this->size() - 1]; }
+    };
+}
+
+void FockBasis::add(const FockBasis::Vector &vector) {
     if (this->size() != 0)
-        Expects(this->theBasis.front().size() == vector.size());
+        Expects(this->numberOfSites == vector.size());
 
     std::size_t currIndex = this->size();
-    this->indexMap.emplace(this->computeHash(vector), currIndex);
-    this->theBasis.push_back(std::move(vector));
+    switch (this->indexingScheme) {
+        case IndexingScheme::HASH:
+            this->indexMap.emplace(this->computeHash(vector), currIndex);
+            break;
+        case IndexingScheme::RANKING:
+            if (currIndex == 0)
+                this->prepareBinomials(vector);
+            Expects(this->computeRank(vector) == currIndex);
+            break;
+    }
+
+    this->numberOfSites = vector.size();
+    this->occupations.insert(this->occupations.end(), vector.begin(), vector.end());
+    this->numberOfVectors++;
+}
+
+void FockBasis::reserve(std::size_t vectors, std::size_t sites) {
+    this->occupations.reserve(vectors * sites);
 }
 
 std::size_t FockBasis::size() const {
-    return this->theBasis.size();
+    return this->numberOfVectors;
+}
+
+FockBasis::VectorView FockBasis::operator[](std::size_t i) const {
+    return VectorView(this->occupations.data() + i * this->numberOfSites, this->numberOfSites);
 }
 
-FockBasis::Vector &FockBasis::operator[](std::size_t i) {
-    return this->theBasis[i];
+template<typename AnyVector>
+double FockBasis::computeHash(const AnyVector &vector) const {
+    // https://arxiv.org/pdf/1102.4006.pdf says, that sqrt(100*i + 3) is linearly independent over radicals, so
+    // each distinct vector will end up with a unique hash
+    double hash{};
+    for (std::size_t i = 0; i < vector.size(); i++)
+        hash += std::sqrt(100*i + 3) * vector[i];
+    return hash;
 }
 
-const FockBasis::Vector &FockBasis::operator[](std::size_t i) const {
-    return this->theBasis[i];
+/**
+ * @brief Returns the position of @a vector in the descending lexicographic order of all vectors with the same number of
+ * particles and sites or std::nullopt if it has a different number of particles.
+ * @details For each site i, all vectors having the same occupations on sites [0, i - 1] and a larger one on site i
+ * precede @a vector. If R particles remain for the sites [i + 1, K - 1], there are C(R - 1 + K - i - 1, K - i - 1)
+ * of such vectors (hockey-stick identity summing all possible distributions of 1, ..., R particles).
+ */
+template<typename AnyVector>
+std::optional<std::size_t> FockBasis::computeRank(const AnyVector &vector) const {
+    std::size_t vectorSize = vector.size();
+    std::size_t remainingParticles = this->rankedNumberOfParticles;
+    std::size_t rank{};
+    for (std::size_t i{}; i + 1 < vectorSize; i++) {
+        int occupation = vector[i];
+        if (occupation < 0 || static_cast<std::size_t>(occupation) > remainingParticles)
+            return std::nullopt;
+
+        remainingParticles -= occupation;
+        if (remainingParticles > 0) {
+            std::size_t sitesLeft = vectorSize - i - 1;
+            rank += this->binomial(remainingParticles - 1 + sitesLeft, sitesLeft);
+        }
+    }
+
+    if (vector.back() < 0 || static_cast<std::size_t>(vector.back()) != remainingParticles)
+        return std::nullopt;
+    return rank;
 }
 
-std::optional<std::size_t> FockBasis::findIndex(const FockBasis::Vector &vector) const {
-    if (vector.size() != this->getNumberOfSites())
+template<typename AnyVector>
+std::optional<std::size_t> FockBasis::findIndexImpl(const AnyVector &vector) const {
+    if (this->size() == 0 || vector.size() != this->getNumberOfSites())
         return std::nullopt;
 
+    if (this->indexingScheme == IndexingScheme::RANKING) {
+        auto rank = this->computeRank(vector);
+        if (!rank.has_value() || *rank >= this->size())
+            return std::nullopt;
+        return rank;
+    }
+
     auto it = this->indexMap.find(this->computeHash(vector));
     if (it == this->indexMap.end())
         return std::nullopt;
@@ -40,37 +131,56 @@ std::optional<std::size_t> FockBasis::findIndex(const FockBasis::Vector &vector)
         return it->second;
 }
 
-FockBasis::iterator FockBasis::begin() {
-    return this->theBasis.begin();
+std::optional<std::size_t> FockBasis::findIndex(FockBasis::VectorView vector) const {
+    return this->findIndexImpl(vector);
 }
 
-FockBasis::iterator FockBasis::end() {
-    return this->theBasis.end();
+std::optional<std::size_t> FockBasis::findIndexAfterHop(FockBasis::VectorView vector, std::size_t fromSite,
+                                                        std::size_t toSite) const
+{
+    Expects(fromSite < vector.size());
+    Expects(toSite < vector.size());
+    Expects(vector[fromSite] > 0);
+    return this->findIndexImpl(HoppedVector(vector, fromSite, toSite));
 }
 
 FockBasis::const_iterator FockBasis::begin() const {
-    return this->theBasis.begin();
+    return const_iterator(this, 0);
 }
 
 FockBasis::const_iterator FockBasis::end() const {
-    return this->theBasis.end();
+    return const_iterator(this, this->size());
 }
 
-double FockBasis::computeHash(const FockBasis::Vector &vector) const {
-    // https://arxiv.org/pdf/1102.4006.pdf says, that sqrt(100*i + 3) is linearly independent over radicals, so
-    // each distinct vector will end up with a unique hash
-    double hash{};
-    for (std::size_t i = 0; i < vector.size(); i++)
-        hash += std::sqrt(100*i + 3) * vector[i];
-    return hash;
+/**
+ * @brief Prepares the Pascal triangle of binomial coefficients C(n, k) for n < N + K and k < K, which is all that
+ * computeRank() needs for N particles on K sites.
+ */
+void FockBasis::prepareBinomials(FockBasis::VectorView firstVector) {
+    Expects(!firstVector.empty());
+
+    this->rankedNumberOfParticles = std::accumulate(firstVector.begin(), firstVector.end(), 0);
+    this->binomialsStride = firstVector.size();
+    std::size_t numRows = this->rankedNumberOfParticles + firstVector.size();
+    this->binomials.assign(numRows * this->binomialsStride, 0);
+    for (std::size_t n{}; n < numRows; n++) {
+        this->binomials[n * this->binomialsStride] = 1;
+        for (std::size_t k = 1; k <= std::min(n, this->binomialsStride - 1); k++)
+            this->binomials[n * this->binomialsStride + k] = this->binomial(n - 1, k - 1) + this->binomial(n - 1, k);
+    }
+}
+
+std::size_t FockBasis::binomial(std::size_t n, std::size_t k) const {
+    return this->binomials[n * this->binomialsStride + k];
 }
 
 std::size_t FockBasis::getNumberOfSites() const {
     Expects(this->size() > 0);
-    return this->theBasis.front().size();
+    return this->numberOfSites;
 }
 
 std::size_t FockBasis::getNumberOfParticles() const {
     Expects(this->size() > 0);
-    return std::accumulate(this->theBasis.front().begin(), this->theBasis.front().end(), 0);
+    auto firstVector = (*this)[0];
+    return std::accumulate(firstVector.begin(), firstVector.end(), 0);
 }
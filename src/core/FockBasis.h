@@ -9,51 +9,143 @@
 #include <vector>
 #include <map>
 #include <optional>
+#include <iterator>
+#include <cstddef>
 
 #include "FockVector.h"
 
 /**
  * @brief A class representing a basis of product states of bosons/fermion trapped inside an optical lattice.
- * @details It uses hashing technique for a fast access to the elements.
+ * @details Two indexing schemes can be used for a fast access to the elements (see FockBasis::IndexingScheme).
+ * <p> The vectors are stored compactly in a single flat array, one byte per site, and are accessed through
+ * FockVectorView -s, so the basis does not perform any allocation per vector.
  */
 class FockBasis {
 public:
     using Vector = FockVector;
-    using iterator = std::vector<Vector>::iterator;
-    using const_iterator = std::vector<Vector>::const_iterator;
+    using VectorView = FockVectorView;
+
+    /**
+     * @brief Random access iterator over views of the consecutive vectors of the basis.
+     */
+    class const_iterator {
+    private:
+        const FockBasis *basis{};
+        std::size_t idx{};
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = VectorView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = VectorView;
+
+        const_iterator() = default;
+        const_iterator(const FockBasis *basis, std::size_t idx) : basis{basis}, idx{idx} { }
+
+        [[nodiscard]] VectorView operator*() const { return (*this->basis)[this->idx]; }
+        [[nodiscard]] VectorView operator[](difference_type n) const { return (*this->basis)[this->idx + n]; }
+        const_iterator &operator++() { this->idx++; return *this; }
+        const_iterator operator++(int) { auto copy = *this; this->idx++; return copy; }
+        const_iterator &operator--() { this->idx--; return *this; }
+        const_iterator operator--(int) { auto copy = *this; this->idx--; return copy; }
+        const_iterator &operator+=(difference_type n) { this->idx += n; return *this; }
+        const_iterator &operator-=(difference_type n) { this->idx -= n; return *this; }
+        [[nodiscard]] const_iterator operator+(difference_type n) const { return {this->basis, this->idx + n}; }
+        [[nodiscard]] const_iterator operator-(difference_type n) const { return {this->basis, this->idx - n}; }
+        [[nodiscard]] difference_type operator-(const const_iterator &other) const {
+            return static_cast<difference_type>(this->idx) - static_cast<difference_type>(other.idx);
+        }
+
+        [[nodiscard]] bool operator==(const const_iterator &other) const { return this->idx == other.idx; }
+        [[nodiscard]] bool operator!=(const const_iterator &other) const { return this->idx != other.idx; }
+        [[nodiscard]] bool operator<(const const_iterator &other) const { return this->idx < other.idx; }
+    };
+
+    using iterator = const_iterator;
+
+    /**
+     * @brief The method used by findIndex() to locate vectors.
+     */
+    enum class IndexingScheme {
+        /**
+         * @brief Any vectors of equal sizes can be added in any order. The index is found by a floating-point hash
+         * and a lookup in the map.
+         */
+        HASH,
+
+        /**
+         * @brief The basis has to contain all vectors of a fixed number of particles, added in the descending
+         * lexicographic order (as FockBasisGenerator does). The index is then computed exactly in O(K) from the
+         * table of binomial coefficients, without any lookup.
+         */
+        RANKING
+    };
 
 private:
-    std::vector<Vector> theBasis;
+    IndexingScheme indexingScheme{IndexingScheme::HASH};
+
+    // All vectors one after another, numberOfSites occupations each
+    std::vector<VectorView::Occupation> occupations;
+    std::size_t numberOfSites{};
+    std::size_t numberOfVectors{};
+
     std::map<double, std::size_t> indexMap;
 
-    [[nodiscard]] double computeHash(const Vector &vector) const;
+    std::size_t rankedNumberOfParticles{};
+    std::size_t binomialsStride{};
+    std::vector<std::size_t> binomials;
+
+    template<typename AnyVector>
+    [[nodiscard]] double computeHash(const AnyVector &vector) const;
+    void prepareBinomials(VectorView firstVector);
+    [[nodiscard]] std::size_t binomial(std::size_t n, std::size_t k) const;
+    template<typename AnyVector>
+    [[nodiscard]] std::optional<std::size_t> computeRank(const AnyVector &vector) const;
+    template<typename AnyVector>
+    [[nodiscard]] std::optional<std::size_t> findIndexImpl(const AnyVector &vector) const;
 
 public:
-    void add(Vector vector);
+    FockBasis() = default;
+    explicit FockBasis(IndexingScheme indexingScheme) : indexingScheme{indexingScheme} { }
+
+    /**
+     * @brief Appends @a vector to the basis, copying its occupations to the common storage.
+     */
+    void add(const Vector &vector);
+
+    /**
+     * @brief Reserves the memory for @a vectors vectors of @a sites sites.
+     */
+    void reserve(std::size_t vectors, std::size_t sites);
+
     [[nodiscard]] std::size_t size() const;
 
     /**
-     * @brief Returns modifiable vector of index @a i. j-th elements of vector reperesents number of parcitles on site
+     * @brief Returns the view of vector of index @a i. j-th elements of vector reperesents number of parcitles on site
      * j.
      */
-    Vector &operator[](std::size_t i);
+    [[nodiscard]] VectorView operator[](std::size_t i) const;
 
     /**
-     * @brief Returns non-modifiable vector of index @a i. j-th elements of vector reperesents number of parcitles on
-     * site j.
+     * @brief Returns the index of a given Vector or std::nullopt if it is not present.
      */
-    const Vector &operator[](std::size_t i) const;
+    [[nodiscard]] std::optional<std::size_t> findIndex(VectorView vector) const;
 
     /**
-     * @brief Returns the index of a given Vector or std::nullopt if it is not present.
+     * @brief Returns the index of the vector obtained from @a vector by moving one particle from @a fromSite to
+     * @a toSite or std::nullopt if it is not present.
+     * @details The vector after the hop is not constructed, so nothing is allocated. @a vector[fromSite] has to be
+     * positive.
      */
-    [[nodiscard]] std::optional<std::size_t> findIndex(const Vector &vector) const;
-    iterator begin();
-    iterator end();
+    [[nodiscard]] std::optional<std::size_t> findIndexAfterHop(VectorView vector, std::size_t fromSite,
+                                                               std::size_t toSite) const;
+
     [[nodiscard]] const_iterator begin() const;
     [[nodiscard]] const_iterator end() const;
     [[nodiscard]] std::size_t getNumberOfSites() const;
     [[nodiscard]] std::size_t getNumberOfParticles() const;
+    [[nodiscard]] IndexingScheme getIndexingScheme() const { return this->indexingScheme; }
 };
 
 
@@ -7,9 +7,17 @@
 #include "FockBasisGenerator.h"
 #include "utils/Assertions.h"
 
-std::unique_ptr<FockBasis> FockBasisGenerator::generate(int numberOfParticles, int numberOfSites) const {
+std::unique_ptr<FockBasis> FockBasisGenerator::generate(int numberOfParticles, int numberOfSites,
+                                                       FockBasis::IndexingScheme indexingScheme) const
+{
     Expects(numberOfSites > 0);
-    auto basis = std::make_unique<FockBasis>();
+    auto basis = std::make_unique<FockBasis>(indexingScheme);
+
+    // There are C(N + K - 1, K - 1) vectors, so the whole storage can be allocated at once
+    std::size_t basisSize = 1;
+    for (int i = 1; i < numberOfSites; i++)
+        basisSize = basisSize * (numberOfParticles + i) / i;
+    basis->reserve(basisSize, numberOfSites);
 
     // An algorithm from https://arxiv.org/pdf/1102.4006.pdf
     FockBasis::Vector current(numberOfSites, 0);
@@ -15,7 +15,14 @@
  */
 class FockBasisGenerator {
 public:
-    [[nodiscard]] std::unique_ptr<FockBasis> generate(int numberOfParticles, int numberOfSites) const;
+    /**
+     * @brief Generates the basis in the descending lexicographic order.
+     * @details As the basis is complete, by default FockBasis::IndexingScheme::RANKING is used, but it can be changed
+     * by @a indexingScheme.
+     */
+    [[nodiscard]] std::unique_ptr<FockBasis>
+    generate(int numberOfParticles, int numberOfSites,
+             FockBasis::IndexingScheme indexingScheme = FockBasis::IndexingScheme::RANKING) const;
 };
 
 
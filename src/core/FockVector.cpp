@@ -5,28 +5,39 @@
 #include <sstream>
 #include <algorithm>
 #include <iterator>
+#include <limits>
 
 #include "FockVector.h"
 #include "utils/Assertions.h"
 
+namespace {
+    bool is_valid_occupation(int occupation) {
+        return occupation >= 0 && occupation <= std::numeric_limits<FockVector::Occupation>::max();
+    }
+}
+
+FockVector::FockVector(std::size_t size, int init) {
+    Expects(is_valid_occupation(init));
+    this->data.resize(size, init);
+}
+
+FockVector::FockVector(const std::initializer_list<int> &list) {
+    Expects(std::all_of(list.begin(), list.end(), is_valid_occupation));
+    this->data.assign(list.begin(), list.end());
+}
+
 FockVector::FockVector(const std::string &occupationRepresentation) {
     std::istringstream in(occupationRepresentation);
     std::string token;
     while (std::getline(in, token, '.')) {
         int occupation = std::stoi(token);
-        Expects(occupation >= 0);
+        Expects(is_valid_occupation(occupation));
         this->data.push_back(occupation);
     }
 }
 
 std::ostream &operator<<(std::ostream &out, const FockVector &fw) {
-    if (fw.empty())
-        return out;
-
-    std::copy(fw.data.begin(), fw.data.end() - 1, std::ostream_iterator<int>(out, "."));
-    out << fw.data.back();
-
-    return out;
+    return out << FockVectorView(fw);
 }
 
 FockVector::FockVector(std::size_t sites, const std::string &tag) {
@@ -60,3 +71,26 @@ FockVector operator+(const FockVector &fw1, const FockVector &fw2) {
     result.data.insert(result.data.end(), fw2.data.begin(), fw2.data.end());
     return result;
 }
+
+FockVector::FockVector(const FockVectorView &view) : data(view.begin(), view.end()) { }
+
+FockVector operator+(const FockVectorView &fw1, const FockVectorView &fw2) {
+    FockVector result(fw1.size() + fw2.size());
+    std::copy(fw1.begin(), fw1.end(), result.begin());
+    std::copy(fw2.begin(), fw2.end(), result.begin() + fw1.size());
+    return result;
+}
+
+bool operator==(const FockVectorView &fw1, const FockVectorView &fw2) {
+    return std::equal(fw1.begin(), fw1.end(), fw2.begin(), fw2.end());
+}
+
+std::ostream &operator<<(std::ostream &out, const FockVectorView &fw) {
+    if (fw.empty())
+        return out;
+
+    std::copy(fw.begin(), fw.end() - 1, std::ostream_iterator<int>(out, "."));
+    out << fw.back();
+
+    return out;
+}
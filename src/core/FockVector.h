@@ -8,34 +8,46 @@
 #include <vector>
 #include <string>
 #include <stdexcept>
+#include <cstdint>
+#include <iosfwd>
 
 struct FockVectorParseException : public std::runtime_error {
     explicit FockVectorParseException(const std::string &what) : std::runtime_error(what) { }
 };
 
+class FockVectorView;
+
+/**
+ * @brief Owning Fock vector - the occupation of each site, stored in a single byte, so the occupations have to be in
+ * [0, 255] range.
+ */
 class FockVector {
+public:
+    using Occupation = std::uint8_t;
+
 private:
-    std::vector<int> data;
+    std::vector<Occupation> data;
 
 public:
-    using iterator = std::vector<int>::iterator;
-    using const_iterator = std::vector<int>::const_iterator;
+    using iterator = std::vector<Occupation>::iterator;
+    using const_iterator = std::vector<Occupation>::const_iterator;
 
     FockVector() = default;
-    explicit FockVector(std::size_t size, int init = 0) : data(size, init) { }
-    FockVector(const std::initializer_list<int> &list) : data(list) { }
+    explicit FockVector(std::size_t size, int init = 0);
+    FockVector(const std::initializer_list<int> &list);
     explicit FockVector(const std::string &occupationRepresentation);
     FockVector(std::size_t sites, const std::string &tag);
+    explicit FockVector(const FockVectorView &view);
 
     [[nodiscard]] bool empty() const { return data.empty(); }
     [[nodiscard]] std::size_t size() const { return data.size(); }
-    [[nodiscard]] int &operator[](std::size_t idx) { return data[idx]; }
+    [[nodiscard]] Occupation &operator[](std::size_t idx) { return data[idx]; }
     [[nodiscard]] int operator[](std::size_t idx) const { return data[idx]; }
 
     [[nodiscard]] int front() const { return data.front(); }
     [[nodiscard]] int back() const { return data.back(); }
-    [[nodiscard]] int &front() { return data.front(); }
-    [[nodiscard]] int &back() { return data.back(); }
+    [[nodiscard]] Occupation &front() { return data.front(); }
+    [[nodiscard]] Occupation &back() { return data.back(); }
 
     [[nodiscard]] iterator begin() { return data.begin(); }
     [[nodiscard]] iterator end() { return data.end(); }
@@ -51,6 +63,51 @@ public:
     [[nodiscard]] friend bool operator!=(const FockVector &fw1, const FockVector &fw2) { return fw1.data == fw2.data; }
 
     friend std::ostream &operator<<(std::ostream &out, const FockVector &fw);
+
+    friend class FockVectorView;
+};
+
+/**
+ * @brief Non-owning, read-only view of the occupations of a Fock vector, for example of a vector stored in FockBasis.
+ * @details It is a pair of a pointer and a size, so it is cheap to copy and should be passed by value. It is valid as
+ * long as the storage it points to. FockVector is implicitly converted to it.
+ */
+class FockVectorView {
+public:
+    using Occupation = FockVector::Occupation;
+    using const_iterator = const Occupation *;
+
+private:
+    const Occupation *occupations{};
+    std::size_t numberOfSites{};
+
+public:
+    FockVectorView() = default;
+    FockVectorView(const Occupation *occupations, std::size_t numberOfSites)
+            : occupations{occupations}, numberOfSites{numberOfSites}
+    { }
+    FockVectorView(const FockVector &vector) : occupations{vector.data.data()}, numberOfSites{vector.size()} { }
+
+    [[nodiscard]] bool empty() const { return this->numberOfSites == 0; }
+    [[nodiscard]] std::size_t size() const { return this->numberOfSites; }
+    [[nodiscard]] int operator[](std::size_t idx) const { return this->occupations[idx]; }
+    [[nodiscard]] int front() const { return this->occupations[0]; }
+    [[nodiscard]] int back() const { return this->occupations[this->numberOfSites - 1]; }
+
+    [[nodiscard]] const_iterator begin() const { return this->occupations; }
+    [[nodiscard]] const_iterator end() const { return this->occupations + this->numberOfSites; }
+
+    /**
+     * @brief Concatenated @a fw1 and @a fw2 into one, larger, owning vector.
+     */
+    friend FockVector operator+(const FockVectorView &fw1, const FockVectorView &fw2);
+
+    friend bool operator==(const FockVectorView &fw1, const FockVectorView &fw2);
+    [[nodiscard]] friend bool operator!=(const FockVectorView &fw1, const FockVectorView &fw2) {
+        return !(fw1 == fw2);
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const FockVectorView &fw);
 };
 
 #endif //MBL_ED_FOCKVECTOR_H
@@ -2,16 +2,25 @@
 // Created by pkua on 01.11.2019.
 //
 
+#include <algorithm>
+#include <exception>
+
 #include "HamiltonianGenerator.h"
+#include "SparseHamiltonianOperator.h"
+#include "MatrixFreeHamiltonianOperator.h"
+#include "RangeEigensolver.h"
+#include "PolynomialFilteredEigensolver.h"
 #include "utils/Assertions.h"
+#include "utils/OMPMacros.h"
 
 /**
- * @brief Returns vector after acting with b_{toSiteIndex}^\dagger b_{fromSiteIndex} on @a vector with a correct
- * constant
+ * @brief Fills @a hopData for the action of b_{toSite}^\dagger b_{fromSite} on the basis vector of index @a fromIdx
+ * with a correct constant and returns the index of the resulting vector, or std::nullopt if the hop is not possible.
  */
-std::optional<HopData>
-HamiltonianGenerator::hoppingAction(const FockBasis::Vector &fromVector, std::size_t fromSite,
-                                    std::size_t toSite) const {
+std::optional<std::size_t>
+HamiltonianGenerator::hoppingAction(std::size_t fromIdx, std::size_t fromSite, std::size_t toSite,
+                                    HopData &hopData) const
+{
     Expects(toSite != fromSite);
     if (this->usePBC) {
         fromSite %= this->fockBasis->getNumberOfSites();
@@ -20,97 +29,546 @@ HamiltonianGenerator::hoppingAction(const FockBasis::Vector &fromVector, std::si
         return std::nullopt;
     }
 
+    auto fromVector = (*this->fockBasis)[fromIdx];
     double constant = (fromVector[toSite] + 1) * fromVector[fromSite];
     if (constant == 0)
         return std::nullopt;
 
-    HopData result;
-    result.fromSite = fromSite;
-    result.toSite = toSite;
-    result.fromVector = fromVector;
-    result.toVector = fromVector;
-    result.toVector[fromSite]--;
-    result.toVector[toSite]++;
-    result.ladderConstant = std::sqrt(constant);
+    auto toIdx = this->fockBasis->findIndexAfterHop(fromVector, fromSite, toSite);
+    Assert(toIdx.has_value());
+
+    hopData.fromSite = fromSite;
+    hopData.toSite = toSite;
+    hopData.fromVector = fromVector;
+    hopData.toVector = (*this->fockBasis)[*toIdx];
+    hopData.fromIdx = fromIdx;
+    hopData.toIdx = toIdx;
+    hopData.ladderConstant = std::sqrt(constant);
 
-    return result;
+    return toIdx;
+}
+
+namespace {
+    constexpr std::size_t HOP_BLOCK_SIZE = 1024;
+
+    std::size_t number_of_chunks(std::size_t size) {
+        return std::min<std::size_t>(_OMP_MAXTHREADS, std::max<std::size_t>(size, 1));
+    }
+
+    /**
+     * @brief Splits [0, @a size) into @a numChunks contiguous chunks and calls @a function(chunkIdx, from, to) for
+     * each of them in OpenMP parallel loop.
+     * @details Exceptions cannot leave OpenMP parallel region, so they are caught and the first one (in the order of
+     * chunks) is rethrown afterwards.
+     */
+    template<typename Function>
+    void for_each_chunk(std::size_t size, std::size_t numChunks, Function function) {
+        std::vector<std::exception_ptr> chunkExceptions(numChunks);
+
+        _OMP_PARALLEL_FOR
+        for (std::size_t chunkIdx = 0; chunkIdx < numChunks; chunkIdx++) {
+            try {
+                function(chunkIdx, size * chunkIdx / numChunks, size * (chunkIdx + 1) / numChunks);
+            } catch (...) {
+                chunkExceptions[chunkIdx] = std::current_exception();
+            }
+        }
+
+        for (const auto &chunkException : chunkExceptions)
+            if (chunkException != nullptr)
+                std::rethrow_exception(chunkException);
+    }
+
+    /**
+     * @brief Sorts and deduplicates @a positions of the entries of a square matrix of size @a size (encoded in
+     * column-major order as col * size + row) and fills CSC @a rowIndices and @a columnPointers of this pattern.
+     */
+    void prepare_sparsity_pattern(std::vector<std::size_t> &positions, std::size_t size, arma::uvec &rowIndices,
+                                  arma::uvec &columnPointers)
+    {
+        std::sort(positions.begin(), positions.end());
+        positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+
+        rowIndices.set_size(positions.size());
+        columnPointers.zeros(size + 1);
+        for (std::size_t i{}; i < positions.size(); i++) {
+            rowIndices[i] = positions[i] % size;
+            columnPointers[positions[i] / size + 1]++;
+        }
+        for (std::size_t col{}; col < size; col++)
+            columnPointers[col + 1] += columnPointers[col];
+    }
+
+    /**
+     * @brief Returns the index of the value for @a position in sorted, unique @a positions.
+     */
+    std::size_t find_value_idx(const std::vector<std::size_t> &positions, std::size_t position) {
+        auto it = std::lower_bound(positions.begin(), positions.end(), position);
+        return it - positions.begin();
+    }
+
+    template<typename T>
+    std::vector<T> concatenate(std::vector<std::vector<T>> &chunks) {
+        std::size_t totalSize{};
+        for (const auto &chunk : chunks)
+            totalSize += chunk.size();
+
+        std::vector<T> result;
+        result.reserve(totalSize);
+        for (auto &chunk : chunks) {
+            result.insert(result.end(), chunk.begin(), chunk.end());
+            chunk = std::vector<T>{};
+        }
+        return result;
+    }
+
+    /**
+     * @brief Builds @a size x @a size sparse matrix from the entries of all chunks, concatenated in the order of chunks.
+     */
+    arma::sp_mat to_sparse_matrix(std::vector<MatrixEntries> &chunkEntries, std::size_t size) {
+        if (chunkEntries.size() == 1)
+            return chunkEntries.front().toSparseMatrix(size, size);
+
+        std::size_t numEntries{};
+        for (const auto &entries : chunkEntries)
+            numEntries += entries.size();
+
+        MatrixEntries entries;
+        entries.reserve(numEntries);
+        for (auto &chunk : chunkEntries) {
+            entries.append(chunk);
+            chunk.clear();
+        }
+        return entries.toSparseMatrix(size, size);
+    }
 }
 
 arma::sp_mat HamiltonianGenerator::generate() const {
-    arma::sp_mat result(this->fockBasis->size(), this->fockBasis->size());
-    for (std::size_t vectorIdx = 0; vectorIdx < this->fockBasis->size(); vectorIdx++) {
-        if (!this->diagonalTerms.empty())
-            this->addDiagonalTerms(result, vectorIdx);
-        for (const auto &hoppingTerm : this->hoppingTerms)
-            this->addHoppingTerm(result, vectorIdx, *hoppingTerm);
-        if (!this->doubleHoppingTerms.empty())
-            this->addDoubleHoppingTerms(result, vectorIdx);
+    arma::sp_mat hamiltonian;
+    if (!this->reuseStructure) {
+        hamiltonian = this->generateFromEntries();
+    } else {
+        if (!this->cachedStructure.has_value())
+            this->prepareCachedStructure();
+        hamiltonian = this->generateFromCachedStructure();
+    }
+
+    for (const auto &term : this->squareDoubleHoppingTerms) {
+        arma::sp_mat hoppingOperator = this->reuseStructure
+                                       ? this->generateHoppingOperatorFromCachedStructure(*term)
+                                       : this->generateHoppingOperator(*term);
+        hamiltonian += term->getSquareFactor(*this) * (hoppingOperator * hoppingOperator);
     }
-    return result;
+    return hamiltonian;
 }
 
-void HamiltonianGenerator::addDiagonalTerms(arma::sp_mat &result, std::size_t vectorIdx) const {
-    for (auto &diagonalTerm : this->diagonalTerms)
-        result(vectorIdx, vectorIdx) += diagonalTerm->calculate((*this->fockBasis)[vectorIdx], *this);
+arma::sp_mat HamiltonianGenerator::generateHoppingOperator(const DoubleHoppingTerm &term) const {
+    Expects(term.isSquareOfHoppingOperator());
+
+    std::size_t basisSize = this->fockBasis->size();
+    std::size_t numberOfSites = this->fockBasis->getNumberOfSites();
+    std::size_t numChunks = number_of_chunks(basisSize);
+    std::vector<MatrixEntries> chunkEntries(numChunks);
+
+    // Hops in both directions are enumerated separately, so each matrix element is added once
+    for_each_chunk(basisSize, numChunks, [&](std::size_t chunkIdx, std::size_t from, std::size_t to) {
+        HopData hopData;
+        for (std::size_t fromIdx = from; fromIdx < to; fromIdx++) {
+            for (std::size_t site{}; site < numberOfSites; site++) {
+                for (auto [fromSite, toSite] : {std::make_pair(site, site + 1), std::make_pair(site + 1, site)}) {
+                    auto toIdx = this->hoppingAction(fromIdx, fromSite, toSite, hopData);
+                    if (toIdx == std::nullopt)
+                        continue;
+
+                    double matrixElement = term.calculateSingleHop(hopData, *this) * hopData.ladderConstant;
+                    chunkEntries[chunkIdx].add(*toIdx, fromIdx, matrixElement);
+                }
+            }
+        }
+    });
+
+    return to_sparse_matrix(chunkEntries, basisSize);
 }
 
-void HamiltonianGenerator::addHoppingTerm(arma::sp_mat &result, std::size_t fromIdx,
-                                          const HoppingTerm &hoppingTerm) const
-{
-    for (std::size_t hoppingDistance : hoppingTerm.getHoppingDistances()) {
-        for (std::size_t fromSite = 0; fromSite < this->fockBasis->getNumberOfSites(); fromSite++) {
-            auto hopData = this->hoppingAction((*this->fockBasis)[fromIdx], fromSite, fromSite + hoppingDistance);
-            if (hopData == std::nullopt)
-                continue;
+std::unique_ptr<HamiltonianOperator> HamiltonianGenerator::generateOperator(bool matrixFree) const {
+    if (matrixFree)
+        return std::make_unique<MatrixFreeHamiltonianOperator>(*this);
+    else
+        return std::make_unique<SparseHamiltonianOperator>(this->generate());
+}
+
+arma::sp_mat HamiltonianGenerator::generateFromEntries() const {
+    std::size_t basisSize = this->fockBasis->size();
+    std::size_t numChunks = number_of_chunks(basisSize);
+    std::vector<MatrixEntries> chunkEntries(numChunks);
+
+    // No diagonal entries at all if there are no diagonal terms
+    arma::vec diagonal;
+    if (!this->diagonalTerms.empty())
+        diagonal = this->calculateDiagonal();
+
+    for_each_chunk(basisSize, numChunks, [&](std::size_t chunkIdx, std::size_t from, std::size_t to) {
+        this->addEntriesForVectors(chunkEntries[chunkIdx], diagonal, from, to);
+    });
+
+    return to_sparse_matrix(chunkEntries, basisSize);
+}
+
+void HamiltonianGenerator::prepareCachedStructure() const {
+    std::size_t basisSize = this->fockBasis->size();
+    std::size_t numChunks = number_of_chunks(basisSize);
+    std::size_t numHoppingTerms = this->hoppingTerms.size();
+
+    // Find all hops - the same chunking as in generateFromEntries() keeps the order independent of the number of
+    // threads
+    std::vector<std::vector<std::vector<HopRecord>>> chunkHops(numHoppingTerms,
+                                                               std::vector<std::vector<HopRecord>>(numChunks));
+    std::vector<std::vector<DoubleHopRecord>> chunkDoubleHops(numChunks);
+    for_each_chunk(basisSize, numChunks, [&](std::size_t chunkIdx, std::size_t from, std::size_t to) {
+        for (std::size_t vectorIdx = from; vectorIdx < to; vectorIdx++) {
+            for (std::size_t termIdx{}; termIdx < numHoppingTerms; termIdx++)
+                this->collectHops(chunkHops[termIdx][chunkIdx], vectorIdx, *this->hoppingTerms[termIdx]);
+            if (!this->enumeratedDoubleHoppingTerms.empty())
+                this->collectDoubleHops(chunkDoubleHops[chunkIdx], vectorIdx);
+        }
+    });
+
+    CachedStructure structure;
+    for (auto &termChunkHops : chunkHops)
+        structure.hops.push_back(concatenate(termChunkHops));
+    structure.doubleHops = concatenate(chunkDoubleHops);
+
+    // Sparsity pattern: sorted, unique positions of all entries encoded in column-major order as col * size + row
+    std::vector<std::size_t> positions;
+    auto encode = [basisSize](std::size_t row, std::size_t col) { return col * basisSize + row; };
+    if (!this->diagonalTerms.empty())
+        for (std::size_t vectorIdx{}; vectorIdx < basisSize; vectorIdx++)
+            positions.push_back(encode(vectorIdx, vectorIdx));
+    for (const auto &hops : structure.hops) {
+        for (const auto &hop : hops) {
+            positions.push_back(encode(hop.fromIdx, hop.toIdx));
+            positions.push_back(encode(hop.toIdx, hop.fromIdx));
+        }
+    }
+    for (const auto &doubleHop : structure.doubleHops)
+        positions.push_back(encode(doubleHop.toIdx, doubleHop.fromIdx));
+
+    prepare_sparsity_pattern(positions, basisSize, structure.rowIndices, structure.columnPointers);
+    auto findValueIdx = [&positions, encode](std::size_t row, std::size_t col) {
+        return find_value_idx(positions, encode(row, col));
+    };
+
+    if (!this->diagonalTerms.empty()) {
+        structure.diagonalValueIdxs.resize(basisSize);
+        for (std::size_t vectorIdx{}; vectorIdx < basisSize; vectorIdx++)
+            structure.diagonalValueIdxs[vectorIdx] = findValueIdx(vectorIdx, vectorIdx);
+    }
+    for (auto &hops : structure.hops) {
+        _OMP_PARALLEL_FOR
+        for (std::size_t i = 0; i < hops.size(); i++) {
+            hops[i].valueIdx = findValueIdx(hops[i].fromIdx, hops[i].toIdx);
+            hops[i].transposedValueIdx = findValueIdx(hops[i].toIdx, hops[i].fromIdx);
+        }
+    }
+    auto &doubleHops = structure.doubleHops;
+    _OMP_PARALLEL_FOR
+    for (std::size_t i = 0; i < doubleHops.size(); i++)
+        doubleHops[i].valueIdx = findValueIdx(doubleHops[i].toIdx, doubleHops[i].fromIdx);
+
+    if (!this->squareDoubleHoppingTerms.empty())
+        this->prepareCachedHoppingOperatorStructure(structure);
+
+    this->cachedStructure = std::move(structure);
+}
+
+/**
+ * @brief Finds nearest-neighbour hops in both directions, as in generateHoppingOperator(), and the sparsity pattern of
+ * the hopping operator. Different hops may land on the same matrix element (for example for 2 sites with PBC).
+ */
+void HamiltonianGenerator::prepareCachedHoppingOperatorStructure(CachedStructure &structure) const {
+    std::size_t basisSize = this->fockBasis->size();
+    std::size_t numberOfSites = this->fockBasis->getNumberOfSites();
+    std::size_t numChunks = number_of_chunks(basisSize);
+
+    std::vector<std::vector<HopRecord>> chunkHops(numChunks);
+    for_each_chunk(basisSize, numChunks, [&](std::size_t chunkIdx, std::size_t from, std::size_t to) {
+        HopData hopData;
+        for (std::size_t fromIdx = from; fromIdx < to; fromIdx++) {
+            for (std::size_t site{}; site < numberOfSites; site++) {
+                for (auto [fromSite, toSite] : {std::make_pair(site, site + 1), std::make_pair(site + 1, site)}) {
+                    auto toIdx = this->hoppingAction(fromIdx, fromSite, toSite, hopData);
+                    if (toIdx == std::nullopt)
+                        continue;
+
+                    HopRecord hop;
+                    hop.fromIdx = fromIdx;
+                    hop.toIdx = *toIdx;
+                    hop.fromSite = hopData.fromSite;
+                    hop.toSite = hopData.toSite;
+                    hop.ladderConstant = hopData.ladderConstant;
+                    chunkHops[chunkIdx].push_back(hop);
+                }
+            }
+        }
+    });
+    auto &hops = structure.hoppingOperatorHops;
+    hops = concatenate(chunkHops);
+
+    std::vector<std::size_t> positions;
+    positions.reserve(hops.size());
+    for (const auto &hop : hops)
+        positions.push_back(hop.fromIdx * basisSize + hop.toIdx);
+    prepare_sparsity_pattern(positions, basisSize, structure.hoppingOperatorRowIndices,
+                             structure.hoppingOperatorColumnPointers);
+
+    _OMP_PARALLEL_FOR
+    for (std::size_t i = 0; i < hops.size(); i++)
+        hops[i].valueIdx = find_value_idx(positions, hops[i].fromIdx * basisSize + hops[i].toIdx);
+}
+
+arma::sp_mat HamiltonianGenerator::generateHoppingOperatorFromCachedStructure(const DoubleHoppingTerm &term) const {
+    Expects(term.isSquareOfHoppingOperator());
+    Expects(this->cachedStructure.has_value());
+    const auto &structure = *this->cachedStructure;
+    const auto &basis = *this->fockBasis;
+    std::size_t basisSize = basis.size();
+    const auto &hops = structure.hoppingOperatorHops;
+
+    // As in generateFromCachedStructure(), elements are evaluated in parallel and then added sequentially
+    std::vector<double> elements(hops.size());
+    for_each_chunk(hops.size(), number_of_chunks(hops.size()), [&](std::size_t, std::size_t from, std::size_t to) {
+        HopData hopData;
+        for (std::size_t i = from; i < to; i++) {
+            const auto &hop = hops[i];
+            hopData.fromSite = hop.fromSite;
+            hopData.toSite = hop.toSite;
+            hopData.fromVector = basis[hop.fromIdx];
+            hopData.toVector = basis[hop.toIdx];
+            hopData.fromIdx = hop.fromIdx;
+            hopData.toIdx = hop.toIdx;
+            hopData.ladderConstant = hop.ladderConstant;
+            elements[i] = term.calculateSingleHop(hopData, *this) * hop.ladderConstant;
+        }
+    });
+
+    arma::vec values(structure.hoppingOperatorRowIndices.size(), arma::fill::zeros);
+    for (std::size_t i{}; i < hops.size(); i++)
+        values[hops[i].valueIdx] += elements[i];
+
+    return arma::sp_mat(structure.hoppingOperatorRowIndices, structure.hoppingOperatorColumnPointers, values,
+                        basisSize, basisSize);
+}
+
+arma::sp_mat HamiltonianGenerator::generateFromCachedStructure() const {
+    Expects(this->cachedStructure.has_value());
+    const auto &structure = *this->cachedStructure;
+    const auto &basis = *this->fockBasis;
+    std::size_t basisSize = basis.size();
+    arma::vec values(structure.rowIndices.size(), arma::fill::zeros);
+
+    // It has to be done before double hops, which may also land on the diagonal
+    if (!this->diagonalTerms.empty()) {
+        arma::vec diagonal = this->calculateDiagonal();
+        for (std::size_t vectorIdx{}; vectorIdx < basisSize; vectorIdx++)
+            values[structure.diagonalValueIdxs[vectorIdx]] = diagonal[vectorIdx];
+    }
+
+    // Hop elements are evaluated in parallel, but then added sequentially, since different hops may contribute to the
+    // same matrix element
+    std::vector<double> elements;
+    for (std::size_t termIdx{}; termIdx < this->hoppingTerms.size(); termIdx++) {
+        const auto &hops = structure.hops[termIdx];
+        const auto &hoppingTerm = *this->hoppingTerms[termIdx];
+        elements.resize(hops.size());
+        // The term is evaluated for blocks of hops, so there is one virtual call per block (see
+        // HoppingTerm::calculateBatch())
+        for_each_chunk(hops.size(), number_of_chunks(hops.size()), [&](std::size_t, std::size_t from, std::size_t to) {
+            std::vector<HopData> hopBlock;
+            std::vector<double> elementBlock;
+            for (std::size_t blockFrom = from; blockFrom < to; blockFrom += HOP_BLOCK_SIZE) {
+                std::size_t blockTo = std::min(to, blockFrom + HOP_BLOCK_SIZE);
+                hopBlock.resize(blockTo - blockFrom);
+                for (std::size_t i = blockFrom; i < blockTo; i++) {
+                    const auto &hop = hops[i];
+                    auto &hopData = hopBlock[i - blockFrom];
+                    hopData.fromSite = hop.fromSite;
+                    hopData.toSite = hop.toSite;
+                    hopData.fromVector = basis[hop.fromIdx];
+                    hopData.toVector = basis[hop.toIdx];
+                    hopData.fromIdx = hop.fromIdx;
+                    hopData.toIdx = hop.toIdx;
+                    hopData.ladderConstant = hop.ladderConstant;
+                }
+                hoppingTerm.calculateBatch(hopBlock, *this, elementBlock);
+                for (std::size_t i = blockFrom; i < blockTo; i++)
+                    elements[i] = elementBlock[i - blockFrom] * hops[i].ladderConstant;
+            }
+        });
+        for (std::size_t i{}; i < hops.size(); i++) {
+            values[hops[i].valueIdx] += elements[i];
+            values[hops[i].transposedValueIdx] += elements[i];
+        }
+    }
+
+    const auto &doubleHops = structure.doubleHops;
+    elements.resize(doubleHops.size());
+    for_each_chunk(doubleHops.size(), number_of_chunks(doubleHops.size()),
+                   [&](std::size_t, std::size_t from, std::size_t to)
+    {
+        HopData firstHop, secondHop;
+        for (std::size_t i = from; i < to; i++) {
+            const auto &doubleHop = doubleHops[i];
+            firstHop.fromSite = doubleHop.firstFromSite;
+            firstHop.toSite = doubleHop.firstToSite;
+            firstHop.fromVector = basis[doubleHop.fromIdx];
+            firstHop.toVector = basis[doubleHop.middleIdx];
+            secondHop.fromSite = doubleHop.secondFromSite;
+            secondHop.toSite = doubleHop.secondToSite;
+            secondHop.fromVector = basis[doubleHop.middleIdx];
+            secondHop.toVector = basis[doubleHop.toIdx];
+            firstHop.fromIdx = doubleHop.fromIdx;
+            firstHop.toIdx = doubleHop.middleIdx;
+            secondHop.fromIdx = doubleHop.middleIdx;
+            secondHop.toIdx = doubleHop.toIdx;
 
             double matrixElement{};
-            matrixElement += hoppingTerm.calculate(*hopData, *this);
+            for (auto &doubleHoppingTerm : this->enumeratedDoubleHoppingTerms)
+                matrixElement += doubleHoppingTerm->calculate(firstHop, secondHop, *this);
+            elements[i] = matrixElement * doubleHop.ladderConstant;
+        }
+    });
+    for (std::size_t i{}; i < doubleHops.size(); i++)
+        values[doubleHops[i].valueIdx] += elements[i];
 
-            matrixElement *= hopData->ladderConstant;
-            std::size_t toIdx = *(this->fockBasis->findIndex(hopData->toVector));
+    return arma::sp_mat(structure.rowIndices, structure.columnPointers, values, basisSize, basisSize);
+}
 
-            result(fromIdx, toIdx) += matrixElement;
-            result(toIdx, fromIdx) += matrixElement;
+void HamiltonianGenerator::addEntriesForVectors(MatrixEntries &entries, const arma::vec &diagonal,
+                                                std::size_t fromVectorIdx, std::size_t toVectorIdx) const
+{
+    // Buffers for hops and their elements are reused for all vectors and terms in the chunk
+    std::vector<HopData> hops;
+    std::vector<double> elements;
+    for (std::size_t vectorIdx = fromVectorIdx; vectorIdx < toVectorIdx; vectorIdx++) {
+        if (!diagonal.empty())
+            entries.add(vectorIdx, vectorIdx, diagonal[vectorIdx]);
+        for (const auto &hoppingTerm : this->hoppingTerms)
+            this->addHoppingTerm(entries, vectorIdx, *hoppingTerm, hops, elements);
+        if (!this->enumeratedDoubleHoppingTerms.empty())
+            this->addDoubleHoppingTerms(entries, vectorIdx);
+    }
+}
+
+void HamiltonianGenerator::addHoppingTerm(MatrixEntries &entries, std::size_t fromIdx,
+                                          const HoppingTerm &hoppingTerm, std::vector<HopData> &hops,
+                                          std::vector<double> &elements) const
+{
+    hops.clear();
+    HopData hopData;
+    for (std::size_t hoppingDistance : hoppingTerm.getHoppingDistances()) {
+        for (std::size_t fromSite = 0; fromSite < this->fockBasis->getNumberOfSites(); fromSite++) {
+            if (this->hoppingAction(fromIdx, fromSite, fromSite + hoppingDistance, hopData) != std::nullopt)
+                hops.push_back(hopData);
         }
     }
+
+    hoppingTerm.calculateBatch(hops, *this, elements);
+    for (std::size_t i{}; i < hops.size(); i++) {
+        double matrixElement = elements[i] * hops[i].ladderConstant;
+        entries.add(fromIdx, *hops[i].toIdx, matrixElement);
+        entries.add(*hops[i].toIdx, fromIdx, matrixElement);
+    }
 }
 
-auto HamiltonianGenerator::calculateDoubleHopMatrixElement(const HopData &firstHop, const HopData &secondHop) const {
+double HamiltonianGenerator::calculateDoubleHopMatrixElement(const HopData &firstHop, const HopData &secondHop) const {
     double matrixElement{};
-    for (auto &doubleHoppingTerm : this->doubleHoppingTerms)
+    for (auto &doubleHoppingTerm : this->enumeratedDoubleHoppingTerms)
         matrixElement += doubleHoppingTerm->calculate(firstHop, secondHop, *this);
 
-    matrixElement *= firstHop.ladderConstant * secondHop.ladderConstant;
-    std::size_t toIdx = *(this->fockBasis->findIndex(secondHop.toVector));
-
-    return std::make_tuple(matrixElement, toIdx);
+    return matrixElement * firstHop.ladderConstant * secondHop.ladderConstant;
 }
 
-void HamiltonianGenerator::performSecondHop(arma::sp_mat &result, std::size_t fromIdx, const HopData &firstHop) const {
+void HamiltonianGenerator::performSecondHop(MatrixEntries &entries, std::size_t fromIdx,
+                                            const HopData &firstHop) const
+{
+    HopData secondHop;
     for (std::size_t fromSite2 = 0; fromSite2 < this->fockBasis->getNumberOfSites(); fromSite2++) {
-        auto secondHopForward = this->hoppingAction(firstHop.toVector, fromSite2, fromSite2 + 1);
-        if (secondHopForward != std::nullopt) {
-            auto[matrixElement, toIdx] = this->calculateDoubleHopMatrixElement(firstHop, *secondHopForward);
-            result(toIdx, fromIdx) += matrixElement;
-        }
+        auto toIdxForward = this->hoppingAction(*firstHop.toIdx, fromSite2, fromSite2 + 1, secondHop);
+        if (toIdxForward != std::nullopt)
+            entries.add(*toIdxForward, fromIdx, this->calculateDoubleHopMatrixElement(firstHop, secondHop));
+
+        auto toIdxBackward = this->hoppingAction(*firstHop.toIdx, fromSite2 + 1, fromSite2, secondHop);
+        if (toIdxBackward != std::nullopt)
+            entries.add(*toIdxBackward, fromIdx, this->calculateDoubleHopMatrixElement(firstHop, secondHop));
+    }
+}
+
+void HamiltonianGenerator::addDoubleHoppingTerms(MatrixEntries &entries, std::size_t fromIdx) const {
+    HopData firstHop;
+    for (std::size_t fromSite1 = 0; fromSite1 < this->fockBasis->getNumberOfSites(); fromSite1++) {
+        if (this->hoppingAction(fromIdx, fromSite1, fromSite1 + 1, firstHop) != std::nullopt)
+            this->performSecondHop(entries, fromIdx, firstHop);
 
-        auto secondHopBackward = this->hoppingAction(firstHop.toVector, fromSite2 + 1, fromSite2);
-        if (secondHopBackward != std::nullopt) {
-            auto[matrixElement, toIdx] = this->calculateDoubleHopMatrixElement(firstHop, *secondHopBackward);
-            result(toIdx, fromIdx) += matrixElement;
+        if (this->hoppingAction(fromIdx, fromSite1 + 1, fromSite1, firstHop) != std::nullopt)
+            this->performSecondHop(entries, fromIdx, firstHop);
+    }
+}
+
+void HamiltonianGenerator::collectHops(std::vector<HopRecord> &hops, std::size_t fromIdx,
+                                       const HoppingTerm &hoppingTerm) const
+{
+    HopData hopData;
+    for (std::size_t hoppingDistance : hoppingTerm.getHoppingDistances()) {
+        for (std::size_t fromSite = 0; fromSite < this->fockBasis->getNumberOfSites(); fromSite++) {
+            auto toIdx = this->hoppingAction(fromIdx, fromSite, fromSite + hoppingDistance, hopData);
+            if (toIdx == std::nullopt)
+                continue;
+
+            HopRecord hop;
+            hop.fromIdx = fromIdx;
+            hop.toIdx = *toIdx;
+            hop.fromSite = hopData.fromSite;
+            hop.toSite = hopData.toSite;
+            hop.ladderConstant = hopData.ladderConstant;
+            hops.push_back(hop);
         }
     }
 }
 
-void HamiltonianGenerator::addDoubleHoppingTerms(arma::sp_mat &result, std::size_t fromIdx) const {
+void HamiltonianGenerator::collectDoubleHops(std::vector<DoubleHopRecord> &doubleHops, std::size_t fromIdx) const {
+    auto collectSecondHops = [this, &doubleHops, fromIdx](const HopData &firstHop, std::size_t middleIdx) {
+        HopData secondHop;
+        for (std::size_t fromSite2 = 0; fromSite2 < this->fockBasis->getNumberOfSites(); fromSite2++) {
+            for (auto [secondFrom, secondTo] : {std::make_pair(fromSite2, fromSite2 + 1),
+                                                std::make_pair(fromSite2 + 1, fromSite2)})
+            {
+                auto toIdx = this->hoppingAction(middleIdx, secondFrom, secondTo, secondHop);
+                if (toIdx == std::nullopt)
+                    continue;
+
+                DoubleHopRecord doubleHop;
+                doubleHop.fromIdx = fromIdx;
+                doubleHop.middleIdx = middleIdx;
+                doubleHop.toIdx = *toIdx;
+                doubleHop.firstFromSite = firstHop.fromSite;
+                doubleHop.firstToSite = firstHop.toSite;
+                doubleHop.secondFromSite = secondHop.fromSite;
+                doubleHop.secondToSite = secondHop.toSite;
+                doubleHop.ladderConstant = firstHop.ladderConstant * secondHop.ladderConstant;
+                doubleHops.push_back(doubleHop);
+            }
+        }
+    };
+
+    HopData firstHop;
     for (std::size_t fromSite1 = 0; fromSite1 < this->fockBasis->getNumberOfSites(); fromSite1++) {
-        auto firstHopForward = this->hoppingAction((*this->fockBasis)[fromIdx], fromSite1, fromSite1 + 1);
-        if (firstHopForward != std::nullopt)
-            this->performSecondHop(result, fromIdx, *firstHopForward);
+        auto middleIdxForward = this->hoppingAction(fromIdx, fromSite1, fromSite1 + 1, firstHop);
+        if (middleIdxForward != std::nullopt)
+            collectSecondHops(firstHop, *middleIdxForward);
 
-        auto firstHopBackward = this->hoppingAction((*this->fockBasis)[fromIdx], fromSite1 + 1, fromSite1);
-        if (firstHopBackward != std::nullopt)
-            this->performSecondHop(result, fromIdx, *firstHopBackward);
+        auto middleIdxBackward = this->hoppingAction(fromIdx, fromSite1 + 1, fromSite1, firstHop);
+        if (middleIdxBackward != std::nullopt)
+            collectSecondHops(firstHop, *middleIdxBackward);
     }
 }
 
@@ -135,25 +593,80 @@ const std::vector<std::shared_ptr<DoubleHoppingTerm>> &HamiltonianGenerator::get
     return this->doubleHoppingTerms;
 }
 
+template<typename Term>
+void HamiltonianGenerator::addTypedTerm(const std::shared_ptr<Term> &term) {
+    Expects(term != nullptr);
+    const auto &termReference = *term;
+    // dynamic_cast to void* gives the address of the most derived object, so it can be later static_cast-ed to it
+    this->typedTerms.emplace_back(std::type_index(typeid(termReference)),
+                                  std::shared_ptr<void>(term, dynamic_cast<void*>(term.get())));
+}
+
 void HamiltonianGenerator::addDiagonalTerm(std::shared_ptr<DiagonalTerm> term) {
+    this->addTypedTerm(term);
     this->diagonalTerms.push_back(std::move(term));
+    this->cachedStructure.reset();
 }
 
 void HamiltonianGenerator::addHoppingTerm(std::shared_ptr<HoppingTerm> term) {
+    this->addTypedTerm(term);
     this->hoppingTerms.push_back(std::move(term));
+    this->cachedStructure.reset();
 }
 
 void HamiltonianGenerator::addDoubleHoppingTerm(std::shared_ptr<DoubleHoppingTerm> term) {
+    this->addTypedTerm(term);
+    if (term->isSquareOfHoppingOperator())
+        this->squareDoubleHoppingTerms.push_back(term);
+    else
+        this->enumeratedDoubleHoppingTerms.push_back(term);
     this->doubleHoppingTerms.push_back(std::move(term));
+    this->cachedStructure.reset();
+}
+
+const SymmetrySectors &HamiltonianGenerator::getSymmetrySectors() const {
+    if (!this->symmetrySectors.has_value()) {
+        if (this->usePBC)
+            this->symmetrySectors = SymmetrySectors::translation(this->fockBasis);
+        else
+            this->symmetrySectors = SymmetrySectors::reflection(this->fockBasis);
+    }
+    return *this->symmetrySectors;
+}
+
+const SiteOccupations &HamiltonianGenerator::getSiteOccupations() const {
+    if (!this->siteOccupations.has_value())
+        this->siteOccupations = SiteOccupations(*this->fockBasis);
+    return *this->siteOccupations;
+}
+
+arma::vec HamiltonianGenerator::calculateDiagonal() const {
+    arma::vec diagonal(this->fockBasis->size(), arma::fill::zeros);
+    if (this->diagonalTerms.empty())
+        return diagonal;
+
+    const auto &occupations = this->getSiteOccupations();
+    for (const auto &diagonalTerm : this->diagonalTerms)
+        diagonalTerm->addToDiagonal(occupations, *this, diagonal);
+    return diagonal;
+}
+
+bool HamiltonianGenerator::usesSymmetrySectors(const arma::sp_mat &hamiltonian) const {
+    switch (this->symmetrySectorsMode) {
+        case SymmetrySectorsMode::NONE:
+            return false;
+        case SymmetrySectorsMode::DETECT:
+            return this->getSymmetrySectors().isSymmetric(hamiltonian);
+        case SymmetrySectorsMode::DECLARED:
+            return true;
+    }
+    throw std::runtime_error("Internal error");
 }
 
 Eigensystem HamiltonianGenerator::calculateEigensystem(bool calculateEigenvectors) const {
     if (this->hoppingTerms.empty() && this->doubleHoppingTerms.empty()) {
         // For only diagonal terms there is no need to diagonalize
-        arma::vec energies(this->fockBasis->size());
-        for (auto &diagonalTerm : this->diagonalTerms)
-            for (std::size_t i{}; i < this->fockBasis->size(); i++)
-                energies[i] += diagonalTerm->calculate((*this->fockBasis)[i], *this);
+        arma::vec energies = this->calculateDiagonal();
 
         if (calculateEigenvectors)
             return Eigensystem(energies, arma::eye(this->fockBasis->size(), this->fockBasis->size()),
@@ -162,7 +675,11 @@ Eigensystem HamiltonianGenerator::calculateEigensystem(bool calculateEigenvector
             return Eigensystem(energies, this->getFockBasis());
     } else {
         // If off-diagonal elements are non-empty, diagonalization is needed
-        arma::mat hamiltonian = arma::mat(this->generate());
+        arma::sp_mat sparseHamiltonian = this->generate();
+        if (this->usesSymmetrySectors(sparseHamiltonian))
+            return this->getSymmetrySectors().calculateEigensystem(sparseHamiltonian, calculateEigenvectors);
+
+        arma::mat hamiltonian = arma::mat(sparseHamiltonian);
 
         arma::vec armaEnergies;
         arma::mat armaEigvec;
@@ -176,3 +693,41 @@ Eigensystem HamiltonianGenerator::calculateEigensystem(bool calculateEigenvector
         }
     }
 }
+
+Eigensystem HamiltonianGenerator::calculatePartialEigensystem(const EigenvectorSelector &selectEigenvectors) const {
+    if (this->hoppingTerms.empty() && this->doubleHoppingTerms.empty())
+        return this->calculateEigensystem(true);
+
+    arma::sp_mat sparseHamiltonian = this->generate();
+    if (this->usesSymmetrySectors(sparseHamiltonian))
+        return this->getSymmetrySectors().calculateEigensystem(sparseHamiltonian, true);
+
+    RangeEigensolver eigensolver{arma::mat(sparseHamiltonian)};
+    Eigensystem eigenvaluesOnly(eigensolver.getEigenvalues(), this->getFockBasis());
+    auto selectedIndices = selectEigenvectors(eigenvaluesOnly);
+    if (selectedIndices.has_value() && selectedIndices->empty())
+        return eigenvaluesOnly;
+
+    std::size_t fromIdx = 0;
+    std::size_t toIdx = eigensolver.size();
+    if (selectedIndices.has_value()) {
+        auto [minIdx, maxIdx] = std::minmax_element(selectedIndices->begin(), selectedIndices->end());
+        Expects(*maxIdx < eigensolver.size());
+        fromIdx = *minIdx;
+        toIdx = *maxIdx + 1;
+    }
+    return Eigensystem(eigensolver.getEigenvalues(), eigensolver.calculateEigenvectors(fromIdx, toIdx), fromIdx,
+                       this->getFockBasis());
+}
+
+Eigensystem HamiltonianGenerator::calculateEigensystemAroundEnergy(double epsilon, std::size_t numEigenpairs) const {
+    Expects(epsilon > 0 && epsilon < 1);
+    Expects(numEigenpairs > 0);
+
+    auto hamiltonian = this->generateOperator(false);
+    auto spectrumBounds = hamiltonian->findSpectrumBounds();
+    auto [low, high] = spectrumBounds;
+    PolynomialFilteredEigensolver eigensolver(*hamiltonian, spectrumBounds);
+    auto [energies, eigenvectors] = eigensolver.calculateEigenpairs(low + epsilon * (high - low), numEigenpairs);
+    return Eigensystem(energies, eigenvectors, spectrumBounds, this->getFockBasis());
+}
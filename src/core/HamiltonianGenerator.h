@@ -8,68 +8,223 @@
 #include <armadillo>
 #include <random>
 #include <memory>
+#include <functional>
+#include <optional>
+#include <typeindex>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "FockBasis.h"
 #include "DiagonalTerm.h"
 #include "HoppingTerm.h"
 #include "DoubleHoppingTerm.h"
 #include "Eigensystem.h"
+#include "MatrixEntries.h"
+#include "HamiltonianOperator.h"
+#include "SymmetrySectors.h"
+#include "SiteOccupations.h"
+#include "HopData.h"
 
 /**
- * @brief Struct representing a hop between two sites.
+ * @brief Hamiltonian generator, which can accept multiple DiagonalTerm -s, HoppingTerm -s and DoubleHoppingTerm -s.
  */
-struct HopData {
-    std::size_t fromSite{};
-    std::size_t toSite{};
-    FockBasis::Vector fromVector{};
-    FockBasis::Vector toVector{};
+class HamiltonianGenerator {
+public:
+    /**
+     * @brief Specifies if calculateEigensystem() should diagonalize the hamiltonian separately in symmetry sectors:
+     * momentum sectors for PBC and reflection parity sectors for OBC.
+     */
+    enum class SymmetrySectorsMode {
+        /**
+         * @brief Always diagonalize the full hamiltonian.
+         */
+        NONE,
+
+        /**
+         * @brief Use symmetry sectors if the generated hamiltonian turns out to be symmetric.
+         */
+        DETECT,
+
+        /**
+         * @brief The hamiltonian is declared to be symmetric and the sectors are used without checking it.
+         */
+        DECLARED
+    };
 
     /**
-     * @brief The constant given by acting with \f$ \hat{b}_\text{toSite} \hat{b}_\text{fromSite} \f$ on
-     * \f$ |\text{fromVector}> \f$.
+     * @brief A function which, given an Eigensystem without eigenvectors, returns ascending indices of eigenvectors to
+     * calculate, or std::nullopt if all of them are needed. See calculatePartialEigensystem().
      */
-    double ladderConstant{};
-};
+    using EigenvectorSelector = std::function<std::optional<std::vector<std::size_t>>(const Eigensystem &)>;
 
-/**
- * @brief Hamiltonian generator, which can accept multiple DiagonalTerm -s, HoppingTerm -s and DoubleHoppingTerm -s.
- */
-class HamiltonianGenerator {
 private:
+    /**
+     * @brief A single hop between basis vectors together with the indices of both matrix elements it contributes to
+     * in the cached sparsity pattern.
+     */
+    struct HopRecord {
+        std::size_t fromIdx{};
+        std::size_t toIdx{};
+        std::size_t fromSite{};
+        std::size_t toSite{};
+        double ladderConstant{};
+        std::size_t valueIdx{};
+        std::size_t transposedValueIdx{};
+    };
+
+    /**
+     * @brief Two consecutive hops fromIdx -> middleIdx -> toIdx together with the index of the matrix element in the
+     * cached sparsity pattern. @a ladderConstant is the product of constants of both hops.
+     */
+    struct DoubleHopRecord {
+        std::size_t fromIdx{};
+        std::size_t middleIdx{};
+        std::size_t toIdx{};
+        std::size_t firstFromSite{};
+        std::size_t firstToSite{};
+        std::size_t secondFromSite{};
+        std::size_t secondToSite{};
+        double ladderConstant{};
+        std::size_t valueIdx{};
+    };
+
+    /**
+     * @brief Everything in the hamiltonian, which does not depend on the values of the terms: hop graph and CSC
+     * sparsity pattern. The same is stored for the hopping operator Y of squared DoubleHoppingTerm -s (see
+     * generateHoppingOperator()), if there are any.
+     */
+    struct CachedStructure {
+        std::vector<std::size_t> diagonalValueIdxs;
+        std::vector<std::vector<HopRecord>> hops;   // separately for each hopping term
+        std::vector<DoubleHopRecord> doubleHops;
+        arma::uvec rowIndices;
+        arma::uvec columnPointers;
+
+        std::vector<HopRecord> hoppingOperatorHops;     // only valueIdx is used
+        arma::uvec hoppingOperatorRowIndices;
+        arma::uvec hoppingOperatorColumnPointers;
+    };
+
     const bool usePBC;
+    const bool reuseStructure;
     std::shared_ptr<const FockBasis> fockBasis;
     std::vector<std::shared_ptr<DiagonalTerm>> diagonalTerms;
     std::vector<std::shared_ptr<HoppingTerm>> hoppingTerms;
     std::vector<std::shared_ptr<DoubleHoppingTerm>> doubleHoppingTerms;
+    std::vector<std::shared_ptr<DoubleHoppingTerm>> enumeratedDoubleHoppingTerms;
+    std::vector<std::shared_ptr<DoubleHoppingTerm>> squareDoubleHoppingTerms;
+    std::vector<std::pair<std::type_index, std::shared_ptr<void>>> typedTerms;   // all terms with their exact types
+    mutable std::optional<CachedStructure> cachedStructure;
+    SymmetrySectorsMode symmetrySectorsMode = SymmetrySectorsMode::NONE;
+    mutable std::optional<SymmetrySectors> symmetrySectors;
+    mutable std::optional<SiteOccupations> siteOccupations;
+
+    [[nodiscard]] std::optional<std::size_t> hoppingAction(std::size_t fromIdx, std::size_t fromSite,
+                                                           std::size_t toSite, HopData &hopData) const;
+    [[nodiscard]] double calculateDoubleHopMatrixElement(const HopData &firstHop, const HopData &secondHop) const;
+    void performSecondHop(MatrixEntries &entries, std::size_t fromIdx, const HopData &firstHop) const;
+    void addHoppingTerm(MatrixEntries &entries, std::size_t fromIdx, const HoppingTerm &hoppingTerm,
+                        std::vector<HopData> &hops, std::vector<double> &elements) const;
+    void addDoubleHoppingTerms(MatrixEntries &entries, std::size_t fromIdx) const;
+    void addEntriesForVectors(MatrixEntries &entries, const arma::vec &diagonal, std::size_t fromVectorIdx,
+                              std::size_t toVectorIdx) const;
+    [[nodiscard]] arma::sp_mat generateFromEntries() const;
+
+    void collectHops(std::vector<HopRecord> &hops, std::size_t fromIdx, const HoppingTerm &hoppingTerm) const;
+    void collectDoubleHops(std::vector<DoubleHopRecord> &doubleHops, std::size_t fromIdx) const;
+    void prepareCachedStructure() const;
+    void prepareCachedHoppingOperatorStructure(CachedStructure &structure) const;
+    [[nodiscard]] arma::sp_mat generateFromCachedStructure() const;
+    [[nodiscard]] arma::sp_mat generateHoppingOperatorFromCachedStructure(const DoubleHoppingTerm &term) const;
+
+    [[nodiscard]] const SymmetrySectors &getSymmetrySectors() const;
+    [[nodiscard]] bool usesSymmetrySectors(const arma::sp_mat &hamiltonian) const;
 
-    [[nodiscard]] std::optional<HopData>
-    hoppingAction(const FockBasis::Vector &fromVector, std::size_t fromSite, std::size_t toSite) const;
-    [[nodiscard]] auto calculateDoubleHopMatrixElement(const HopData &firstHop, const HopData &secondHop) const;
-    void performSecondHop(arma::sp_mat &result, std::size_t fromIdx, const HopData &firstHop) const;
-    void addDiagonalTerms(arma::sp_mat &result, std::size_t vectorIdx) const;
-    void addHoppingTerm(arma::sp_mat &result, std::size_t fromIdx, const HoppingTerm &hoppingTerm) const;
-    void addDoubleHoppingTerms(arma::sp_mat &result, std::size_t fromIdx) const;
+    template<typename Term>
+    void addTypedTerm(const std::shared_ptr<Term> &term);
 
 public:
-    HamiltonianGenerator(std::shared_ptr<const FockBasis> fockBasis, bool usePBC)
-            : usePBC{usePBC}, fockBasis{std::move(fockBasis)}
+    /**
+     * @brief Creates the generator for a given @a fockBasis.
+     * @details If @a reuseStructure is @a true, the hop graph and the sparsity pattern of the hamiltonian are
+     * computed on the first generate() call and reused in all subsequent ones - see generate().
+     */
+    HamiltonianGenerator(std::shared_ptr<const FockBasis> fockBasis, bool usePBC, bool reuseStructure = false)
+            : usePBC{usePBC}, reuseStructure{reuseStructure}, fockBasis{std::move(fockBasis)}
     { }
     virtual ~HamiltonianGenerator() = default;
 
     /**
      * @brief Generates the hamiltonian matrix - it uses all provided DiagonalTerm -s and HoppingTerms -s.
-     * @details For HoppingTerms -s, it produces them by doing one-site hop on each basis vector and finding which
-     * another basis vector is obtained that way.
+     * @details <p> For HoppingTerms -s, it produces them by doing one-site hop on each basis vector and finding which
+     * another basis vector is obtained that way. All entries are first collected as MatrixEntries and then the sparse
+     * matrix is constructed in one go.
+     * <p> Basis vectors are split into contiguous chunks, one per OpenMP thread, and each thread collects entries to its
+     * own buffer. The buffers are then concatenated in the order of chunks, so the result does not depend on the
+     * number of threads.
+     * <p> If the generator was created with @a reuseStructure flag, the first call finds all hops and builds the
+     * sparsity pattern of the matrix once. Each next call (for example for a next disorder realisation) only
+     * re-evaluates the terms for cached hops and fills the values of the pattern in place, without searching the
+     * basis again. Adding a new term invalidates the cache. It also concerns the hopping operator of squared terms
+     * described below. The cached hop graph takes a few tens of bytes per hop, so it may be bigger than the matrix.
+     * <p> DoubleHoppingTerm -s which are squares of a hopping operator (see
+     * DoubleHoppingTerm::isSquareOfHoppingOperator()) are not enumerated hop by hop. Instead, the sparse matrix of the
+     * hopping operator is built (see generateHoppingOperator()) and squared.
      */
     [[nodiscard]] arma::sp_mat generate() const;
 
+    /**
+     * @brief Returns the matrix of the one-body nearest-neighbour hopping operator \f$ \hat{Y} \f$ of @a term, which
+     * has to be a square of it (see DoubleHoppingTerm::isSquareOfHoppingOperator()).
+     */
+    [[nodiscard]] arma::sp_mat generateHoppingOperator(const DoubleHoppingTerm &term) const;
+
+    /**
+     * @brief Returns the hamiltonian as HamiltonianOperator.
+     * @details If @a matrixFree is @a false, it is SparseHamiltonianOperator with the matrix from generate().
+     * Otherwise, it is MatrixFreeHamiltonianOperator, which computes the products with vectors on the fly and keeps the
+     * reference to this generator.
+     */
+    [[nodiscard]] std::unique_ptr<HamiltonianOperator> generateOperator(bool matrixFree) const;
+
+    /**
+     * @brief Returns the diagonal of the hamiltonian, i.e. the sum of all DiagonalTerm -s for all basis vectors.
+     * @details The terms are evaluated for the whole basis at once using DiagonalTerm::addToDiagonal() on
+     * SiteOccupations of the basis, which are prepared on the first call and reused afterwards.
+     */
+    [[nodiscard]] arma::vec calculateDiagonal() const;
+
     /**
      * @brief Generates hamiltonian and diagonalizes it. It is not dumb, if hamiltonian is diagonal it doesn't
      * invoke diagonalization routines.
+     * @details For PBC, if the hamiltonian turns out to be translationally invariant, it is diagonalized separately in
+     * each momentum sector (see SymmetrySectors) and the eigenvectors are mapped back to the full basis. Similarly, for
+     * OBC a hamiltonian symmetric under the reflection of sites is diagonalized separately in even and odd sectors.
+     * It has to be enabled by setSymmetrySectorsMode() - by default the full hamiltonian is diagonalized.
      * @return Eigensystem with or without eigenvectors, depending on @a calculateEigenvectors flag.
      */
     [[nodiscard]] Eigensystem calculateEigensystem(bool calculateEigenvectors) const;
 
+    /**
+     * @brief Generates hamiltonian and calculates all eigenvalues, but only the eigenvectors selected by
+     * @a selectEigenvectors for the Eigensystem without them.
+     * @details The result contains the eigenvectors for the whole range between the lowest and the highest selected
+     * index (see Eigensystem::hasEigenvector()). They are calculated using RangeEigensolver, so the cost of them is
+     * proportional to the width of the range. For diagonal hamiltonians and hamiltonians diagonalized in symmetry
+     * sectors (see calculateEigensystem()) all eigenvectors are calculated anyway, since they are cheap there.
+     */
+    [[nodiscard]] Eigensystem calculatePartialEigensystem(const EigenvectorSelector &selectEigenvectors) const;
+
+    /**
+     * @brief Generates hamiltonian and calculates only @a numEigenpairs eigenvalues together with eigenvectors closest
+     * to the energy normalized to [0, 1] @a epsilon.
+     * @details The sparse PolynomialFilteredEigensolver is used, so the dense matrix is never created. The bounds of
+     * the spectrum are found using HamiltonianOperator::findSpectrumBounds() and the resulting Eigensystem contains
+     * them (see Eigensystem::hasFullSpectrum()).
+     */
+    [[nodiscard]] Eigensystem calculateEigensystemAroundEnergy(double epsilon, std::size_t numEigenpairs) const;
+
     /**
      * @brief Returns the distance between sites of given indices.
      * @details Note, that when used with PBC, the shorter distance will be returned.
@@ -95,7 +250,39 @@ public:
      */
     [[nodiscard]] const std::vector<std::shared_ptr<DoubleHoppingTerm>> &getDoubleHoppingTerms() const;
 
+    /**
+     * @brief Calls @a visitor(term) for all terms, whose exact type (subclasses do not count) is one of @a Terms, in
+     * the order of adding them. The term is passed as a reference to its concrete type.
+     * @details The types of terms are determined once when they are added, so it does not need any dynamic_cast and
+     * @a visitor is resolved statically for each of @a Terms.
+     * @return @a true if at least one term was visited.
+     */
+    template<typename... Terms, typename Visitor>
+    bool visitTerms(Visitor &&visitor) {
+        bool visited{};
+        for (const auto &typedTerm : this->typedTerms) {
+            auto visitIfMatches = [&](auto *termTypeTag) {
+                using Term = std::remove_pointer_t<decltype(termTypeTag)>;
+                if (typedTerm.first != std::type_index(typeid(Term)))
+                    return;
+                visitor(*static_cast<Term*>(typedTerm.second.get()));
+                visited = true;
+            };
+            (visitIfMatches(static_cast<Terms*>(nullptr)), ...);
+        }
+        return visited;
+    }
+
+    void setSymmetrySectorsMode(SymmetrySectorsMode mode) { this->symmetrySectorsMode = mode; }
+    [[nodiscard]] SymmetrySectorsMode getSymmetrySectorsMode() const { return this->symmetrySectorsMode; }
+
     [[nodiscard]] const std::shared_ptr<const FockBasis> &getFockBasis() const { return this->fockBasis; };
+
+    /**
+     * @brief Returns SiteOccupations of the basis, which are prepared on the first call (which is not thread-safe)
+     * and then shared, for example with CavityZCache.
+     */
+    [[nodiscard]] const SiteOccupations &getSiteOccupations() const;
     [[nodiscard]] bool usingPBC() const { return this->usePBC; }
 };
 
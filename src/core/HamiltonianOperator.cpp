@@ -0,0 +1,291 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#include <complex>
+#include <random>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "HamiltonianOperator.h"
+#include "utils/Assertions.h"
+
+namespace {
+    constexpr std::size_t MAX_LANCZOS_STEPS = 2000;
+    constexpr std::size_t CONVERGENCE_CHECK_INTERVAL = 10;
+    constexpr double RITZ_RESIDUAL_TOLERANCE = 1e-11;
+    constexpr std::size_t INVERSE_ITERATIONS = 3;
+
+    /**
+     * @brief Three-term Lanczos recurrence without reorthogonalization, storing only the last two Krylov vectors.
+     */
+    class LanczosIteration {
+    private:
+        const HamiltonianOperator &hamiltonian;
+        arma::vec currentVector;
+        arma::vec previousVector;
+        arma::vec hamiltonianTimesVector;
+        double beta{};
+
+    public:
+        LanczosIteration(const HamiltonianOperator &hamiltonian, const arma::vec &initialVector)
+                : hamiltonian{hamiltonian}, currentVector{initialVector},
+                  previousVector(initialVector.size(), arma::fill::zeros)
+        { }
+
+        /**
+         * @brief Performs a step returning the diagonal element of the tridiagonal matrix for current vector. The
+         * off-diagonal element is then available via getBeta() and the current vector is replaced by the next one.
+         */
+        double step() {
+            this->hamiltonian.apply(this->currentVector, this->hamiltonianTimesVector);
+            this->hamiltonianTimesVector -= this->beta * this->previousVector;
+            double alpha = arma::dot(this->currentVector, this->hamiltonianTimesVector);
+            this->hamiltonianTimesVector -= alpha * this->currentVector;
+            this->beta = arma::norm(this->hamiltonianTimesVector);
+
+            std::swap(this->previousVector, this->currentVector);
+            if (this->beta > 0)
+                this->currentVector = this->hamiltonianTimesVector / this->beta;
+            else
+                this->currentVector.zeros();
+            return alpha;
+        }
+
+        [[nodiscard]] double getBeta() const { return this->beta; }
+        [[nodiscard]] const arma::vec &getCurrentVector() const { return this->currentVector; }
+    };
+
+    /**
+     * @brief Diagonal and off-diagonal elements of the tridiagonal matrix from Lanczos iteration.
+     * @details The extremal eigenpairs are found with methods specific to tridiagonal matrices in O(m) per
+     * iteration, where m is the size of the matrix: eigenvalues by Sturm sequence bisection and eigenvectors by
+     * inverse iteration, so the convergence can be checked often even for long iterations.
+     */
+    struct LanczosCoefficients {
+        std::vector<double> alphas;
+        std::vector<double> betas;      // betas[i] couples i and i + 1; the last one is the residual of the iteration
+
+        [[nodiscard]] std::size_t size() const { return this->alphas.size(); }
+
+        /**
+         * @brief Returns the bound of absolute values of all eigenvalues (from Gershgorin circles).
+         */
+        [[nodiscard]] double normBound() const {
+            double bound{};
+            for (std::size_t i{}; i < this->size(); i++) {
+                double radius = (i > 0 ? std::abs(this->betas[i - 1]) : 0)
+                                + (i + 1 < this->size() ? std::abs(this->betas[i]) : 0);
+                bound = std::max(bound, std::abs(this->alphas[i]) + radius);
+            }
+            return std::max(bound, std::numeric_limits<double>::min());
+        }
+
+        /**
+         * @brief Returns the number of eigenvalues lower than @a x (from the signs of LDL^T pivots of T - x).
+         */
+        [[nodiscard]] std::size_t countEigenvaluesBelow(double x, double pivotMin) const {
+            std::size_t count{};
+            double pivot = 1;
+            for (std::size_t i{}; i < this->size(); i++) {
+                pivot = this->alphas[i] - x - (i > 0 ? this->betas[i - 1] * this->betas[i - 1] / pivot : 0);
+                if (std::abs(pivot) < pivotMin)
+                    pivot = -pivotMin;
+                if (pivot < 0)
+                    count++;
+            }
+            return count;
+        }
+
+        /**
+         * @brief Returns the eigenvalue of index @a index in the ascending order using bisection.
+         */
+        [[nodiscard]] double findEigenvalue(std::size_t index) const {
+            double norm = this->normBound();
+            double pivotMin = std::numeric_limits<double>::min() * std::max(1., norm * norm);
+            double low = -norm, high = norm;
+            double tolerance = 2 * std::numeric_limits<double>::epsilon() * norm;
+            while (high - low > tolerance) {
+                double middle = (low + high) / 2;
+                if (middle <= low || middle >= high)
+                    break;
+                if (this->countEigenvaluesBelow(middle, pivotMin) > index)
+                    high = middle;
+                else
+                    low = middle;
+            }
+            return (low + high) / 2;
+        }
+
+        /**
+         * @brief Returns normalized eigenvector for @a eigenvalue using inverse iteration with tridiagonal LU
+         * factorization with partial pivoting.
+         */
+        [[nodiscard]] std::vector<double> findEigenvector(double eigenvalue) const {
+            std::size_t n = this->size();
+            double pivotMin = std::numeric_limits<double>::epsilon() * this->normBound();
+
+            // Factorization of T - eigenvalue: U has diagonal, 1st and 2nd superdiagonal, L has multipliers
+            std::vector<double> diagonal(n), superdiagonal1(n), superdiagonal2(n), multipliers(n);
+            std::vector<bool> swapped(n);
+            for (std::size_t i{}; i < n; i++) {
+                diagonal[i] = this->alphas[i] - eigenvalue;
+                superdiagonal1[i] = (i + 1 < n) ? this->betas[i] : 0;
+            }
+            for (std::size_t i{}; i + 1 < n; i++) {
+                double subdiagonal = this->betas[i];
+                if (std::abs(diagonal[i]) >= std::abs(subdiagonal)) {
+                    if (std::abs(diagonal[i]) < pivotMin)
+                        diagonal[i] = pivotMin;
+                    multipliers[i] = subdiagonal / diagonal[i];
+                    diagonal[i + 1] -= multipliers[i] * superdiagonal1[i];
+                } else {
+                    swapped[i] = true;
+                    multipliers[i] = diagonal[i] / subdiagonal;
+                    double nextDiagonal = diagonal[i + 1];
+                    double nextSuperdiagonal = superdiagonal1[i + 1];
+                    diagonal[i] = subdiagonal;
+                    diagonal[i + 1] = superdiagonal1[i] - multipliers[i] * nextDiagonal;
+                    superdiagonal1[i] = nextDiagonal;
+                    superdiagonal2[i] = nextSuperdiagonal;
+                    superdiagonal1[i + 1] = -multipliers[i] * nextSuperdiagonal;
+                }
+            }
+            if (std::abs(diagonal[n - 1]) < pivotMin)
+                diagonal[n - 1] = pivotMin;
+
+            std::vector<double> vector(n);
+            for (std::size_t i{}; i < n; i++)
+                vector[i] = 1 + 0.1 * static_cast<double>(i % 7);
+            for (std::size_t iteration{}; iteration < INVERSE_ITERATIONS; iteration++) {
+                for (std::size_t i{}; i + 1 < n; i++) {
+                    if (swapped[i])
+                        std::swap(vector[i], vector[i + 1]);
+                    vector[i + 1] -= multipliers[i] * vector[i];
+                }
+                for (std::size_t i = n; i-- > 0; ) {
+                    double value = vector[i];
+                    if (i + 1 < n)
+                        value -= superdiagonal1[i] * vector[i + 1];
+                    if (i + 2 < n)
+                        value -= superdiagonal2[i] * vector[i + 2];
+                    vector[i] = value / diagonal[i];
+                }
+                double norm = std::sqrt(std::inner_product(vector.begin(), vector.end(), vector.begin(), 0.));
+                for (auto &element : vector)
+                    element /= norm;
+            }
+            return vector;
+        }
+    };
+
+    /**
+     * @brief Pseudorandom normalized vector with a fixed seed, so that the results are reproducible and independent
+     * of random generators used by simulations.
+     */
+    arma::vec initial_lanczos_vector(std::size_t size) {
+        std::mt19937 mt(std::mt19937::default_seed);
+        std::uniform_real_distribution<double> distribution(-1, 1);
+        arma::vec vector(size);
+        for (auto &element : vector)
+            element = distribution(mt);
+        return vector / arma::norm(vector);
+    }
+
+    /**
+     * @brief Runs Lanczos iteration until the lowest (and, if @a needsHighest, also the highest) Ritz value converges
+     * or an invariant subspace is found.
+     * @details Throws std::runtime_error if it has not converged in MAX_LANCZOS_STEPS steps (unless the whole space
+     * was spanned).
+     */
+    LanczosCoefficients lanczos_coefficients(const HamiltonianOperator &hamiltonian, const arma::vec &initialVector,
+                                             bool needsHighest)
+    {
+        std::size_t maxSteps = std::min(hamiltonian.size(), MAX_LANCZOS_STEPS);
+        LanczosIteration iteration(hamiltonian, initialVector);
+        LanczosCoefficients coefficients;
+        double maxAbsAlpha{};
+        bool converged = false;
+        for (std::size_t step = 1; step <= maxSteps; step++) {
+            double alpha = iteration.step();
+            double beta = iteration.getBeta();
+            coefficients.alphas.push_back(alpha);
+            coefficients.betas.push_back(beta);
+            maxAbsAlpha = std::max(maxAbsAlpha, std::abs(alpha));
+
+            double tolerance = RITZ_RESIDUAL_TOLERANCE * std::max(maxAbsAlpha, 1.);
+            if (beta <= tolerance) {
+                converged = true;
+                break;
+            }
+            if (step % CONVERGENCE_CHECK_INTERVAL != 0 && step != maxSteps)
+                continue;
+
+            // Residual of a Ritz pair is beta times the last component of the eigenvector of tridiagonal matrix
+            auto isConverged = [&](std::size_t index) {
+                auto ritzVector = coefficients.findEigenvector(coefficients.findEigenvalue(index));
+                return std::abs(beta * ritzVector.back()) <= tolerance;
+            };
+            if (isConverged(0) && (!needsHighest || isConverged(step - 1))) {
+                converged = true;
+                break;
+            }
+        }
+
+        if (!converged && maxSteps < hamiltonian.size()) {
+            throw std::runtime_error("Lanczos iteration has not converged in " + std::to_string(maxSteps)
+                                     + " steps");
+        }
+        return coefficients;
+    }
+}
+
+void HamiltonianOperator::applyToBlock(const arma::cx_mat &vectors, arma::cx_mat &result) const {
+    Expects(vectors.n_rows == this->size());
+    result.set_size(vectors.n_rows, vectors.n_cols);
+    for (std::size_t i{}; i < vectors.n_cols; i++) {
+        // Columns are wrapped in vectors using their memory directly
+        const arma::cx_vec vector(const_cast<std::complex<double>*>(vectors.colptr(i)), vectors.n_rows, false, true);
+        arma::cx_vec resultVector(result.colptr(i), result.n_rows, false, true);
+        this->apply(vector, resultVector);
+    }
+}
+
+void HamiltonianOperator::applyToBlock(const arma::mat &vectors, arma::mat &result) const {
+    Expects(vectors.n_rows == this->size());
+    result.set_size(vectors.n_rows, vectors.n_cols);
+    for (std::size_t i{}; i < vectors.n_cols; i++) {
+        const arma::vec vector(const_cast<double*>(vectors.colptr(i)), vectors.n_rows, false, true);
+        arma::vec resultVector(result.colptr(i), result.n_rows, false, true);
+        this->apply(vector, resultVector);
+    }
+}
+
+std::pair<double, double> HamiltonianOperator::findSpectrumBounds() const {
+    Expects(this->size() > 0);
+
+    auto coefficients = lanczos_coefficients(*this, initial_lanczos_vector(this->size()), true);
+    return {coefficients.findEigenvalue(0), coefficients.findEigenvalue(coefficients.size() - 1)};
+}
+
+arma::vec HamiltonianOperator::findGroundState() const {
+    Expects(this->size() > 0);
+
+    arma::vec initialVector = initial_lanczos_vector(this->size());
+    auto coefficients = lanczos_coefficients(*this, initialVector, false);
+    auto groundStateCoefficients = coefficients.findEigenvector(coefficients.findEigenvalue(0));
+
+    // The same iteration repeated gives the same Krylov vectors, which are now summed with Ritz vector coefficients
+    LanczosIteration iteration(*this, initialVector);
+    arma::vec groundState = groundStateCoefficients[0] * initialVector;
+    for (std::size_t i = 1; i < groundStateCoefficients.size(); i++) {
+        iteration.step();
+        groundState += groundStateCoefficients[i] * iteration.getCurrentVector();
+    }
+    return groundState / arma::norm(groundState);
+}
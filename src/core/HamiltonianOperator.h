@@ -0,0 +1,69 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#ifndef MBL_ED_HAMILTONIANOPERATOR_H
+#define MBL_ED_HAMILTONIANOPERATOR_H
+
+#include <utility>
+
+#include <armadillo>
+
+/**
+ * @brief Hamiltonian seen as a linear operator, which can act on vectors, regardless of how (and if) its matrix
+ * elements are stored.
+ * @details The hamiltonian is assumed to be real and symmetric.
+ */
+class HamiltonianOperator {
+public:
+    virtual ~HamiltonianOperator() = default;
+
+    /**
+     * @brief Returns the dimension of the space the operator acts on.
+     */
+    [[nodiscard]] virtual std::size_t size() const = 0;
+
+    /**
+     * @brief Computes @a result = H @a vector. @a result is resized if necessary and must not alias @a vector.
+     */
+    virtual void apply(const arma::vec &vector, arma::vec &result) const = 0;
+
+    /**
+     * @brief Computes @a result = H @a vector. @a result is resized if necessary and must not alias @a vector.
+     */
+    virtual void apply(const arma::cx_vec &vector, arma::cx_vec &result) const = 0;
+
+    /**
+     * @brief Computes @a result = H @a vectors for all columns of @a vectors at once. @a result is resized if
+     * necessary and must not alias @a vectors.
+     * @details The default implementation applies the operator to the columns one by one (without copying them).
+     * Implementations may override it to traverse the matrix elements only once for the whole block.
+     */
+    virtual void applyToBlock(const arma::cx_mat &vectors, arma::cx_mat &result) const;
+
+    /**
+     * @brief Computes @a result = H @a vectors for all columns of real @a vectors at once. @a result is resized if
+     * necessary and must not alias @a vectors.
+     * @details Since the hamiltonian is real, complex vectors can be stored as separate real and imaginary planes and
+     * evolved using this overload. The default implementation applies the operator to the columns one by one.
+     */
+    virtual void applyToBlock(const arma::mat &vectors, arma::mat &result) const;
+
+    /**
+     * @brief Returns the lowest and the highest eigenvalue of the hamiltonian.
+     * @details The default implementation uses Lanczos iteration built on apply(), which stores only a couple of
+     * vectors. The Ritz values lie slightly inside the spectrum, so a safety margin should be added if the spectrum
+     * has to be enclosed. std::runtime_error is thrown if the iteration does not converge.
+     */
+    [[nodiscard]] virtual std::pair<double, double> findSpectrumBounds() const;
+
+    /**
+     * @brief Returns normalized eigenvector for the lowest eigenvalue of the hamiltonian.
+     * @details The default implementation uses Lanczos iteration built on apply(). Krylov vectors are not stored -
+     * the iteration is repeated to sum them up once the ground state of the tridiagonal matrix is known.
+     */
+    [[nodiscard]] virtual arma::vec findGroundState() const;
+};
+
+
+#endif //MBL_ED_HAMILTONIANOPERATOR_H
@@ -0,0 +1,37 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#ifndef MBL_ED_HOPDATA_H
+#define MBL_ED_HOPDATA_H
+
+#include <optional>
+
+#include "FockBasis.h"
+
+/**
+ * @brief Struct representing a hop between two sites.
+ * @details The vectors are views of the vectors from FockBasis, so HopData is cheap to create and copy.
+ */
+struct HopData {
+    std::size_t fromSite{};
+    std::size_t toSite{};
+    FockBasis::VectorView fromVector{};
+    FockBasis::VectorView toVector{};
+
+    /**
+     * @brief The constant given by acting with \f$ \hat{b}_\text{toSite} \hat{b}_\text{fromSite} \f$ on
+     * \f$ |\text{fromVector}> \f$.
+     */
+    double ladderConstant{};
+
+    /**
+     * @brief Indices of @a fromVector and @a toVector in FockBasis, if they are known. Terms may use them to look up
+     * precomputed per-vector values.
+     */
+    std::optional<std::size_t> fromIdx{};
+    std::optional<std::size_t> toIdx{};
+};
+
+
+#endif //MBL_ED_HOPDATA_H
@@ -5,10 +5,12 @@
 #ifndef MBL_ED_HOPPINGTERM_H
 #define MBL_ED_HOPPINGTERM_H
 
+#include <vector>
+
 #include "FockBasis.h"
+#include "HopData.h"
 
 class HamiltonianGenerator;
-struct HopData;
 
 /**
  * @brief A class representing hopping term (off-diagonal term) of second-quantized hamiltonian.
@@ -23,7 +25,8 @@ public:
      * \f$|\text{hopData.fromVector}\rangle \f$ and moving it to \f$ |\text{hopData.toVector}\rangle \f$.
      * @details This constant may depend on all of these things: from which site to which there is a hop and what are
      * initial and final Fock vectors (eg. density dependent hoppings). Note, that factors which appear just from ladder
-     * operators should not be included, only this additional \f$ Y \f$ factor.
+     * operators should not be included, only this additional \f$ Y \f$ factor. The method may be called concurrently
+     * from many threads (see HamiltonianGenerator::generate()).
      */
     [[nodiscard]] virtual double calculate(const HopData &hopData, const HamiltonianGenerator &generator) const = 0;
 
@@ -31,6 +34,38 @@ public:
      * @brief Returns a vector of all hopping distances with nonzero factors in this HoppingTerm that should be sampled.
      */
     [[nodiscard]] virtual std::vector<std::size_t> getHoppingDistances() const = 0;
+
+    /**
+     * @brief Computes calculate() for all @a hops and stores the results in @a elements (which is resized).
+     * @details It is used by HamiltonianGenerator in the hot loops, so that there is one virtual call per block of hops
+     * instead of one per hop. The default implementation just calls calculate() for each hop - see StaticHoppingTerm
+     * for the one without virtual calls.
+     */
+    virtual void calculateBatch(const std::vector<HopData> &hops, const HamiltonianGenerator &generator,
+                                std::vector<double> &elements) const
+    {
+        elements.resize(hops.size());
+        for (std::size_t i{}; i < hops.size(); i++)
+            elements[i] = this->calculate(hops[i], generator);
+    }
+};
+
+/**
+ * @brief HoppingTerm, whose calculateBatch() calls @a Derived::calculate() statically, so it can be inlined in the
+ * loop.
+ * @details Concrete terms should derive from StaticHoppingTerm<Term> (CRTP) instead of HoppingTerm directly.
+ */
+template<typename Derived>
+class StaticHoppingTerm : public HoppingTerm {
+public:
+    void calculateBatch(const std::vector<HopData> &hops, const HamiltonianGenerator &generator,
+                        std::vector<double> &elements) const override
+    {
+        const auto &derived = static_cast<const Derived &>(*this);
+        elements.resize(hops.size());
+        for (std::size_t i{}; i < hops.size(); i++)
+            elements[i] = derived.Derived::calculate(hops[i], generator);
+    }
 };
 
 #endif //MBL_ED_HOPPINGTERM_H
@@ -0,0 +1,38 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#include "MatrixEntries.h"
+#include "utils/Assertions.h"
+
+void MatrixEntries::append(const MatrixEntries &other) {
+    this->rows.insert(this->rows.end(), other.rows.begin(), other.rows.end());
+    this->cols.insert(this->cols.end(), other.cols.begin(), other.cols.end());
+    this->values.insert(this->values.end(), other.values.begin(), other.values.end());
+}
+
+void MatrixEntries::reserve(std::size_t numEntries) {
+    this->rows.reserve(numEntries);
+    this->cols.reserve(numEntries);
+    this->values.reserve(numEntries);
+}
+
+void MatrixEntries::clear() {
+    this->rows.clear();
+    this->cols.clear();
+    this->values.clear();
+}
+
+arma::sp_mat MatrixEntries::toSparseMatrix(std::size_t numRows, std::size_t numCols) const {
+    arma::umat locations(2, this->size());
+    for (std::size_t i{}; i < this->size(); i++) {
+        Assert(this->rows[i] < numRows);
+        Assert(this->cols[i] < numCols);
+        locations(0, i) = this->rows[i];
+        locations(1, i) = this->cols[i];
+    }
+    arma::vec armaValues(this->values);
+
+    // add_values = true sums repeating locations, check_for_zeros = true drops entries which cancelled out
+    return arma::sp_mat(true, locations, armaValues, numRows, numCols, true, true);
+}
@@ -0,0 +1,48 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#ifndef MBL_ED_MATRIXENTRIES_H
+#define MBL_ED_MATRIXENTRIES_H
+
+#include <vector>
+
+#include <armadillo>
+
+/**
+ * @brief A list of (row, column, value) triplets, which can be converted to arma::sp_mat in a single batch.
+ * @details Inserting elements to arma::sp_mat one by one shifts the whole CSC arrays on each insertion, so it is much
+ * faster to collect all entries first. The same position may be added multiple times - the values are then summed.
+ */
+class MatrixEntries {
+private:
+    std::vector<arma::uword> rows;
+    std::vector<arma::uword> cols;
+    std::vector<double> values;
+
+public:
+    void add(std::size_t row, std::size_t col, double value) {
+        this->rows.push_back(row);
+        this->cols.push_back(col);
+        this->values.push_back(value);
+    }
+
+    /**
+     * @brief Appends all entries from @a other after the entries already present.
+     */
+    void append(const MatrixEntries &other);
+
+    void reserve(std::size_t numEntries);
+    void clear();
+    [[nodiscard]] std::size_t size() const { return this->values.size(); }
+    [[nodiscard]] bool empty() const { return this->values.empty(); }
+
+    /**
+     * @brief Creates @a numRows x @a numCols sparse matrix from the entries. Values on repeating positions are summed
+     * and zeros are not stored.
+     */
+    [[nodiscard]] arma::sp_mat toSparseMatrix(std::size_t numRows, std::size_t numCols) const;
+};
+
+
+#endif //MBL_ED_MATRIXENTRIES_H
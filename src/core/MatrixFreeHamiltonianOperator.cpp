@@ -0,0 +1,222 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#include <algorithm>
+#include <exception>
+#include <vector>
+
+#include "MatrixFreeHamiltonianOperator.h"
+#include "utils/Assertions.h"
+#include "utils/OMPMacros.h"
+
+namespace {
+    /**
+     * @brief Adds @a factor * @a matrix * @a vector to @a result. @a matrix has to be symmetric, so its CSC data can be
+     * used as CSR - see SparseHamiltonianOperator.
+     */
+    template<typename Vector>
+    void add_symmetric_sp_mat_times_vec(double factor, const arma::sp_mat &matrix, const Vector &vector,
+                                        Vector &result)
+    {
+        using Scalar = typename Vector::elem_type;
+
+        const double *matrixData = matrix.values;
+        const arma::uword *matrixColIdx = matrix.row_indices;
+        const arma::uword *matrixRowPtr = matrix.col_ptrs;
+
+        _OMP_PARALLEL_FOR
+        for (std::size_t elementIdx = 0; elementIdx < matrix.n_rows; elementIdx++) {
+            Scalar Ax_i{};
+            for (std::size_t dataIdx = matrixRowPtr[elementIdx]; dataIdx < matrixRowPtr[elementIdx + 1]; dataIdx++)
+                Ax_i += matrixData[dataIdx] * vector[matrixColIdx[dataIdx]];
+            result[elementIdx] += factor * Ax_i;
+        }
+    }
+}
+
+MatrixFreeHamiltonianOperator::MatrixFreeHamiltonianOperator(const HamiltonianGenerator &generator)
+        : generator{generator}, basis{*generator.getFockBasis()}, diagonal{generator.calculateDiagonal()}
+{
+    for (const auto &doubleHoppingTerm : generator.getDoubleHoppingTerms()) {
+        if (doubleHoppingTerm->isSquareOfHoppingOperator()) {
+            this->squareHoppingOperators.emplace_back(doubleHoppingTerm->getSquareFactor(generator),
+                                                      generator.generateHoppingOperator(*doubleHoppingTerm));
+        } else {
+            this->enumeratedDoubleHoppingTerms.push_back(doubleHoppingTerm.get());
+        }
+    }
+}
+
+/**
+ * @brief Fills @a hopData for the action of b_{toSite}^\dagger b_{fromSite} on the basis vector of index @a fromIdx
+ * and returns the index of the resulting vector, or std::nullopt if the hop is not possible. It is the same as
+ * HamiltonianGenerator::hoppingAction().
+ */
+std::optional<std::size_t> MatrixFreeHamiltonianOperator::hop(std::size_t fromIdx, std::size_t fromSite,
+                                                              std::size_t toSite, HopData &hopData) const
+{
+    std::size_t numberOfSites = this->basis.getNumberOfSites();
+    if (this->generator.usingPBC()) {
+        fromSite %= numberOfSites;
+        toSite %= numberOfSites;
+    } else if (fromSite >= numberOfSites || toSite >= numberOfSites) {
+        return std::nullopt;
+    }
+
+    auto fromVector = this->basis[fromIdx];
+    double constant = (fromVector[toSite] + 1) * fromVector[fromSite];
+    if (constant == 0)
+        return std::nullopt;
+
+    auto toIdx = this->basis.findIndexAfterHop(fromVector, fromSite, toSite);
+    if (!toIdx.has_value())
+        return std::nullopt;
+
+    hopData.fromSite = fromSite;
+    hopData.toSite = toSite;
+    hopData.fromVector = fromVector;
+    hopData.toVector = this->basis[*toIdx];
+    hopData.fromIdx = fromIdx;
+    hopData.toIdx = toIdx;
+    hopData.ladderConstant = std::sqrt(constant);
+    return toIdx;
+}
+
+template<typename Vector>
+void MatrixFreeHamiltonianOperator::applyImpl(const Vector &vector, Vector &result) const {
+    using Scalar = typename Vector::elem_type;
+
+    Expects(vector.size() == this->size());
+    result.set_size(this->size());
+
+    const auto &hoppingTerms = this->generator.getHoppingTerms();
+    const auto &doubleHoppingTerms = this->enumeratedDoubleHoppingTerms;
+    std::size_t numberOfSites = this->basis.getNumberOfSites();
+
+    // Rows are split into contiguous chunks, one per thread
+    std::size_t numChunks = std::min<std::size_t>(_OMP_MAXTHREADS, std::max<std::size_t>(this->size(), 1));
+
+    // Exceptions thrown by the terms cannot escape the parallel region, so they are rethrown afterwards (the one from
+    // the first chunk)
+    std::vector<std::exception_ptr> chunkExceptions(numChunks);
+
+    _OMP_PARALLEL_FOR
+    for (std::size_t chunkIdx = 0; chunkIdx < numChunks; chunkIdx++) {
+        try {
+            HopData hopData, firstHop, secondHop;
+            std::size_t fromRowIdx = this->size() * chunkIdx / numChunks;
+            std::size_t toRowIdx = this->size() * (chunkIdx + 1) / numChunks;
+
+            for (std::size_t rowIdx = fromRowIdx; rowIdx < toRowIdx; rowIdx++) {
+                Scalar element = this->diagonal[rowIdx] * vector[rowIdx];
+
+                // HamiltonianGenerator enumerates each hop only from one side and puts it symmetrically, so for a given
+                // row both hops from and hops to rowVector have to be found
+                for (const auto &hoppingTerm : hoppingTerms) {
+                    for (std::size_t hoppingDistance : hoppingTerm->getHoppingDistances()) {
+                        for (std::size_t site = 0; site < numberOfSites; site++) {
+                            auto toIdx = this->hop(rowIdx, site, site + hoppingDistance, hopData);
+                            if (toIdx.has_value()) {
+                                double hopElement = hoppingTerm->calculate(hopData, this->generator);
+                                element += hopElement * hopData.ladderConstant * vector[*toIdx];
+                            }
+
+                            auto fromIdx = this->hop(rowIdx, site + hoppingDistance, site, hopData);
+                            if (fromIdx.has_value()) {
+                                // Reverse, so that the term sees the hop exactly as HamiltonianGenerator does
+                                std::swap(hopData.fromSite, hopData.toSite);
+                                std::swap(hopData.fromVector, hopData.toVector);
+                                std::swap(hopData.fromIdx, hopData.toIdx);
+                                double hopElement = hoppingTerm->calculate(hopData, this->generator);
+                                element += hopElement * hopData.ladderConstant * vector[*fromIdx];
+                            }
+                        }
+                    }
+                }
+
+                // For double hops, the symmetry of the hamiltonian is used to compute the row from hops from rowVector
+                if (!doubleHoppingTerms.empty()) {
+                    for (std::size_t firstSite = 0; firstSite < numberOfSites; firstSite++) {
+                        for (auto [firstFrom, firstTo] : {std::make_pair(firstSite, firstSite + 1),
+                                                          std::make_pair(firstSite + 1, firstSite)})
+                        {
+                            if (!this->hop(rowIdx, firstFrom, firstTo, firstHop).has_value())
+                                continue;
+
+                            for (std::size_t secondSite = 0; secondSite < numberOfSites; secondSite++) {
+                                for (auto [secondFrom, secondTo] : {std::make_pair(secondSite, secondSite + 1),
+                                                                    std::make_pair(secondSite + 1, secondSite)})
+                                {
+                                    auto toIdx = this->hop(*firstHop.toIdx, secondFrom, secondTo, secondHop);
+                                    if (!toIdx.has_value())
+                                        continue;
+
+                                    double hopElement{};
+                                    for (const auto &doubleHoppingTerm : doubleHoppingTerms) {
+                                        hopElement += doubleHoppingTerm->calculate(firstHop, secondHop,
+                                                                                   this->generator);
+                                    }
+                                    hopElement *= firstHop.ladderConstant * secondHop.ladderConstant;
+                                    element += hopElement * vector[*toIdx];
+                                }
+                            }
+                        }
+                    }
+                }
+
+                result[rowIdx] = element;
+            }
+        } catch (...) {
+            chunkExceptions[chunkIdx] = std::current_exception();
+        }
+    }
+
+    for (const auto &chunkException : chunkExceptions)
+        if (chunkException != nullptr)
+            std::rethrow_exception(chunkException);
+
+    for (const auto &[factor, hoppingOperator] : this->squareHoppingOperators) {
+        Vector hoppedVector(this->size(), arma::fill::zeros);
+        add_symmetric_sp_mat_times_vec(1, hoppingOperator, vector, hoppedVector);
+        add_symmetric_sp_mat_times_vec(factor, hoppingOperator, hoppedVector, result);
+    }
+}
+
+void MatrixFreeHamiltonianOperator::apply(const arma::vec &vector, arma::vec &result) const {
+    this->applyImpl(vector, result);
+}
+
+void MatrixFreeHamiltonianOperator::apply(const arma::cx_vec &vector, arma::cx_vec &result) const {
+    this->applyImpl(vector, result);
+}
+
+void MatrixFreeHamiltonianOperator::applyToBlock(const arma::mat &vectors, arma::mat &result) const {
+    Expects(vectors.n_rows == this->size());
+    result.set_size(vectors.n_rows, vectors.n_cols);
+
+    // Since the hamiltonian is real, H(x + iy) = Hx + iHy
+    arma::cx_vec pair(this->size()), hamiltonianTimesPair;
+    std::size_t colIdx{};
+    for (; colIdx + 1 < vectors.n_cols; colIdx += 2) {
+        const double *realPart = vectors.colptr(colIdx);
+        const double *imagPart = vectors.colptr(colIdx + 1);
+        for (std::size_t i{}; i < this->size(); i++)
+            pair[i] = {realPart[i], imagPart[i]};
+
+        this->applyImpl(pair, hamiltonianTimesPair);
+
+        double *resultRealPart = result.colptr(colIdx);
+        double *resultImagPart = result.colptr(colIdx + 1);
+        for (std::size_t i{}; i < this->size(); i++) {
+            resultRealPart[i] = hamiltonianTimesPair[i].real();
+            resultImagPart[i] = hamiltonianTimesPair[i].imag();
+        }
+    }
+    if (colIdx < vectors.n_cols) {
+        arma::vec vector = vectors.col(colIdx);
+        arma::vec hamiltonianTimesVector;
+        this->applyImpl(vector, hamiltonianTimesVector);
+        result.col(colIdx) = hamiltonianTimesVector;
+    }
+}
@@ -0,0 +1,59 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#ifndef MBL_ED_MATRIXFREEHAMILTONIANOPERATOR_H
+#define MBL_ED_MATRIXFREEHAMILTONIANOPERATOR_H
+
+#include <optional>
+#include <vector>
+#include <utility>
+
+#include "HamiltonianOperator.h"
+#include "HamiltonianGenerator.h"
+
+/**
+ * @brief HamiltonianOperator which does not store the off-diagonal matrix elements, but computes them on the fly from
+ * the terms of HamiltonianGenerator each time apply() is invoked.
+ * @details Only the diagonal is stored, so the memory scales with the dimension of the basis and not with the number
+ * of non-zero elements. Each row of the result is computed independently by enumerating all hops from a given basis
+ * vector and finding the target vectors using FockBasis::findIndexAfterHop(), so it is strongly advised to use the
+ * basis with FockBasis::IndexingScheme::RANKING. It gives the same results as the matrix from
+ * HamiltonianGenerator::generate(), provided that the hamiltonian is symmetric.
+ * <p> The operator keeps the reference to HamiltonianGenerator, which should outlive it. The terms should not change
+ * while the operator is in use, the diagonal is computed only once in the constructor.
+ * <p> DoubleHoppingTerm -s which are squares of a hopping operator \f$ c \hat{Y}^2 \f$ are applied as
+ * \f$ c \hat{Y}(\hat{Y}v) \f$ using sparse \f$ \hat{Y} \f$ matrices, also built in the constructor. They are much
+ * smaller than \f$ \hat{Y}^2 \f$.
+ */
+class MatrixFreeHamiltonianOperator : public HamiltonianOperator {
+private:
+    const HamiltonianGenerator &generator;
+    const FockBasis &basis;
+    arma::vec diagonal;
+    std::vector<const DoubleHoppingTerm*> enumeratedDoubleHoppingTerms;
+    std::vector<std::pair<double, arma::sp_mat>> squareHoppingOperators;   // pairs (factor, hopping operator)
+
+    [[nodiscard]] std::optional<std::size_t> hop(std::size_t fromIdx, std::size_t fromSite, std::size_t toSite,
+                                                 HopData &hopData) const;
+    template<typename Vector>
+    void applyImpl(const Vector &vector, Vector &result) const;
+
+public:
+    explicit MatrixFreeHamiltonianOperator(const HamiltonianGenerator &generator);
+
+    [[nodiscard]] std::size_t size() const override { return this->basis.size(); }
+    void apply(const arma::vec &vector, arma::vec &result) const override;
+    void apply(const arma::cx_vec &vector, arma::cx_vec &result) const override;
+
+    /**
+     * @brief Computes @a result = H @a vectors.
+     * @details Pairs of columns are applied as real and imaginary parts of a single complex vector, so the hops are
+     * enumerated once for both of them.
+     */
+    void applyToBlock(const arma::mat &vectors, arma::mat &result) const override;
+    using HamiltonianOperator::applyToBlock;
+};
+
+
+#endif //MBL_ED_MATRIXFREEHAMILTONIANOPERATOR_H
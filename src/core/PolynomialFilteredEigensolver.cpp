@@ -0,0 +1,290 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+#include "PolynomialFilteredEigensolver.h"
+#include "utils/Assertions.h"
+
+PolynomialFilteredEigensolver::PolynomialFilteredEigensolver(const HamiltonianOperator &hamiltonian,
+                                                             std::pair<double, double> spectrumBounds,
+                                                             std::size_t blockSize, double tolerance)
+        : hamiltonian{hamiltonian}, low{spectrumBounds.first}, high{spectrumBounds.second}, blockSize{blockSize},
+          tolerance{tolerance}
+{
+    Expects(this->low < this->high);
+    Expects(blockSize > 0);
+    Expects(tolerance > 0);
+
+    // Lanczos bounds lie slightly inside the spectrum, while Chebyshev polynomials blow up outside [-1, 1]
+    double margin = SPECTRUM_MARGIN * (this->high - this->low);
+    this->a = (this->high - this->low) / 2 + margin;
+    this->b = (this->high + this->low) / 2;
+}
+
+arma::vec PolynomialFilteredEigensolver::randomVector(std::mt19937 &mt) const {
+    std::normal_distribution<double> normal;
+    arma::vec vector(this->hamiltonian.size());
+    for (auto &element : vector)
+        element = normal(mt);
+    return vector;
+}
+
+/**
+ * @brief Estimates Tr H / D and Tr H^2 / D using random +-1 vectors, which gives the mean and the standard deviation
+ * of energies.
+ */
+std::pair<double, double> PolynomialFilteredEigensolver::estimateEnergyMeanAndDeviation(std::mt19937 &mt) const {
+    std::size_t size = this->hamiltonian.size();
+    std::bernoulli_distribution coin;
+    arma::vec vector(size);
+    arma::vec hamiltonianTimesVector(size);
+    double trace{};
+    double squareTrace{};
+    for (std::size_t sample{}; sample < NUM_TRACE_SAMPLES; sample++) {
+        for (auto &element : vector)
+            element = coin(mt) ? 1 : -1;
+        this->hamiltonian.apply(vector, hamiltonianTimesVector);
+        trace += arma::dot(vector, hamiltonianTimesVector);
+        squareTrace += arma::dot(hamiltonianTimesVector, hamiltonianTimesVector);
+    }
+
+    double normalization = static_cast<double>(NUM_TRACE_SAMPLES * size);
+    double mean = trace / normalization;
+    double variance = squareTrace / normalization - mean * mean;
+    return {mean, std::sqrt(std::max(variance, 0.))};
+}
+
+/**
+ * @brief Chooses the order of the filter so that the width of its peak corresponds to the width of the energy window
+ * with @a numEigenpairs eigenvalues for the gaussian density of states.
+ */
+std::size_t PolynomialFilteredEigensolver::chooseFilterOrder(double targetEnergy, std::size_t numEigenpairs,
+                                                             std::mt19937 &mt) const
+{
+    auto [mean, deviation] = this->estimateEnergyMeanAndDeviation(mt);
+    if (deviation == 0)
+        return 1;
+
+    double size = static_cast<double>(this->hamiltonian.size());
+    double energyDensity = size * std::exp(-std::pow(targetEnergy - mean, 2) / (2 * deviation * deviation))
+                           / (std::sqrt(2 * M_PI) * deviation);
+    double windowHalfWidth = static_cast<double>(numEigenpairs) / (2 * energyDensity);
+
+    // Chebyshev expansion has uniform resolution in theta, where cos(theta) is the rescaled energy
+    double rescaledTarget = (targetEnergy - this->b) / this->a;
+    double thetaHalfWidth = windowHalfWidth / (this->a * std::sqrt(1 - rescaledTarget * rescaledTarget));
+    double order = std::ceil(M_PI / thetaHalfWidth);
+    if (!std::isfinite(order))
+        return 1;
+    return static_cast<std::size_t>(std::clamp(order, 1., static_cast<double>(MAX_FILTER_ORDER)));
+}
+
+/**
+ * @brief Coefficients c_k of the filter sum_k c_k T_k(x) approximating delta(x - target) with Jackson kernel, where
+ * x is the rescaled energy.
+ */
+std::vector<double> PolynomialFilteredEigensolver::calculateFilterCoefficients(double targetEnergy,
+                                                                               std::size_t order) const
+{
+    double rescaledTarget = (targetEnergy - this->b) / this->a;
+    double targetTheta = std::acos(rescaledTarget);
+    double phase = M_PI / static_cast<double>(order + 1);
+
+    std::vector<double> coefficients(order + 1);
+    for (std::size_t k{}; k <= order; k++) {
+        double kDouble = static_cast<double>(k);
+        double jacksonKernel = ((static_cast<double>(order) - kDouble + 1) * std::cos(phase * kDouble)
+                                + std::sin(phase * kDouble) / std::tan(phase))
+                               / static_cast<double>(order + 1);
+        double delta = (k == 0 ? 1 : 2) * std::cos(kDouble * targetTheta);
+        coefficients[k] = jacksonKernel * delta;
+    }
+    return coefficients;
+}
+
+/**
+ * @brief Acts with the filter on all columns of @a block using three-term recurrence of Chebyshev polynomials.
+ * @details As in ChebyshevEvolver, the hamiltonian is not rescaled explicitly - the rescaling is applied to the
+ * vectors after acting with it.
+ */
+arma::mat PolynomialFilteredEigensolver::applyFilter(const arma::mat &block,
+                                                     const std::vector<double> &coefficients) const
+{
+    arma::mat result(arma::size(block));
+    arma::vec hamiltonianTimesVector(block.n_rows);
+    for (std::size_t col{}; col < block.n_cols; col++) {
+        arma::vec previous = block.col(col);
+        arma::vec filtered = coefficients[0] * previous;
+        if (coefficients.size() == 1) {
+            result.col(col) = filtered;
+            continue;
+        }
+
+        this->hamiltonian.apply(previous, hamiltonianTimesVector);
+        arma::vec current = (hamiltonianTimesVector - this->b * previous) / this->a;
+        filtered += coefficients[1] * current;
+        for (std::size_t k = 2; k < coefficients.size(); k++) {
+            this->hamiltonian.apply(current, hamiltonianTimesVector);
+            arma::vec next = 2 * (hamiltonianTimesVector - this->b * current) / this->a - previous;
+            filtered += coefficients[k] * next;
+            previous = std::move(current);
+            current = std::move(next);
+        }
+        result.col(col) = filtered;
+    }
+    return result;
+}
+
+/**
+ * @brief Orthonormalizes @a block against all @a basis blocks and internally (Gram-Schmidt, twice for stability)
+ * and returns upper triangular R such that @a block before = @a block after * R, up to the components along
+ * @a basis.
+ * @details Linearly dependent columns are replaced by random vectors orthogonal to everything else, with zero rows
+ * in R.
+ */
+arma::mat PolynomialFilteredEigensolver::orthonormalizeBlock(arma::mat &block, const std::vector<arma::mat> &basis,
+                                                             std::mt19937 &mt) const
+{
+    auto orthogonalizeAgainstBasis = [&basis](arma::mat &vectors) {
+        for (std::size_t pass{}; pass < 2; pass++)
+            for (const auto &basisBlock : basis)
+                vectors -= basisBlock * (basisBlock.t() * vectors);
+    };
+
+    arma::rowvec initialNorms(block.n_cols);
+    for (std::size_t col{}; col < block.n_cols; col++)
+        initialNorms[col] = arma::norm(block.col(col));
+    orthogonalizeAgainstBasis(block);
+
+    arma::mat R(block.n_cols, block.n_cols, arma::fill::zeros);
+    for (std::size_t col{}; col < block.n_cols; col++) {
+        arma::vec vector = block.col(col);
+        for (std::size_t pass{}; pass < 2; pass++) {
+            for (std::size_t prevCol{}; prevCol < col; prevCol++) {
+                double projection = arma::dot(block.col(prevCol), vector);
+                R(prevCol, col) += projection;
+                vector -= projection * block.col(prevCol);
+            }
+        }
+
+        double norm = arma::norm(vector);
+        if (norm > DEFLATION_TOLERANCE * initialNorms[col] && norm > 0) {
+            R(col, col) = norm;
+            block.col(col) = vector / norm;
+            continue;
+        }
+
+        // Deflation - a random vector is used to keep the block size
+        arma::mat replacement = this->randomVector(mt);
+        orthogonalizeAgainstBasis(replacement);
+        for (std::size_t pass{}; pass < 2; pass++) {
+            for (std::size_t prevCol{}; prevCol < col; prevCol++)
+                replacement -= arma::dot(block.col(prevCol), replacement) * block.col(prevCol);
+        }
+        block.col(col) = arma::normalise(replacement);
+    }
+    return R;
+}
+
+std::pair<arma::vec, arma::mat> PolynomialFilteredEigensolver::calculateEigenpairs(double targetEnergy,
+                                                                                   std::size_t numEigenpairs) const
+{
+    std::size_t size = this->hamiltonian.size();
+    Expects(targetEnergy > this->low && targetEnergy < this->high);
+    Expects(numEigenpairs > 0);
+    Expects(numEigenpairs + this->blockSize <= size);
+
+    // Default seed - the results should be reproducible
+    std::mt19937 mt;
+    std::size_t order = this->chooseFilterOrder(targetEnergy, numEigenpairs, mt);
+    std::vector<double> coefficients = this->calculateFilterCoefficients(targetEnergy, order);
+
+    std::size_t p = this->blockSize;
+    std::size_t maxBlocks = std::min(size / p, (BASIS_SIZE_FACTOR * numEigenpairs) / p + 10);
+    std::size_t checkInterval = std::max<std::size_t>(1, numEigenpairs / (10 * p));
+
+    std::vector<arma::mat> basis;
+    std::vector<arma::mat> alphas;
+    std::vector<arma::mat> betas;
+    arma::mat block(size, p);
+    for (std::size_t col{}; col < p; col++)
+        block.col(col) = this->randomVector(mt);
+    static_cast<void>(this->orthonormalizeBlock(block, basis, mt));
+    basis.push_back(block);
+
+    arma::vec ritzValues;
+    arma::mat ritzVectors;
+    bool converged = false;
+    while (!converged) {
+        std::size_t j = basis.size() - 1;
+        arma::mat newBlock = this->applyFilter(basis[j], coefficients);
+        if (j > 0)
+            newBlock -= basis[j - 1] * betas[j - 1].t();
+        arma::mat alpha = basis[j].t() * newBlock;
+        alpha = (alpha + alpha.t()) / 2;
+        newBlock -= basis[j] * alpha;
+        alphas.push_back(alpha);
+        betas.push_back(this->orthonormalizeBlock(newBlock, basis, mt));
+
+        std::size_t numBlocks = basis.size();
+        bool isLastBlock = (numBlocks == maxBlocks);
+        if (numBlocks * p >= numEigenpairs + p && (numBlocks % checkInterval == 0 || isLastBlock)) {
+            // Block tridiagonal projection of the filtered hamiltonian onto the Krylov space
+            arma::mat T(numBlocks * p, numBlocks * p, arma::fill::zeros);
+            for (std::size_t i{}; i < numBlocks; i++) {
+                T.submat(i * p, i * p, (i + 1) * p - 1, (i + 1) * p - 1) = alphas[i];
+                if (i + 1 < numBlocks) {
+                    T.submat((i + 1) * p, i * p, (i + 2) * p - 1, (i + 1) * p - 1) = betas[i];
+                    T.submat(i * p, (i + 1) * p, (i + 1) * p - 1, (i + 2) * p - 1) = betas[i].t();
+                }
+            }
+            Assert(arma::eig_sym(ritzValues, ritzVectors, T));
+
+            // Residual of Ritz pair is || beta_last * (last block rows of Ritz vector) ||
+            double scale = arma::abs(ritzValues).max();
+            arma::mat lastRows = ritzVectors.rows((numBlocks - 1) * p, numBlocks * p - 1);
+            converged = true;
+            for (std::size_t i = ritzValues.size() - numEigenpairs; i < ritzValues.size(); i++) {
+                double residual = arma::norm(betas.back() * lastRows.col(i));
+                if (residual > this->tolerance * scale) {
+                    converged = false;
+                    break;
+                }
+            }
+        }
+
+        if (!converged) {
+            if (isLastBlock)
+                throw std::runtime_error("PolynomialFilteredEigensolver: Lanczos iteration did not converge");
+            basis.push_back(newBlock);
+        }
+    }
+
+    // Ritz vectors for the largest eigenvalues of the filtered hamiltonian
+    std::size_t firstRitzIdx = ritzValues.size() - numEigenpairs;
+    arma::mat eigenvectors(size, numEigenpairs, arma::fill::zeros);
+    for (std::size_t i{}; i < basis.size(); i++) {
+        eigenvectors += basis[i] * ritzVectors.submat(i * p, firstRitzIdx, (i + 1) * p - 1,
+                                                      ritzValues.size() - 1);
+    }
+
+    // Rayleigh-Ritz for the original hamiltonian in the found subspace
+    arma::mat hamiltonianTimesEigenvectors(size, numEigenpairs);
+    arma::vec hamiltonianTimesVector(size);
+    for (std::size_t i{}; i < numEigenpairs; i++) {
+        arma::vec eigenvector = eigenvectors.col(i);
+        this->hamiltonian.apply(eigenvector, hamiltonianTimesVector);
+        hamiltonianTimesEigenvectors.col(i) = hamiltonianTimesVector;
+    }
+    arma::mat projectedHamiltonian = eigenvectors.t() * hamiltonianTimesEigenvectors;
+    projectedHamiltonian = (projectedHamiltonian + projectedHamiltonian.t()) / 2;
+    arma::vec energies;
+    arma::mat rotation;
+    Assert(arma::eig_sym(energies, rotation, projectedHamiltonian));
+
+    return {energies, eigenvectors * rotation};
+}
@@ -0,0 +1,74 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#ifndef MBL_ED_POLYNOMIALFILTEREDEIGENSOLVER_H
+#define MBL_ED_POLYNOMIALFILTEREDEIGENSOLVER_H
+
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <armadillo>
+
+#include "HamiltonianOperator.h"
+
+/**
+ * @brief Sparse eigensolver finding eigenpairs from the middle of the spectrum using polynomial filtering (POLFED).
+ * @details The hamiltonian rescaled to [-1, 1] using the spectrum bounds is transformed by the Chebyshev expansion of
+ * the delta function centered at the target energy, damped with Jackson kernel. It preserves the eigenvectors, but
+ * the eigenvalues closest to the target become the largest ones, so they are found using block Lanczos iteration with
+ * full reorthogonalization. The energies are then recovered by Rayleigh-Ritz projection of the hamiltonian. The order
+ * of the expansion is chosen so that the requested number of eigenvalues fall within the peak of the filter, based on
+ * the gaussian density of states with stochastically estimated moments.
+ *
+ * Only products of the hamiltonian with vectors are used, so it works both with the sparse matrix and matrix-free
+ * hamiltonians.
+ */
+class PolynomialFilteredEigensolver {
+private:
+    static constexpr double SPECTRUM_MARGIN = 0.01;
+    static constexpr std::size_t NUM_TRACE_SAMPLES = 8;
+    static constexpr std::size_t MAX_FILTER_ORDER = 100000;
+    static constexpr std::size_t BASIS_SIZE_FACTOR = 6;
+    static constexpr double DEFLATION_TOLERANCE = 1e-12;
+
+    const HamiltonianOperator &hamiltonian;
+    double low{};
+    double high{};
+    double a{};
+    double b{};
+    std::size_t blockSize{};
+    double tolerance{};
+
+    [[nodiscard]] arma::vec randomVector(std::mt19937 &mt) const;
+    [[nodiscard]] std::pair<double, double> estimateEnergyMeanAndDeviation(std::mt19937 &mt) const;
+    [[nodiscard]] std::size_t chooseFilterOrder(double targetEnergy, std::size_t numEigenpairs,
+                                                std::mt19937 &mt) const;
+    [[nodiscard]] std::vector<double> calculateFilterCoefficients(double targetEnergy, std::size_t order) const;
+    [[nodiscard]] arma::mat applyFilter(const arma::mat &block, const std::vector<double> &coefficients) const;
+    [[nodiscard]] arma::mat orthonormalizeBlock(arma::mat &block, const std::vector<arma::mat> &basis,
+                                                std::mt19937 &mt) const;
+
+public:
+    /**
+     * @brief Prepares the solver for @a hamiltonian with the lowest and highest eigenvalues given by
+     * @a spectrumBounds (see HamiltonianOperator::findSpectrumBounds()).
+     * @details @a hamiltonian has to outlive the solver.
+     * @param blockSize the number of vectors in a block of Lanczos iteration. It should not be lower than the expected
+     * degeneracy of eigenvalues, for example 2 for momentum sectors +-k
+     * @param tolerance relative residual of eigenpairs of the filtered hamiltonian to deem them converged
+     */
+    PolynomialFilteredEigensolver(const HamiltonianOperator &hamiltonian, std::pair<double, double> spectrumBounds,
+                                  std::size_t blockSize = 4, double tolerance = 1e-10);
+
+    /**
+     * @brief Returns @a numEigenpairs subsequent eigenvalues closest to @a targetEnergy (in ascending order) together
+     * with corresponding normalized eigenvectors as columns of the matrix.
+     */
+    [[nodiscard]] std::pair<arma::vec, arma::mat> calculateEigenpairs(double targetEnergy,
+                                                                      std::size_t numEigenpairs) const;
+};
+
+
+#endif //MBL_ED_POLYNOMIALFILTEREDEIGENSOLVER_H
@@ -8,24 +8,19 @@
 
 #include "QuenchCalculator.h"
 
-void QuenchCalculator::addQuench(const arma::sp_mat &initialHamiltonian, const arma::sp_mat &finalHamiltonian) {
-    std::size_t numEigvals = std::min<std::size_t>(MIN_EIGVALS, initialHamiltonian.n_rows - 1);
+void QuenchCalculator::addQuench(const HamiltonianOperator &initialHamiltonian,
+                                 const HamiltonianOperator &finalHamiltonian)
+{
+    Expects(initialHamiltonian.size() == finalHamiltonian.size());
 
-    arma::vec initialMinEigvals;
-    arma::mat initialMinEigvecs;
-    Assert(arma::eigs_sym(initialMinEigvals, initialMinEigvecs, initialHamiltonian, numEigvals, "sa"));
-    this->lastQuenchedState = initialMinEigvecs.col(0);
+    this->lastQuenchedState = initialHamiltonian.findGroundState();
+    auto [Emin, Emax] = finalHamiltonian.findSpectrumBounds();
 
-    arma::vec finalMinEigvals;
-    arma::vec finalMaxEigvals;
-    Assert(arma::eigs_sym(finalMinEigvals, finalHamiltonian, numEigvals, "sa"));
-    Assert(arma::eigs_sym(finalMaxEigvals, finalHamiltonian, numEigvals, "la"));
-    double Emin = finalMinEigvals.front();
-    double Emax = finalMaxEigvals.back();
-
-    arma::vec hamiltonianTimesQuenchedState = finalHamiltonian * this->lastQuenchedState;
-    double quenchE = arma::as_scalar(this->lastQuenchedState.t() * hamiltonianTimesQuenchedState);
-    double quenchE2 = arma::as_scalar(this->lastQuenchedState.t() * finalHamiltonian * hamiltonianTimesQuenchedState);
+    // The hamiltonian is symmetric, so <psi|H^2|psi> = (H|psi>)^T H|psi>
+    arma::vec hamiltonianTimesQuenchedState;
+    finalHamiltonian.apply(this->lastQuenchedState, hamiltonianTimesQuenchedState);
+    double quenchE = arma::dot(this->lastQuenchedState, hamiltonianTimesQuenchedState);
+    double quenchE2 = arma::dot(hamiltonianTimesQuenchedState, hamiltonianTimesQuenchedState);
     double quenchEVariance = quenchE2 - quenchE * quenchE;
     // We just correct unmathematical negative values when it should be 0 originating from machine precision
     if (quenchEVariance < 0)
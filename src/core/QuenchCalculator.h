@@ -8,6 +8,7 @@
 #include <vector>
 #include <armadillo>
 
+#include "HamiltonianOperator.h"
 #include "simulation/Restorable.h"
 
 /**
@@ -18,8 +19,6 @@
  */
 class QuenchCalculator : public Restorable {
 private:
-    static constexpr std::size_t MIN_EIGVALS = 6;
-
     std::vector<double> quenchEpsilons;
     std::vector<double> quenchEpsilonVariances;
 
@@ -28,8 +27,9 @@ private:
 public:
     /**
      * @brief Adds another quench to ensemble.
+     * @details Hamiltonians are used only via HamiltonianOperator interface, so they can be also matrix-free.
      */
-    void addQuench(const arma::sp_mat &initialHamiltonian, const arma::sp_mat &finalHamiltonian);
+    void addQuench(const HamiltonianOperator &initialHamiltonian, const HamiltonianOperator &finalHamiltonian);
 
     /**
      * @brief Returns the ground state of initial Hamiltonian from last addQuench invocation.
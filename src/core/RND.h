@@ -6,31 +6,112 @@
 #define MBL_ED_RND_H
 
 #include <random>
+#include <array>
+#include <cstdint>
 
 /**
- * @brief A simple wrapper of Mersene Twister @a std::mt19937 generator.
+ * @brief A counter-based random number generator using Philox4x32-10 algorithm.
+ * @details <p> Random numbers are a pure function of the key (the seed) and the counter, which consists of the
+ * position in the stream, the stream id and the simulation (realisation) index. Thus, numbers for any realisation can
+ * be produced independently in O(1), without drawing numbers for all previous realisations, and the results do not
+ * depend on the order in which realisations are performed (or on the number of processes/threads performing them).
+ * <p> Stream id can be used to obtain independent generators for the same seed and simulation index. Generators
+ * sharing the seed, the stream id and the simulation index produce identical sequences.
  */
 class RND {
 private:
-    std::uniform_real_distribution<double> distribution;
-    std::mt19937 randomGenerator;
+    static constexpr std::uint32_t MULTIPLIER_0 = 0xD2511F53;
+    static constexpr std::uint32_t MULTIPLIER_1 = 0xCD9E8D57;
+    static constexpr std::uint32_t WEYL_0 = 0x9E3779B9;
+    static constexpr std::uint32_t WEYL_1 = 0xBB67AE85;
+
+    std::uint64_t key{};
+    std::uint32_t streamId{};
+    std::uint64_t simulationIndex{};
+    std::uint32_t blockIndex{};
+    std::array<std::uint32_t, 4> block{};
+    std::size_t numUsedInBlock = 2;
+
+    static void doPhiloxRound(std::array<std::uint32_t, 4> &counter, const std::array<std::uint32_t, 2> &roundKey) {
+        std::uint64_t product0 = static_cast<std::uint64_t>(MULTIPLIER_0) * counter[0];
+        std::uint64_t product1 = static_cast<std::uint64_t>(MULTIPLIER_1) * counter[2];
+        auto hi0 = static_cast<std::uint32_t>(product0 >> 32);
+        auto lo0 = static_cast<std::uint32_t>(product0);
+        auto hi1 = static_cast<std::uint32_t>(product1 >> 32);
+        auto lo1 = static_cast<std::uint32_t>(product1);
+        counter = {hi1 ^ counter[1] ^ roundKey[0], lo1, hi0 ^ counter[3] ^ roundKey[1], lo0};
+    }
+
+    void generateBlock() {
+        std::array<std::uint32_t, 4> counter = {this->blockIndex, this->streamId,
+                                                static_cast<std::uint32_t>(this->simulationIndex),
+                                                static_cast<std::uint32_t>(this->simulationIndex >> 32)};
+        std::array<std::uint32_t, 2> roundKey = {static_cast<std::uint32_t>(this->key),
+                                                 static_cast<std::uint32_t>(this->key >> 32)};
+        for (std::size_t round{}; round < 10; round++) {
+            if (round > 0) {
+                roundKey[0] += WEYL_0;
+                roundKey[1] += WEYL_1;
+            }
+            doPhiloxRound(counter, roundKey);
+        }
+        this->block = counter;
+        this->blockIndex++;
+        this->numUsedInBlock = 0;
+    }
+
+    void rewind() {
+        this->blockIndex = 0;
+        this->numUsedInBlock = 2;
+    }
 
 public:
-    RND() : randomGenerator(std::random_device{}()) { }
-    explicit RND(unsigned long seed) : randomGenerator(seed) { }
+    RND() : key(std::random_device{}()) { }
+
+    /**
+     * @brief Creates the generator for a given @a seed and @a streamId. Simulation index is initially 0.
+     */
+    explicit RND(unsigned long seed, std::uint32_t streamId = 0) : key(seed), streamId(streamId) { }
+
     virtual ~RND() = default;
 
     /**
      * @brief Returns random number from [0, 1) interval. Can be mocked.
+     * @details Each Philox block gives two numbers with 53 random bits each.
      */
-    virtual double getDouble() { return this->distribution(this->randomGenerator); }
+    virtual double getDouble() {
+        if (this->numUsedInBlock == 2)
+            this->generateBlock();
+        std::size_t first = 2 * this->numUsedInBlock++;
+        std::uint64_t bits = (static_cast<std::uint64_t>(this->block[first]) << 32) | this->block[first + 1];
+        return static_cast<double>(bits >> 11) * 0x1.0p-53;
+    }
 
     /**
      * @brief Returns random number from [0, 1) interval. Can be mocked by overriding getDouble().
      */
     double operator()() { return this->getDouble(); }
 
-    void seed(unsigned long seed) { this->randomGenerator.seed(seed); }
+    /**
+     * @brief Changes the seed and rewinds the stream to the beginning. Simulation index is reset to 0.
+     */
+    void seed(unsigned long seed) {
+        this->key = seed;
+        this->simulationIndex = 0;
+        this->rewind();
+    }
+
+    /**
+     * @brief Switches to the stream of numbers corresponding to the simulation (realisation) of index
+     * @a simulationIndex_, starting from its beginning.
+     */
+    void setSimulationIndex(std::size_t simulationIndex_) {
+        this->simulationIndex = simulationIndex_;
+        this->rewind();
+    }
+
+    [[nodiscard]] std::size_t getSimulationIndex() const { return this->simulationIndex; }
+    [[nodiscard]] std::uint32_t getStreamId() const { return this->streamId; }
 };
 
 
@@ -0,0 +1,115 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+#include "RangeEigensolver.h"
+#include "utils/Assertions.h"
+
+using arma::blas_int;
+
+// LAPACK routines which are not wrapped by Armadillo. The trailing arguments are hidden lengths of character
+// arguments, which are passed by Fortran compilers
+extern "C" {
+    void dsytrd_(const char *uplo, const blas_int *n, double *a, const blas_int *lda, double *d, double *e,
+                 double *tau, double *work, const blas_int *lwork, blas_int *info, std::size_t uploLen);
+
+    void dsterf_(const blas_int *n, double *d, double *e, blas_int *info);
+
+    void dstemr_(const char *jobz, const char *range, const blas_int *n, double *d, double *e, const double *vl,
+                 const double *vu, const blas_int *il, const blas_int *iu, blas_int *m, double *w, double *z,
+                 const blas_int *ldz, const blas_int *nzc, blas_int *isuppz, blas_int *tryrac, double *work,
+                 const blas_int *lwork, blas_int *iwork, const blas_int *liwork, blas_int *info,
+                 std::size_t jobzLen, std::size_t rangeLen);
+
+    void dormtr_(const char *side, const char *uplo, const char *trans, const blas_int *m, const blas_int *n,
+                 const double *a, const blas_int *lda, const double *tau, double *c, const blas_int *ldc,
+                 double *work, const blas_int *lwork, blas_int *info, std::size_t sideLen, std::size_t uploLen,
+                 std::size_t transLen);
+}
+
+RangeEigensolver::RangeEigensolver(arma::mat matrix) : reflectors{std::move(matrix)} {
+    Expects(this->reflectors.is_square());
+    Expects(!this->reflectors.empty());
+
+    auto n = static_cast<blas_int>(this->reflectors.n_rows);
+    this->diagonal.zeros(n);
+    // dstemr requires off-diagonal of the same length as the diagonal
+    this->offDiagonal.zeros(n);
+    this->tau.zeros(std::max<blas_int>(n - 1, 1));
+
+    blas_int info{};
+    blas_int lwork = -1;
+    double optimalLwork{};
+    dsytrd_("L", &n, this->reflectors.memptr(), &n, this->diagonal.memptr(), this->offDiagonal.memptr(),
+            this->tau.memptr(), &optimalLwork, &lwork, &info, 1);
+    Assert(info == 0);
+
+    lwork = static_cast<blas_int>(optimalLwork);
+    std::vector<double> work(lwork);
+    dsytrd_("L", &n, this->reflectors.memptr(), &n, this->diagonal.memptr(), this->offDiagonal.memptr(),
+            this->tau.memptr(), work.data(), &lwork, &info, 1);
+    Assert(info == 0);
+
+    // dsterf destroys the tridiagonal matrix, which is still needed for eigenvectors
+    this->eigenvalues = this->diagonal;
+    arma::vec offDiagonalCopy = this->offDiagonal;
+    dsterf_(&n, this->eigenvalues.memptr(), offDiagonalCopy.memptr(), &info);
+    Assert(info == 0);
+}
+
+arma::mat RangeEigensolver::calculateEigenvectors(std::size_t fromIdx, std::size_t toIdx) const {
+    Expects(fromIdx < toIdx);
+    Expects(toIdx <= this->size());
+
+    auto n = static_cast<blas_int>(this->size());
+    auto numVectors = static_cast<blas_int>(toIdx - fromIdx);
+    // LAPACK indices are 1-based and inclusive
+    auto il = static_cast<blas_int>(fromIdx + 1);
+    auto iu = static_cast<blas_int>(toIdx);
+    double vl{}, vu{};
+
+    arma::vec d = this->diagonal;
+    arma::vec e = this->offDiagonal;
+    arma::vec w(n);
+    arma::mat z(n, numVectors);
+    std::vector<blas_int> isuppz(2 * numVectors);
+    blas_int m{};
+    blas_int tryrac = 1;
+    blas_int info{};
+
+    blas_int lwork = -1;
+    blas_int liwork = -1;
+    double optimalLwork{};
+    blas_int optimalLiwork{};
+    dstemr_("V", "I", &n, d.memptr(), e.memptr(), &vl, &vu, &il, &iu, &m, w.memptr(), z.memptr(), &n, &numVectors,
+            isuppz.data(), &tryrac, &optimalLwork, &lwork, &optimalLiwork, &liwork, &info, 1, 1);
+    Assert(info == 0);
+
+    lwork = static_cast<blas_int>(optimalLwork);
+    liwork = optimalLiwork;
+    std::vector<double> work(lwork);
+    std::vector<blas_int> iwork(liwork);
+    tryrac = 1;
+    dstemr_("V", "I", &n, d.memptr(), e.memptr(), &vl, &vu, &il, &iu, &m, w.memptr(), z.memptr(), &n, &numVectors,
+            isuppz.data(), &tryrac, work.data(), &lwork, iwork.data(), &liwork, &info, 1, 1);
+    Assert(info == 0);
+    Assert(m == numVectors);
+
+    // Eigenvectors of the tridiagonal matrix -> eigenvectors of the original one
+    lwork = -1;
+    dormtr_("L", "L", "N", &n, &numVectors, this->reflectors.memptr(), &n, this->tau.memptr(), z.memptr(), &n,
+            &optimalLwork, &lwork, &info, 1, 1, 1);
+    Assert(info == 0);
+
+    lwork = static_cast<blas_int>(optimalLwork);
+    work.resize(lwork);
+    dormtr_("L", "L", "N", &n, &numVectors, this->reflectors.memptr(), &n, this->tau.memptr(), z.memptr(), &n,
+            work.data(), &lwork, &info, 1, 1, 1);
+    Assert(info == 0);
+
+    return z;
+}
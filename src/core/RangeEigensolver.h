@@ -0,0 +1,44 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#ifndef MBL_ED_RANGEEIGENSOLVER_H
+#define MBL_ED_RANGEEIGENSOLVER_H
+
+#include <armadillo>
+
+/**
+ * @brief Eigensolver for a real symmetric matrix calculating all eigenvalues, but eigenvectors only for a given range
+ * of indices.
+ * @details The matrix is reduced to the tridiagonal form only once (LAPACK dsytrd) in the constructor, together with
+ * calculating all eigenvalues from it (dsterf). The eigenvectors for a range are then calculated using MRRR algorithm
+ * (dstemr) and transformed back using the stored Householder reflectors (dormtr), so their cost is proportional to
+ * the number of them. On the contrary, @a arma::eig_sym always calculates all eigenvectors.
+ */
+class RangeEigensolver {
+private:
+    arma::mat reflectors;
+    arma::vec tau;
+    arma::vec diagonal;
+    arma::vec offDiagonal;
+    arma::vec eigenvalues;
+
+public:
+    explicit RangeEigensolver(arma::mat matrix);
+
+    [[nodiscard]] std::size_t size() const { return this->eigenvalues.size(); }
+
+    /**
+     * @brief Returns all eigenvalues in ascending order.
+     */
+    [[nodiscard]] const arma::vec &getEigenvalues() const { return this->eigenvalues; }
+
+    /**
+     * @brief Returns normalized eigenvectors for eigenvalues of indices from [@a fromIdx, @a toIdx) (in ascending
+     * order) as columns of the matrix.
+     */
+    [[nodiscard]] arma::mat calculateEigenvectors(std::size_t fromIdx, std::size_t toIdx) const;
+};
+
+
+#endif //MBL_ED_RANGEEIGENSOLVER_H
@@ -0,0 +1,75 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#include <algorithm>
+
+#include "SiteOccupations.h"
+#include "utils/Assertions.h"
+#include "utils/OMPMacros.h"
+
+namespace {
+    // 4096 doubles of partial results (32 kB) fit in L1 cache
+    constexpr std::size_t BLOCK_SIZE = 4096;
+
+    /**
+     * @brief Calls @a function(from, to) for consecutive blocks of [0, @a size) in OpenMP parallel loop.
+     */
+    template<typename Function>
+    void for_each_block(std::size_t size, Function function) {
+        std::size_t numBlocks = (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+        _OMP_PARALLEL_FOR
+        for (std::size_t blockIdx = 0; blockIdx < numBlocks; blockIdx++)
+            function(blockIdx * BLOCK_SIZE, std::min(size, (blockIdx + 1) * BLOCK_SIZE));
+    }
+}
+
+SiteOccupations::SiteOccupations(const FockBasis &fockBasis) : numberOfVectors{fockBasis.size()} {
+    Expects(fockBasis.size() > 0);
+    this->numberOfSites = fockBasis.getNumberOfSites();
+    this->occupations.resize(this->numberOfVectors * this->numberOfSites);
+
+    for (std::size_t vectorIdx{}; vectorIdx < this->numberOfVectors; vectorIdx++) {
+        auto vector = fockBasis[vectorIdx];
+        for (std::size_t siteIdx{}; siteIdx < this->numberOfSites; siteIdx++)
+            this->occupations[siteIdx * this->numberOfVectors + vectorIdx] = vector[siteIdx];
+    }
+    this->maxOccupation = *std::max_element(this->occupations.begin(), this->occupations.end());
+}
+
+const SiteOccupations::Occupation *SiteOccupations::getSite(std::size_t siteIdx) const {
+    Expects(siteIdx < this->numberOfSites);
+    return this->occupations.data() + siteIdx * this->numberOfVectors;
+}
+
+arma::vec SiteOccupations::calculateWeightedSum(const std::vector<double> &siteWeights) const {
+    Expects(siteWeights.size() == this->numberOfSites);
+
+    arma::vec result(this->numberOfVectors, arma::fill::zeros);
+    double *resultData = result.memptr();
+    for_each_block(this->numberOfVectors, [&](std::size_t from, std::size_t to) {
+        for (std::size_t siteIdx{}; siteIdx < this->numberOfSites; siteIdx++) {
+            const Occupation *siteOccupations = this->getSite(siteIdx);
+            double weight = siteWeights[siteIdx];
+            for (std::size_t vectorIdx = from; vectorIdx < to; vectorIdx++)
+                resultData[vectorIdx] += weight * siteOccupations[vectorIdx];
+        }
+    });
+    return result;
+}
+
+arma::vec SiteOccupations::calculateFunctionSum(const std::vector<double> &occupationFunction) const {
+    Expects(this->maxOccupation < occupationFunction.size());
+
+    arma::vec result(this->numberOfVectors, arma::fill::zeros);
+    double *resultData = result.memptr();
+    for_each_block(this->numberOfVectors, [&](std::size_t from, std::size_t to) {
+        for (std::size_t siteIdx{}; siteIdx < this->numberOfSites; siteIdx++) {
+            const Occupation *siteOccupations = this->getSite(siteIdx);
+            for (std::size_t vectorIdx = from; vectorIdx < to; vectorIdx++)
+                resultData[vectorIdx] += occupationFunction[siteOccupations[vectorIdx]];
+        }
+    });
+    return result;
+}
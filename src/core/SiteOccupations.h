@@ -0,0 +1,58 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#ifndef MBL_ED_SITEOCCUPATIONS_H
+#define MBL_ED_SITEOCCUPATIONS_H
+
+#include <vector>
+
+#include <armadillo>
+
+#include "FockBasis.h"
+
+/**
+ * @brief Occupations of all vectors of FockBasis in the structure-of-arrays layout, used to evaluate DiagonalTerm -s
+ * for the whole basis at once.
+ * @details Occupations of a given site for all vectors are stored contiguously, so the loops over basis vectors are
+ * simple, branchless and can be vectorized by the compiler. The basis is processed in blocks small enough for the
+ * partial results to stay in cache, and the blocks are distributed between OpenMP threads.
+ */
+class SiteOccupations {
+public:
+    using Occupation = FockBasis::VectorView::Occupation;
+
+private:
+    std::size_t numberOfVectors{};
+    std::size_t numberOfSites{};
+    std::size_t maxOccupation{};
+    std::vector<Occupation> occupations;
+
+public:
+    explicit SiteOccupations(const FockBasis &fockBasis);
+
+    [[nodiscard]] std::size_t size() const { return this->numberOfVectors; }
+    [[nodiscard]] std::size_t getNumberOfSites() const { return this->numberOfSites; }
+    [[nodiscard]] std::size_t getMaxOccupation() const { return this->maxOccupation; }
+
+    /**
+     * @brief Returns the pointer to occupations of site @a siteIdx for all vectors.
+     */
+    [[nodiscard]] const Occupation *getSite(std::size_t siteIdx) const;
+
+    /**
+     * @brief Returns \f$ \sum_i w_i n_i \f$ for all vectors, where \f$ w_i \f$ = @a siteWeights[i] and
+     * \f$ n_i \f$ is the occupation of site i.
+     */
+    [[nodiscard]] arma::vec calculateWeightedSum(const std::vector<double> &siteWeights) const;
+
+    /**
+     * @brief Returns \f$ \sum_i f(n_i) \f$ for all vectors, where \f$ f(n) \f$ = @a occupationFunction[n] and
+     * \f$ n_i \f$ is the occupation of site i.
+     * @details @a occupationFunction has to be tabulated at least up to getMaxOccupation().
+     */
+    [[nodiscard]] arma::vec calculateFunctionSum(const std::vector<double> &occupationFunction) const;
+};
+
+
+#endif //MBL_ED_SITEOCCUPATIONS_H
@@ -0,0 +1,115 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#include <array>
+#include <algorithm>
+
+#include "SparseHamiltonianOperator.h"
+#include "utils/Assertions.h"
+#include "utils/OMPMacros.h"
+
+namespace {
+    /**
+     * @brief Computes @a result = @a matrix * @a vector using CSR matrix * dense vector multiplication scheme.
+     * @details We just steal sparse matrix data from Armadillo's matrix. Note, that it uses CSC format and we
+     * interpret it as CSR, but it's ok since the matrix is symmetric
+     * details: https://en.wikipedia.org/wiki/Sparse_matrix#Compressed_sparse_row_(CSR,_CRS_or_Yale_format)
+     */
+    template<typename Vector>
+    void symmetric_sp_mat_times_vec(const arma::sp_mat &matrix, const Vector &vector, Vector &result) {
+        using Scalar = typename Vector::elem_type;
+
+        const double *matrixData = matrix.values;
+        const arma::uword *matrixColIdx = matrix.row_indices;
+        const arma::uword *matrixRowPtr = matrix.col_ptrs;
+
+        result.set_size(matrix.n_rows);
+
+        _OMP_PARALLEL_FOR
+        for (std::size_t elementIdx = 0; elementIdx < matrix.n_rows; elementIdx++) {
+            Scalar Ax_i{};
+            for (std::size_t dataIdx = matrixRowPtr[elementIdx]; dataIdx < matrixRowPtr[elementIdx + 1]; dataIdx++)
+                Ax_i += matrixData[dataIdx] * vector[matrixColIdx[dataIdx]];
+            result[elementIdx] = Ax_i;
+        }
+    }
+
+    /**
+     * @brief Computes @a result = @a matrix * @a block using the same scheme as symmetric_sp_mat_times_vec().
+     * @details Columns are processed in groups of at most BLOCK_GROUP_SIZE, so that row accumulators for the whole
+     * group stay in registers and the matrix data is traversed once per group.
+     */
+    template<typename Matrix>
+    void symmetric_sp_mat_times_block(const arma::sp_mat &matrix, const Matrix &block, Matrix &result) {
+        using Scalar = typename Matrix::elem_type;
+        constexpr std::size_t BLOCK_GROUP_SIZE = 8;
+
+        const double *matrixData = matrix.values;
+        const arma::uword *matrixColIdx = matrix.row_indices;
+        const arma::uword *matrixRowPtr = matrix.col_ptrs;
+        std::size_t numRows = matrix.n_rows;
+
+        result.set_size(numRows, block.n_cols);
+
+        for (std::size_t groupStart = 0; groupStart < block.n_cols; groupStart += BLOCK_GROUP_SIZE) {
+            std::size_t groupSize = std::min<std::size_t>(BLOCK_GROUP_SIZE, block.n_cols - groupStart);
+            const Scalar *blockData = block.colptr(groupStart);
+            Scalar *resultData = result.colptr(groupStart);
+
+            _OMP_PARALLEL_FOR
+            for (std::size_t elementIdx = 0; elementIdx < numRows; elementIdx++) {
+                std::array<Scalar, BLOCK_GROUP_SIZE> Ax_i{};
+                std::size_t rowEnd = matrixRowPtr[elementIdx + 1];
+                for (std::size_t dataIdx = matrixRowPtr[elementIdx]; dataIdx < rowEnd; dataIdx++) {
+                    double element = matrixData[dataIdx];
+                    const Scalar *blockRow = blockData + matrixColIdx[dataIdx];
+                    for (std::size_t colIdx = 0; colIdx < groupSize; colIdx++)
+                        Ax_i[colIdx] += element * blockRow[colIdx * numRows];
+                }
+                for (std::size_t colIdx = 0; colIdx < groupSize; colIdx++)
+                    resultData[elementIdx + colIdx * numRows] = Ax_i[colIdx];
+            }
+        }
+    }
+}
+
+SparseHamiltonianOperator::SparseHamiltonianOperator(arma::sp_mat hamiltonian) : hamiltonian{std::move(hamiltonian)} {
+    Expects(this->hamiltonian.is_square());
+}
+
+void SparseHamiltonianOperator::apply(const arma::vec &vector, arma::vec &result) const {
+    Expects(vector.size() == this->size());
+    symmetric_sp_mat_times_vec(this->hamiltonian, vector, result);
+}
+
+void SparseHamiltonianOperator::apply(const arma::cx_vec &vector, arma::cx_vec &result) const {
+    Expects(vector.size() == this->size());
+    symmetric_sp_mat_times_vec(this->hamiltonian, vector, result);
+}
+
+void SparseHamiltonianOperator::applyToBlock(const arma::cx_mat &vectors, arma::cx_mat &result) const {
+    Expects(vectors.n_rows == this->size());
+    symmetric_sp_mat_times_block(this->hamiltonian, vectors, result);
+}
+
+void SparseHamiltonianOperator::applyToBlock(const arma::mat &vectors, arma::mat &result) const {
+    Expects(vectors.n_rows == this->size());
+    symmetric_sp_mat_times_block(this->hamiltonian, vectors, result);
+}
+
+std::pair<double, double> SparseHamiltonianOperator::findSpectrumBounds() const {
+    std::size_t numEigvals = std::min<std::size_t>(MIN_EIGVALS_FOR_BOUNDS, this->size() - 1);
+    arma::vec minEigval, maxEigval;
+    Assert(arma::eigs_sym(minEigval, this->hamiltonian, numEigvals, "sa"));
+    Assert(arma::eigs_sym(maxEigval, this->hamiltonian, numEigvals, "la"));
+    return {minEigval.front(), maxEigval.back()};
+}
+
+arma::vec SparseHamiltonianOperator::findGroundState() const {
+    std::size_t numEigvals = std::min<std::size_t>(MIN_EIGVALS_FOR_GROUND_STATE, this->size() - 1);
+    arma::vec minEigvals;
+    arma::mat minEigvecs;
+    Assert(arma::eigs_sym(minEigvals, minEigvecs, this->hamiltonian, numEigvals, "sa"));
+    return minEigvecs.col(0);
+}
@@ -0,0 +1,59 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#ifndef MBL_ED_SPARSEHAMILTONIANOPERATOR_H
+#define MBL_ED_SPARSEHAMILTONIANOPERATOR_H
+
+#include <armadillo>
+
+#include "HamiltonianOperator.h"
+
+/**
+ * @brief HamiltonianOperator storing the hamiltonian as a sparse matrix.
+ * @details Spectrum bounds and the ground state are found using Armadillo's sparse eigensolver.
+ */
+class SparseHamiltonianOperator : public HamiltonianOperator {
+private:
+    static constexpr std::size_t MIN_EIGVALS_FOR_BOUNDS = 20;
+    static constexpr std::size_t MIN_EIGVALS_FOR_GROUND_STATE = 6;
+
+    arma::sp_mat hamiltonian;
+
+public:
+    explicit SparseHamiltonianOperator(arma::sp_mat hamiltonian);
+
+    [[nodiscard]] std::size_t size() const override { return this->hamiltonian.n_rows; }
+
+    /**
+     * @brief Computes @a result = H @a vector.
+     * @details It uses custom sparse matrix - dense vector multiplication, since this from Armadillo is lame.
+     */
+    void apply(const arma::vec &vector, arma::vec &result) const override;
+
+    /**
+     * @brief Computes @a result = H @a vector.
+     * @details It uses custom sparse matrix - dense vector multiplication, since this from Armadillo is lame.
+     */
+    void apply(const arma::cx_vec &vector, arma::cx_vec &result) const override;
+
+    /**
+     * @brief Computes @a result = H @a vectors.
+     * @details Each matrix element is read once and multiplied by the whole row of the block, which for a few
+     * columns is much cheaper than separate products, since they are limited by memory bandwidth.
+     */
+    void applyToBlock(const arma::cx_mat &vectors, arma::cx_mat &result) const override;
+
+    /**
+     * @brief Computes @a result = H @a vectors, in the same way as the complex version.
+     */
+    void applyToBlock(const arma::mat &vectors, arma::mat &result) const override;
+
+    [[nodiscard]] std::pair<double, double> findSpectrumBounds() const override;
+    [[nodiscard]] arma::vec findGroundState() const override;
+
+    [[nodiscard]] const arma::sp_mat &getMatrix() const { return this->hamiltonian; }
+};
+
+
+#endif //MBL_ED_SPARSEHAMILTONIANOPERATOR_H
@@ -0,0 +1,248 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#include <cmath>
+#include <complex>
+#include <numeric>
+
+#include "SymmetrySectors.h"
+#include "utils/Assertions.h"
+
+using namespace std::complex_literals;
+
+namespace {
+    constexpr double SYMMETRY_TOLERANCE = 1e-12;
+}
+
+SymmetrySectors::SymmetrySectors(std::shared_ptr<const FockBasis> fockBasis,
+                                 const std::vector<std::size_t> &sitePermutation)
+        : fockBasis{std::move(fockBasis)}
+{
+    Expects(this->fockBasis != nullptr);
+    Expects(this->fockBasis->size() > 0);
+    std::size_t numberOfSites = this->fockBasis->getNumberOfSites();
+    Expects(sitePermutation.size() == numberOfSites);
+    std::vector<bool> siteUsed(numberOfSites);
+    for (std::size_t site : sitePermutation) {
+        Expects(site < numberOfSites);
+        Expects(!siteUsed[site]);
+        siteUsed[site] = true;
+    }
+
+    // The order of the permutation is the least common multiple of the lengths of its cycles
+    this->order = 1;
+    std::vector<bool> siteVisited(numberOfSites);
+    for (std::size_t site{}; site < numberOfSites; site++) {
+        std::size_t cycleLength{};
+        for (std::size_t cycleSite = site; !siteVisited[cycleSite]; cycleSite = sitePermutation[cycleSite]) {
+            siteVisited[cycleSite] = true;
+            cycleLength++;
+        }
+        if (cycleLength > 0)
+            this->order = std::lcm(this->order, cycleLength);
+    }
+
+    const auto &basis = *this->fockBasis;
+    this->images.resize(basis.size());
+    FockBasis::Vector image(numberOfSites);
+    for (std::size_t vectorIdx{}; vectorIdx < basis.size(); vectorIdx++) {
+        for (std::size_t site{}; site < numberOfSites; site++)
+            image[sitePermutation[site]] = basis[vectorIdx][site];
+        auto imageIdx = basis.findIndex(image);
+        Expects(imageIdx.has_value());
+        this->images[vectorIdx] = *imageIdx;
+    }
+
+    std::vector<bool> vectorVisited(basis.size());
+    this->orbitIdxs.resize(basis.size());
+    this->shifts.resize(basis.size());
+    for (std::size_t vectorIdx{}; vectorIdx < basis.size(); vectorIdx++) {
+        if (vectorVisited[vectorIdx])
+            continue;
+
+        std::size_t orbitIdx = this->representatives.size();
+        std::size_t shift{};
+        std::size_t orbitVectorIdx = vectorIdx;
+        do {
+            vectorVisited[orbitVectorIdx] = true;
+            this->orbitIdxs[orbitVectorIdx] = orbitIdx;
+            this->shifts[orbitVectorIdx] = shift++;
+            orbitVectorIdx = this->images[orbitVectorIdx];
+        } while (orbitVectorIdx != vectorIdx);
+        this->representatives.push_back(vectorIdx);
+        this->periods.push_back(shift);
+    }
+}
+
+SymmetrySectors SymmetrySectors::translation(std::shared_ptr<const FockBasis> fockBasis) {
+    Expects(fockBasis != nullptr);
+    std::size_t numberOfSites = fockBasis->getNumberOfSites();
+    std::vector<std::size_t> sitePermutation(numberOfSites);
+    for (std::size_t site{}; site < numberOfSites; site++)
+        sitePermutation[site] = (site + 1) % numberOfSites;
+    return SymmetrySectors(std::move(fockBasis), sitePermutation);
+}
+
+SymmetrySectors SymmetrySectors::reflection(std::shared_ptr<const FockBasis> fockBasis) {
+    Expects(fockBasis != nullptr);
+    std::size_t numberOfSites = fockBasis->getNumberOfSites();
+    std::vector<std::size_t> sitePermutation(numberOfSites);
+    for (std::size_t site{}; site < numberOfSites; site++)
+        sitePermutation[site] = numberOfSites - 1 - site;
+    return SymmetrySectors(std::move(fockBasis), sitePermutation);
+}
+
+double SymmetrySectors::getMomentum(std::size_t m) const {
+    return 2 * M_PI * static_cast<double>(m) / static_cast<double>(this->order);
+}
+
+SymmetrySectors::Sector SymmetrySectors::getSector(std::size_t m) const {
+    Expects(m < this->order);
+
+    Sector sector;
+    sector.m = m;
+    sector.blockIdxs.resize(this->representatives.size());
+    for (std::size_t orbitIdx{}; orbitIdx < this->representatives.size(); orbitIdx++) {
+        // The symmetrized state exists only if exp(i k p) = 1
+        if ((m * this->periods[orbitIdx]) % this->order != 0)
+            continue;
+        sector.blockIdxs[orbitIdx] = sector.orbits.size();
+        sector.orbits.push_back(orbitIdx);
+    }
+    return sector;
+}
+
+std::size_t SymmetrySectors::getSectorSize(std::size_t m) const {
+    return this->getSector(m).orbits.size();
+}
+
+bool SymmetrySectors::isSymmetric(const arma::sp_mat &hamiltonian) const {
+    Expects(hamiltonian.n_rows == this->fockBasis->size());
+    Expects(hamiltonian.n_cols == this->fockBasis->size());
+
+    double maxAbsElement{};
+    for (auto it = hamiltonian.begin(); it != hamiltonian.end(); ++it)
+        maxAbsElement = std::max(maxAbsElement, std::abs(*it));
+    double tolerance = SYMMETRY_TOLERANCE * std::max(maxAbsElement, 1.);
+
+    // Permutation is a bijection, so it is enough to check that non-zero elements are mapped onto equal ones
+    for (auto it = hamiltonian.begin(); it != hamiltonian.end(); ++it) {
+        double permutedElement = hamiltonian(this->images[it.row()], this->images[it.col()]);
+        if (std::abs(permutedElement - *it) > tolerance)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Builds hamiltonian block for @a sector using <r', k|H|r, k> = sqrt(p_r'/p_r) sum_j exp(-ikj) <r'|H g^j|r>
+ */
+arma::cx_mat SymmetrySectors::buildBlock(const arma::sp_mat &hamiltonian, const Sector &sector) const {
+    double k = this->getMomentum(sector.m);
+    std::size_t blockSize = sector.orbits.size();
+    arma::cx_mat block(blockSize, blockSize, arma::fill::zeros);
+
+    for (std::size_t rowIdx{}; rowIdx < blockSize; rowIdx++) {
+        std::size_t rowOrbitIdx = sector.orbits[rowIdx];
+        std::size_t representative = this->representatives[rowOrbitIdx];
+
+        // Matrix is symmetric, so the column of the representative (CSC format) gives its row
+        for (auto it = hamiltonian.begin_col(representative); it != hamiltonian.end_col(representative); ++it) {
+            std::size_t vectorIdx = it.row();
+            std::size_t orbitIdx = this->orbitIdxs[vectorIdx];
+            auto colIdx = sector.blockIdxs[orbitIdx];
+            if (!colIdx.has_value())
+                continue;
+
+            double normalization = std::sqrt(static_cast<double>(this->periods[rowOrbitIdx])
+                                             / static_cast<double>(this->periods[orbitIdx]));
+            std::complex<double> phase = std::exp(-1i * k * static_cast<double>(this->shifts[vectorIdx]));
+            block(rowIdx, *colIdx) += normalization * phase * (*it);
+        }
+    }
+    return block;
+}
+
+arma::cx_vec SymmetrySectors::toFullBasis(const arma::cx_vec &sectorVector, const Sector &sector) const {
+    double k = this->getMomentum(sector.m);
+    arma::cx_vec fullVector(this->fockBasis->size(), arma::fill::zeros);
+    for (std::size_t vectorIdx{}; vectorIdx < fullVector.size(); vectorIdx++) {
+        std::size_t orbitIdx = this->orbitIdxs[vectorIdx];
+        auto blockIdx = sector.blockIdxs[orbitIdx];
+        if (!blockIdx.has_value())
+            continue;
+
+        std::complex<double> phase = std::exp(-1i * k * static_cast<double>(this->shifts[vectorIdx]));
+        fullVector[vectorIdx] = sectorVector[*blockIdx] * phase
+                                / std::sqrt(static_cast<double>(this->periods[orbitIdx]));
+    }
+    return fullVector;
+}
+
+Eigensystem SymmetrySectors::calculateEigensystem(const arma::sp_mat &hamiltonian, bool calculateEigenvectors) const {
+    std::size_t size = this->fockBasis->size();
+    Expects(hamiltonian.n_rows == size);
+    Expects(hamiltonian.n_cols == size);
+
+    arma::vec energies(size);
+    arma::mat eigenvectors;
+    if (calculateEigenvectors)
+        eigenvectors.set_size(size, size);
+    std::size_t eigenIdx{};
+
+    // Sectors m and order - m are complex conjugates, so only m <= order/2 are diagonalized
+    for (std::size_t m{}; 2 * m <= this->order; m++) {
+        Sector sector = this->getSector(m);
+        if (sector.orbits.empty())
+            continue;
+
+        arma::cx_mat block = this->buildBlock(hamiltonian, sector);
+        bool isRealSector = (m == 0 || 2 * m == this->order);
+        arma::vec blockEnergies;
+        if (isRealSector) {
+            arma::mat realBlock = arma::real(block);
+            if (!calculateEigenvectors) {
+                Assert(arma::eig_sym(blockEnergies, realBlock));
+                for (double energy : blockEnergies)
+                    energies[eigenIdx++] = energy;
+                continue;
+            }
+
+            arma::mat blockEigenvectors;
+            Assert(arma::eig_sym(blockEnergies, blockEigenvectors, realBlock));
+            for (std::size_t i{}; i < blockEnergies.size(); i++) {
+                arma::cx_vec sectorVector = arma::conv_to<arma::cx_vec>::from(blockEigenvectors.col(i));
+                eigenvectors.col(eigenIdx) = arma::real(this->toFullBasis(sectorVector, sector));
+                energies[eigenIdx++] = blockEnergies[i];
+            }
+        } else {
+            if (!calculateEigenvectors) {
+                Assert(arma::eig_sym(blockEnergies, block));
+                for (double energy : blockEnergies) {
+                    energies[eigenIdx++] = energy;
+                    energies[eigenIdx++] = energy;
+                }
+                continue;
+            }
+
+            // Real and imaginary parts of |psi> are orthogonal, since |psi> and its conjugate are from different
+            // sectors
+            arma::cx_mat blockEigenvectors;
+            Assert(arma::eig_sym(blockEnergies, blockEigenvectors, block));
+            for (std::size_t i{}; i < blockEnergies.size(); i++) {
+                arma::cx_vec fullVector = this->toFullBasis(blockEigenvectors.col(i), sector);
+                eigenvectors.col(eigenIdx) = M_SQRT2 * arma::real(fullVector);
+                energies[eigenIdx++] = blockEnergies[i];
+                eigenvectors.col(eigenIdx) = M_SQRT2 * arma::imag(fullVector);
+                energies[eigenIdx++] = blockEnergies[i];
+            }
+        }
+    }
+    Assert(eigenIdx == size);
+
+    if (calculateEigenvectors)
+        return Eigensystem(energies, eigenvectors, this->fockBasis);
+    else
+        return Eigensystem(energies, this->fockBasis);
+}
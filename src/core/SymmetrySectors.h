@@ -0,0 +1,99 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#ifndef MBL_ED_SYMMETRYSECTORS_H
+#define MBL_ED_SYMMETRYSECTORS_H
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <armadillo>
+
+#include "FockBasis.h"
+#include "Eigensystem.h"
+
+/**
+ * @brief Decomposition of FockBasis into sectors of a cyclic symmetry generated by a permutation of sites, for example
+ * translation for periodic boundary conditions or spatial reflection.
+ * @details <p> The permutation \f$ \hat{g} \f$ of order \f$ n \f$ splits the basis into orbits. For each orbit a
+ * representative \f$ |r\rangle \f$ (the vector of the lowest index) is chosen and for each sector
+ * \f$ k = 2\pi m/n \f$, \f$ m = 0, \ldots, n-1 \f$, the symmetrized state is
+ * \f[ |r, k\rangle = \frac{1}{\sqrt{p_r}} \sum_{j=0}^{p_r-1} e^{-ikj} \hat{g}^j |r\rangle, \f]
+ * where \f$ p_r \f$ is the size of the orbit. The state exists only if \f$ e^{ikp_r} = 1 \f$.
+ * <p> If the hamiltonian commutes with \f$ \hat{g} \f$, it is block-diagonal in those states, so each block can be
+ * diagonalized separately. Since the hamiltonian is real, the blocks for \f$ k \f$ and \f$ -k \f$ are complex
+ * conjugates. Thus, only \f$ m \le n/2 \f$ are diagonalized and for \f$ 0 < m < n/2 \f$ each complex eigenvector
+ * \f$ |\psi\rangle \f$ gives two real eigenvectors \f$ \sqrt{2}\,\text{Re}|\psi\rangle \f$ and
+ * \f$ \sqrt{2}\,\text{Im}|\psi\rangle \f$ of the full hamiltonian.
+ */
+class SymmetrySectors {
+private:
+    /**
+     * @brief Orbits, which have a symmetrized state in the sector of a given @a m.
+     */
+    struct Sector {
+        std::size_t m{};
+        std::vector<std::size_t> orbits;
+        std::vector<std::optional<std::size_t>> blockIdxs;  // index of an orbit in the block, for all orbits
+    };
+
+    std::shared_ptr<const FockBasis> fockBasis;
+    std::size_t order{};
+
+    // For each basis vector: index of the vector after the permutation, its orbit and the number of permutations
+    // needed to reach it from the representative of the orbit
+    std::vector<std::size_t> images;
+    std::vector<std::size_t> orbitIdxs;
+    std::vector<std::size_t> shifts;
+
+    std::vector<std::size_t> representatives;
+    std::vector<std::size_t> periods;
+
+    [[nodiscard]] Sector getSector(std::size_t m) const;
+    [[nodiscard]] double getMomentum(std::size_t m) const;
+    [[nodiscard]] arma::cx_mat buildBlock(const arma::sp_mat &hamiltonian, const Sector &sector) const;
+    [[nodiscard]] arma::cx_vec toFullBasis(const arma::cx_vec &sectorVector, const Sector &sector) const;
+
+public:
+    /**
+     * @brief Prepares the orbits of the permutation of sites, which sends site @a i to @a sitePermutation[i].
+     */
+    SymmetrySectors(std::shared_ptr<const FockBasis> fockBasis, const std::vector<std::size_t> &sitePermutation);
+
+    /**
+     * @brief Translation by one site, which is a symmetry for periodic boundary conditions.
+     */
+    static SymmetrySectors translation(std::shared_ptr<const FockBasis> fockBasis);
+
+    /**
+     * @brief Reflection of sites around the middle of the chain. It has order 2, so the sectors are even (@a m = 0)
+     * and odd (@a m = 1) states, both real.
+     */
+    static SymmetrySectors reflection(std::shared_ptr<const FockBasis> fockBasis);
+
+    /**
+     * @brief Returns the order of the permutation, which is the number of sectors.
+     */
+    [[nodiscard]] std::size_t getNumberOfSectors() const { return this->order; }
+
+    /**
+     * @brief Returns the dimension of sector @a m, corresponding to \f$ k = 2\pi m/n \f$.
+     */
+    [[nodiscard]] std::size_t getSectorSize(std::size_t m) const;
+
+    /**
+     * @brief Checks if @a hamiltonian commutes with the permutation, up to a small numerical tolerance.
+     */
+    [[nodiscard]] bool isSymmetric(const arma::sp_mat &hamiltonian) const;
+
+    /**
+     * @brief Diagonalizes symmetric @a hamiltonian sector by sector.
+     * @details If @a calculateEigenvectors is true, the eigenvectors are real and given in the full basis.
+     */
+    [[nodiscard]] Eigensystem calculateEigensystem(const arma::sp_mat &hamiltonian, bool calculateEigenvectors) const;
+};
+
+
+#endif //MBL_ED_SYMMETRYSECTORS_H
@@ -2,6 +2,8 @@
 // Created by pkua on 08.06.2020.
 //
 
+#include <type_traits>
+
 #include "CavityConstantsAveragingModel.h"
 #include "core/HamiltonianGenerator.h"
 #include "core/RND.h"
@@ -17,36 +19,14 @@ void CavityConstantsAveragingModel::setupHamiltonianGenerator(HamiltonianGenerat
     Expects(numberOfSimulations > 0);
     Expects(simulationIndex < numberOfSimulations);
 
-    bool termFound{};
-    for (auto &diagonalTerm : hamiltonianGenerator.getDiagonalTerms()) {
-        try {
-            auto &lookupCavityZ2 = dynamic_cast<LookupCavityZ2&>(*diagonalTerm);
-            lookupCavityZ2.changeRealisation(simulationIndex);
-            termFound = true;
-        } catch (std::bad_cast &e) { static_cast<void>(e); }
-
-        try {
-            auto &onsiteDisorder = dynamic_cast<OnsiteDisorder&>(*diagonalTerm);
-            onsiteDisorder.resampleOnsiteEnergies(rnd);
-            termFound = true;
-        } catch (std::bad_cast &e) { static_cast<void>(e); }
-    }
-
-    for (auto &hoppingTerm : hamiltonianGenerator.getHoppingTerms()) {
-        try {
-            auto &lookupCavityYZ = dynamic_cast<LookupCavityYZ&>(*hoppingTerm);
-            lookupCavityYZ.changeRealisation(simulationIndex);
-            termFound = true;
-        } catch (std::bad_cast &e) { static_cast<void>(e); }
-    }
-
-    for (auto &doubleHoppingTerm : hamiltonianGenerator.getDoubleHoppingTerms()) {
-        try {
-            auto &lookupCavityY2 = dynamic_cast<LookupCavityY2&>(*doubleHoppingTerm);
-            lookupCavityY2.changeRealisation(simulationIndex);
-            termFound = true;
-        } catch (std::bad_cast &e) { static_cast<void>(e); }
-    }
+    bool termFound = hamiltonianGenerator.visitTerms<LookupCavityZ2, OnsiteDisorder, LookupCavityYZ, LookupCavityY2>(
+        [&rnd, simulationIndex](auto &term) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(term)>, OnsiteDisorder>)
+                term.resampleOnsiteEnergies(rnd);
+            else
+                term.changeRealisation(simulationIndex);
+        }
+    );
 
     if (!termFound)
         throw std::runtime_error("CavityConstantsAveragingModel: lack of any term to average on");
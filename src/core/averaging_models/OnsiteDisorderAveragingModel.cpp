@@ -14,14 +14,9 @@ void OnsiteDisorderAveragingModel::setupHamiltonianGenerator(HamiltonianGenerato
     static_cast<void>(simulationIndex);
     static_cast<void>(numberOfSimulations);
 
-    bool changed{};
-    for (auto &diagonalTerm : hamiltonianGenerator.getDiagonalTerms()) {
-        try {
-            auto &onsiteDisorder = dynamic_cast<OnsiteDisorder&>(*diagonalTerm);
-            onsiteDisorder.resampleOnsiteEnergies(rnd);
-            changed = true;
-        } catch (std::bad_cast &e) { static_cast<void>(e); }
-    }
+    bool changed = hamiltonianGenerator.visitTerms<OnsiteDisorder>([&rnd](OnsiteDisorder &onsiteDisorder) {
+        onsiteDisorder.resampleOnsiteEnergies(rnd);
+    });
 
     if (!changed)
         throw std::runtime_error("OnsiteDisorderAveragingModel: lack of any term to average on");
@@ -2,6 +2,8 @@
 // Created by pkua on 08.06.2020.
 //
 
+#include <type_traits>
+
 #include "RandomPhi0AveragingModel.h"
 
 void RandomPhi0AveragingModel::setupHamiltonianGenerator(HamiltonianGenerator &hamiltonianGenerator, RND &rnd,
@@ -10,25 +12,14 @@ void RandomPhi0AveragingModel::setupHamiltonianGenerator(HamiltonianGenerator &h
     Expects(numberOfSimulations > 0);
     Expects(simulationIndex < numberOfSimulations);
 
-    bool termFound{};
-    for (auto &diagonalTerm : hamiltonianGenerator.getDiagonalTerms()) {
-        try {
-            auto &quasiperiodicDisorder = dynamic_cast<QuasiperiodicDisorder&>(*diagonalTerm);
-            quasiperiodicDisorder.setPhi0(2*M_PI*rnd());
-            termFound = true;
-        } catch (std::bad_cast &e) { static_cast<void>(e); }
-        try {
-            auto &longIteraction = dynamic_cast<CavityLongInteraction&>(*diagonalTerm);
-            longIteraction.setPhi0(2*M_PI*rnd());
-            termFound = true;
-        } catch (std::bad_cast &e) { static_cast<void>(e); }
-
-        try {
-            auto &onsiteDisorder = dynamic_cast<OnsiteDisorder&>(*diagonalTerm);
-            onsiteDisorder.resampleOnsiteEnergies(rnd);
-            termFound = true;
-        } catch (std::bad_cast &e) { static_cast<void>(e); }
-    }
+    bool termFound = hamiltonianGenerator.visitTerms<QuasiperiodicDisorder, CavityLongInteraction, OnsiteDisorder>(
+        [&rnd](auto &term) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(term)>, OnsiteDisorder>)
+                term.resampleOnsiteEnergies(rnd);
+            else
+                term.setPhi0(2*M_PI*rnd());
+        }
+    );
 
     if (!termFound)
         throw std::runtime_error("RandomPhi0AveragingModel: lack of any term to average on");
@@ -8,7 +8,7 @@
 #include "CavityLongInteraction.h"
 #include "core/HamiltonianGenerator.h"
 
-double CavityLongInteraction::calculate(const FockBasis::Vector &vector, const HamiltonianGenerator &generator) {
+double CavityLongInteraction::calculate(FockBasis::VectorView vector, const HamiltonianGenerator &generator) const {
     Expects(!generator.usingPBC());
 
     std::size_t elementIndex{};
@@ -19,6 +19,18 @@ double CavityLongInteraction::calculate(const FockBasis::Vector &vector, const H
     return -this->U1 / vector.size() * populationImbalance * populationImbalance;
 }
 
+void CavityLongInteraction::addToDiagonal(const SiteOccupations &occupations, const HamiltonianGenerator &generator,
+                                          arma::vec &diagonal) const
+{
+    Expects(!generator.usingPBC());
+
+    std::vector<double> cosines(occupations.getNumberOfSites());
+    for (std::size_t i{}; i < cosines.size(); i++)
+        cosines[i] = this->calculateCosineForSite(i);
+    arma::vec populationImbalances = occupations.calculateWeightedSum(cosines);
+    diagonal -= this->U1 / occupations.getNumberOfSites() * arma::square(populationImbalances);
+}
+
 CavityLongInteraction::CavityLongInteraction(double U1, double beta, double phi0, double phi0Bias)
         : U1{U1}, beta{beta}, phi0{phi0}, phi0Bias{phi0Bias}
 {
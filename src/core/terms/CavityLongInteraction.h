@@ -32,7 +32,10 @@ private:
 public:
     CavityLongInteraction(double U1, double beta, double phi0, double phi0Bias = 0);
 
-    double calculate(const FockBasis::Vector &vector, const HamiltonianGenerator &generator) override;
+    double calculate(FockBasis::VectorView vector, const HamiltonianGenerator &generator) const override;
+
+    void addToDiagonal(const SiteOccupations &occupations, const HamiltonianGenerator &generator,
+                       arma::vec &diagonal) const override;
 
     void setPhi0(double phi0_);
     [[nodiscard]] double calculateCosineForSite(std::size_t siteIdx) const;
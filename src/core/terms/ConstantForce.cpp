@@ -11,7 +11,7 @@ ConstantForce::ConstantForce(double F) : F{F} {
     Expects(F != 0);
 }
 
-double ConstantForce::calculate(const FockBasis::Vector &vector, const HamiltonianGenerator &generator) {
+double ConstantForce::calculate(FockBasis::VectorView vector, const HamiltonianGenerator &generator) const {
     Expects(!generator.usingPBC());
 
     double energyShift = -(static_cast<double>(vector.size()) - 1) / 2;
@@ -22,3 +22,15 @@ double ConstantForce::calculate(const FockBasis::Vector &vector, const Hamiltoni
     double constantForceEnergy = std::accumulate(vector.begin(), vector.end(), 0., energyAccumulator);
     return this->F * constantForceEnergy;
 }
+
+void ConstantForce::addToDiagonal(const SiteOccupations &occupations, const HamiltonianGenerator &generator,
+                                  arma::vec &diagonal) const
+{
+    Expects(!generator.usingPBC());
+
+    double energyShift = -(static_cast<double>(occupations.getNumberOfSites()) - 1) / 2;
+    std::vector<double> siteEnergies(occupations.getNumberOfSites());
+    for (std::size_t i{}; i < siteEnergies.size(); i++)
+        siteEnergies[i] = this->F * (energyShift + static_cast<double>(i));
+    diagonal += occupations.calculateWeightedSum(siteEnergies);
+}
@@ -23,7 +23,10 @@ public:
      */
     explicit ConstantForce(double F);
 
-    double calculate(const FockBasis::Vector &vector, const HamiltonianGenerator &generator) override;
+    double calculate(FockBasis::VectorView vector, const HamiltonianGenerator &generator) const override;
+
+    void addToDiagonal(const SiteOccupations &occupations, const HamiltonianGenerator &generator,
+                       arma::vec &diagonal) const override;
 };
 
 
@@ -3,6 +3,7 @@
 //
 
 #include <iterator>
+#include <algorithm>
 #include <ZipIterator.hpp>
 
 #include "HubbardHop.h"
@@ -10,15 +11,21 @@
 
 double HubbardHop::calculate(const HopData &hopData, const HamiltonianGenerator &generator) const {
     std::size_t distance = generator.getSiteDistance(hopData.fromSite, hopData.toSite);
-    std::size_t paramIdx = std::find(this->hoppingDistances.begin(), this->hoppingDistances.end(), distance)
-                           - this->hoppingDistances.begin();
-    Expects(paramIdx != this->hoppingDistances.size());
+    Expects(distance < this->JsByDistance.size() && this->JsByDistance[distance].has_value());
 
-    return -this->Js[paramIdx];
+    return -*this->JsByDistance[distance];
+}
+
+void HubbardHop::prepareJsByDistance() {
+    std::size_t maxDistance = *std::max_element(this->hoppingDistances.begin(), this->hoppingDistances.end());
+    this->JsByDistance.resize(maxDistance + 1);
+    for (std::size_t i{}; i < this->hoppingDistances.size(); i++)
+        this->JsByDistance[this->hoppingDistances[i]] = this->Js[i];
 }
 
 HubbardHop::HubbardHop(double J) : Js{J}, hoppingDistances{1} {
     Expects(J != 0);
+    this->prepareJsByDistance();
 }
 
 HubbardHop::HubbardHop(std::vector<double> Js) : Js{std::move(Js)} {
@@ -26,6 +33,7 @@ HubbardHop::HubbardHop(std::vector<double> Js) : Js{std::move(Js)} {
     Expects(std::any_of(this->Js.begin(), this->Js.end(), [](double J) { return J != 0; }));
     this->hoppingDistances.resize(this->Js.size());
     std::iota(this->hoppingDistances.begin(), this->hoppingDistances.end(), 1);
+    this->prepareJsByDistance();
 }
 
 HubbardHop::HubbardHop(std::vector<std::size_t> hoppingDistances, std::vector<double> Js)
@@ -40,4 +48,5 @@ HubbardHop::HubbardHop(std::vector<std::size_t> hoppingDistances, std::vector<do
     auto zipped = Zip(this->hoppingDistances, this->Js);
     std::sort(zipped.begin(), zipped.end());
     Expects(std::unique(this->hoppingDistances.begin(), this->hoppingDistances.end()) == this->hoppingDistances.end());
+    this->prepareJsByDistance();
 }
@@ -6,6 +6,9 @@
 #define MBL_ED_HUBBARDHOP_H
 
 
+#include <optional>
+#include <vector>
+
 #include "utils/Assertions.h"
 #include "core/HoppingTerm.h"
 
@@ -18,10 +21,13 @@
  * operator and the constant \f$ J \f$ is passed in the constructor. Moreover \f$ j \f$ may take one or several values
  * representing hoppings by that many sites.
  */
-class HubbardHop : public HoppingTerm {
+class HubbardHop final : public StaticHoppingTerm<HubbardHop> {
 private:
     std::vector<double> Js{};
     std::vector<std::size_t> hoppingDistances{};
+    std::vector<std::optional<double>> JsByDistance{};   // indexed by hopping distance, for fast lookup
+
+    void prepareJsByDistance();
 
 public:
     /**
@@ -6,7 +6,7 @@
 
 #include "HubbardOnsite.h"
 
-double HubbardOnsite::calculate(const FockBasis::Vector &vector, const HamiltonianGenerator &generator) {
+double HubbardOnsite::calculate(FockBasis::VectorView vector, const HamiltonianGenerator &generator) const {
     static_cast<void>(generator);
 
     auto bosonAccumulator = [](auto sum, auto numberOfParticles) {
@@ -15,6 +15,17 @@ double HubbardOnsite::calculate(const FockBasis::Vector &vector, const Hamiltoni
     return this->U / 2 * std::accumulate(vector.begin(), vector.end(), 0., bosonAccumulator);
 }
 
+void HubbardOnsite::addToDiagonal(const SiteOccupations &occupations, const HamiltonianGenerator &generator,
+                                  arma::vec &diagonal) const
+{
+    static_cast<void>(generator);
+
+    std::vector<double> onsiteEnergies(occupations.getMaxOccupation() + 1);
+    for (std::size_t n{}; n < onsiteEnergies.size(); n++)
+        onsiteEnergies[n] = this->U / 2 * static_cast<double>(n) * (static_cast<double>(n) - 1);
+    diagonal += occupations.calculateFunctionSum(onsiteEnergies);
+}
+
 HubbardOnsite::HubbardOnsite(double U) : U{U} {
     Expects(U >= 0);
 }
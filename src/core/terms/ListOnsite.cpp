@@ -6,7 +6,7 @@
 
 #include "utils/Assertions.h"
 
-double ListOnsite::calculate(const FockBasis::Vector &vector, const HamiltonianGenerator &generator) {
+double ListOnsite::calculate(FockBasis::VectorView vector, const HamiltonianGenerator &generator) const {
     Expects(vector.size() == this->onsitePotential.size());
 
     static_cast<void>(generator);
@@ -17,3 +17,12 @@ double ListOnsite::calculate(const FockBasis::Vector &vector, const HamiltonianG
 
     return energy;
 }
+
+void ListOnsite::addToDiagonal(const SiteOccupations &occupations, const HamiltonianGenerator &generator,
+                               arma::vec &diagonal) const
+{
+    Expects(occupations.getNumberOfSites() == this->onsitePotential.size());
+    static_cast<void>(generator);
+
+    diagonal += occupations.calculateWeightedSum(this->onsitePotential);
+}
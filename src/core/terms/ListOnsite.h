@@ -19,7 +19,10 @@ private:
 public:
     explicit ListOnsite(std::vector<double> onsitePotential) : onsitePotential{std::move(onsitePotential)} { }
 
-    double calculate(const FockBasis::Vector &vector, const HamiltonianGenerator &generator) override;
+    double calculate(FockBasis::VectorView vector, const HamiltonianGenerator &generator) const override;
+
+    void addToDiagonal(const SiteOccupations &occupations, const HamiltonianGenerator &generator,
+                       arma::vec &diagonal) const override;
 };
 
 
@@ -6,7 +6,8 @@
 #include "core/HamiltonianGenerator.h"
 
 double LookupCavityY2::calculate(const HopData &firstHopData, const HopData &secondHopData,
-                                 const HamiltonianGenerator &generator) {
+                                 const HamiltonianGenerator &generator) const
+{
     Expects(generator.getSiteDistance(firstHopData.fromSite, firstHopData.toSite) == 1);
     Expects(generator.getSiteDistance(secondHopData.fromSite, secondHopData.toSite) == 1);
     if (generator.usingPBC())
@@ -20,6 +21,24 @@ double LookupCavityY2::calculate(const HopData &firstHopData, const HopData &sec
            * this->currentRealisation.siteEntries[secondSmallerSite].y;
 }
 
+double LookupCavityY2::getSquareFactor(const HamiltonianGenerator &generator) const {
+    if (generator.usingPBC())
+        throw std::runtime_error("LookupCavityY2: PBC not supported");
+    std::size_t numberOfSites = generator.getFockBasis()->getNumberOfSites();
+    Assert(numberOfSites <= this->cavityConstants.getNumberOfSites());
+
+    return -this->U1 / numberOfSites;
+}
+
+double LookupCavityY2::calculateSingleHop(const HopData &hopData, const HamiltonianGenerator &generator) const {
+    Expects(generator.getSiteDistance(hopData.fromSite, hopData.toSite) == 1);
+    if (generator.usingPBC())
+        throw std::runtime_error("LookupCavityY2: PBC not supported");
+    Assert(hopData.fromVector.size() <= this->cavityConstants.getNumberOfSites());
+
+    return this->currentRealisation.siteEntries[std::min(hopData.fromSite, hopData.toSite)].y;
+}
+
 void LookupCavityY2::changeRealisation(std::size_t index) {
     Expects(index < this->cavityConstants.size());
     this->currentRealisation = this->cavityConstants[index];
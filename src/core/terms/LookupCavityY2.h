@@ -22,6 +22,8 @@
  * \f$ i \f$ is the number of site, \f$ K \f$ is the total number of sites, \f$ \hat{b}_i \f$ is annihilation
  * operator, \f$ w_i \f$ is Wannier function localized in site \f$ i \f$ and \f$ U_1 \f$ is passed in the constructor.
  * <p> The constant are taken from the lookup table CavityConstants from the constructor.
+ * <p> It is a square of a hopping operator (see DoubleHoppingTerm::isSquareOfHoppingOperator()), so
+ * HamiltonianGenerator builds it as a product of sparse \f$ \hat{Y} \f$ matrices.
  */
 class LookupCavityY2 : public DoubleHoppingTerm {
 private:
@@ -43,7 +45,20 @@ public:
      * defined.
      */
     double calculate(const HopData &firstHopData, const HopData &secondHopData,
-                     const HamiltonianGenerator &generator) override;
+                     const HamiltonianGenerator &generator) const override;
+
+    [[nodiscard]] bool isSquareOfHoppingOperator() const override { return true; }
+
+    /**
+     * @brief Returns \f$ -U_1/K \f$.
+     */
+    [[nodiscard]] double getSquareFactor(const HamiltonianGenerator &generator) const override;
+
+    /**
+     * @brief Returns \f$ y_i \f$ for a hop between sites \f$ i \f$ and \f$ i+1 \f$.
+     */
+    [[nodiscard]] double calculateSingleHop(const HopData &hopData,
+                                            const HamiltonianGenerator &generator) const override;
 
     /**
      * @brief Changes the realisation, i.e. phi0 and wanniers, to the one pointed by @a index in CavityConstants from
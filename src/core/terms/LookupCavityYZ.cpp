@@ -10,6 +10,17 @@
 void LookupCavityYZ::changeRealisation(std::size_t index) {
     Expects(index < this->cavityConstants.size());
     this->currentRealisation = this->cavityConstants[index];
+    if (this->zCache != nullptr) {
+        // The old values are released first, so that they do not stay in the cache if no other term uses them
+        this->zValues = nullptr;
+        this->zValues = this->zCache->getValues(this->currentRealisation);
+    }
+}
+
+void LookupCavityYZ::enableZCache(std::shared_ptr<CavityZCache> zCache_) {
+    Expects(zCache_ != nullptr);
+    this->zCache = std::move(zCache_);
+    this->zValues = this->zCache->getValues(this->currentRealisation);
 }
 
 double LookupCavityYZ::calculate(const HopData &hopData, const HamiltonianGenerator &generator) const {
@@ -19,13 +30,21 @@ double LookupCavityYZ::calculate(const HopData &hopData, const HamiltonianGenera
     Assert(hopData.fromVector.size() <= this->cavityConstants.getNumberOfSites());
 
     std::size_t smallerSite = std::min(hopData.fromSite, hopData.toSite);
-    double fromZTerm = this->calculateZTerm(hopData.fromVector);
-    double toZTerm = this->calculateZTerm(hopData.toVector);
+    double fromZTerm{}, toZTerm{};
+    if (this->zCache != nullptr && hopData.fromIdx.has_value() && hopData.toIdx.has_value()
+        && this->zCache->isFor(*generator.getFockBasis()))
+    {
+        fromZTerm = (*this->zValues)[*hopData.fromIdx];
+        toZTerm = (*this->zValues)[*hopData.toIdx];
+    } else {
+        fromZTerm = this->calculateZTerm(hopData.fromVector);
+        toZTerm = this->calculateZTerm(hopData.toVector);
+    }
     return -this->U1 / hopData.fromVector.size() * (fromZTerm + toZTerm)
            * this->currentRealisation.siteEntries[smallerSite].y;
 }
 
-double LookupCavityYZ::calculateZTerm(const FockBasis::Vector &vector) const {
+double LookupCavityYZ::calculateZTerm(FockBasis::VectorView vector) const {
     std::size_t siteIndex{};
     auto siteAccumulator = [&siteIndex, this](auto sum, auto element) {
         return sum + this->currentRealisation.siteEntries[siteIndex++].wannier * element;
@@ -7,8 +7,10 @@
 
 
 #include <utility>
+#include <memory>
 
 #include "core/CavityConstants.h"
+#include "core/CavityZCache.h"
 #include "core/HoppingTerm.h"
 #include "core/FockBasis.h"
 #include "utils/Assertions.h"
@@ -28,13 +30,15 @@
  * \f$ i \f$ and \f$ U_1 \f$ is passed in the constructor.
  * <p> The constant are taken from the lookup table CavityConstants from the constructor.
  */
-class LookupCavityYZ : public HoppingTerm {
+class LookupCavityYZ final : public StaticHoppingTerm<LookupCavityYZ> {
 private:
     double U1{};
     CavityConstants cavityConstants;
     CavityConstants::Realisation currentRealisation;
+    std::shared_ptr<CavityZCache> zCache;
+    std::shared_ptr<const arma::vec> zValues;
 
-    double calculateZTerm(const FockBasis::Vector &vector) const;
+    double calculateZTerm(FockBasis::VectorView vector) const;
 
 public:
     LookupCavityYZ(double U1, CavityConstants cavityConstants, std::size_t realisationIndex = 0)
@@ -57,6 +61,14 @@ public:
      */
     void changeRealisation(std::size_t index);
 
+    /**
+     * @brief Uses the eigenvalues of Z operator for all vectors of the basis from @a zCache_, which are then taken
+     * again from it on each changeRealisation().
+     * @details The cached values are used only for hops generated by HamiltonianGenerator with the same FockBasis -
+     * for other ones they are computed from scratch. @a zCache_ may be shared with other terms.
+     */
+    void enableZCache(std::shared_ptr<CavityZCache> zCache_);
+
     [[nodiscard]] std::vector<std::size_t> getHoppingDistances() const override { return {1}; }
 };
 
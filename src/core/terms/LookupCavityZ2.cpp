@@ -7,7 +7,7 @@
 #include "LookupCavityZ2.h"
 #include "core/HamiltonianGenerator.h"
 
-double LookupCavityZ2::calculate(const FockBasis::Vector &vector, const HamiltonianGenerator &generator) {
+double LookupCavityZ2::calculate(FockBasis::VectorView vector, const HamiltonianGenerator &generator) const {
     Expects(!generator.usingPBC());
     Expects(vector.size() <= this->cavityConstants.getNumberOfSites());
 
@@ -19,7 +19,36 @@ double LookupCavityZ2::calculate(const FockBasis::Vector &vector, const Hamilton
     return -this->U1 / vector.size() * populationImbalance * populationImbalance;
 }
 
+void LookupCavityZ2::addToDiagonal(const SiteOccupations &occupations, const HamiltonianGenerator &generator,
+                                   arma::vec &diagonal) const
+{
+    Expects(!generator.usingPBC());
+    Expects(occupations.getNumberOfSites() <= this->cavityConstants.getNumberOfSites());
+
+    if (this->zCache != nullptr && this->zCache->isFor(*generator.getFockBasis())) {
+        diagonal -= this->U1 / occupations.getNumberOfSites() * arma::square(*this->zValues);
+        return;
+    }
+
+    std::vector<double> wanniers(occupations.getNumberOfSites());
+    for (std::size_t i{}; i < wanniers.size(); i++)
+        wanniers[i] = this->currentRealisation.siteEntries[i].wannier;
+    arma::vec populationImbalances = occupations.calculateWeightedSum(wanniers);
+    diagonal -= this->U1 / occupations.getNumberOfSites() * arma::square(populationImbalances);
+}
+
 void LookupCavityZ2::changeRealisation(std::size_t index) {
     Expects(index < this->cavityConstants.size());
     this->currentRealisation = this->cavityConstants[index];
+    if (this->zCache != nullptr) {
+        // The old values are released first, so that they do not stay in the cache if no other term uses them
+        this->zValues = nullptr;
+        this->zValues = this->zCache->getValues(this->currentRealisation);
+    }
+}
+
+void LookupCavityZ2::enableZCache(std::shared_ptr<CavityZCache> zCache_) {
+    Expects(zCache_ != nullptr);
+    this->zCache = std::move(zCache_);
+    this->zValues = this->zCache->getValues(this->currentRealisation);
 }
@@ -7,8 +7,10 @@
 
 
 #include <utility>
+#include <memory>
 
 #include "core/CavityConstants.h"
+#include "core/CavityZCache.h"
 #include "core/DiagonalTerm.h"
 #include "utils/Assertions.h"
 
@@ -24,6 +26,8 @@ private:
     double U1{};
     CavityConstants cavityConstants;
     CavityConstants::Realisation currentRealisation;
+    std::shared_ptr<CavityZCache> zCache;
+    std::shared_ptr<const arma::vec> zValues;
 
 public:
     LookupCavityZ2(double U1, CavityConstants cavityConstants, std::size_t realisationIndex = 0)
@@ -38,13 +42,24 @@ public:
      * @brief Calculates the diagonal elements for @a vector. CavityConstants from the constructor must have enough
      * sites defined.
      */
-    double calculate(const FockBasis::Vector &vector, const HamiltonianGenerator &generator) override;
+    double calculate(FockBasis::VectorView vector, const HamiltonianGenerator &generator) const override;
+
+    void addToDiagonal(const SiteOccupations &occupations, const HamiltonianGenerator &generator,
+                       arma::vec &diagonal) const override;
 
     /**
      * @brief Changes the realisation, i.e. phi0 and wanniers, to the one pointed by @a index in CavityConstants from
      * the constructor.
      */
     void changeRealisation(std::size_t index);
+
+    /**
+     * @brief Uses the eigenvalues of Z operator for all vectors of the basis from @a zCache_, which are then taken
+     * again from it on each changeRealisation().
+     * @details The cached values are used only for diagonals calculated by HamiltonianGenerator with the same
+     * FockBasis - for other ones they are computed from scratch. @a zCache_ may be shared with other terms.
+     */
+    void enableZCache(std::shared_ptr<CavityZCache> zCache_);
 };
 
 
@@ -19,7 +19,7 @@ void OnsiteDisorder::resampleOnsiteEnergies(RND &rnd) {
     });
 }
 
-double OnsiteDisorder::calculate(const FockBasis::Vector &vector, const HamiltonianGenerator &generator) {
+double OnsiteDisorder::calculate(FockBasis::VectorView vector, const HamiltonianGenerator &generator) const {
     Expects(vector.size() == this->onsiteEnergies.size());
     static_cast<void>(generator);
 
@@ -29,3 +29,12 @@ double OnsiteDisorder::calculate(const FockBasis::Vector &vector, const Hamilton
                    std::back_inserter(elementwiseEnergies), std::multiplies<>());
     return std::accumulate(elementwiseEnergies.begin(), elementwiseEnergies.end(), 0., std::plus<>());
 }
+
+void OnsiteDisorder::addToDiagonal(const SiteOccupations &occupations, const HamiltonianGenerator &generator,
+                                   arma::vec &diagonal) const
+{
+    Expects(occupations.getNumberOfSites() == this->onsiteEnergies.size());
+    static_cast<void>(generator);
+
+    diagonal += occupations.calculateWeightedSum(this->onsiteEnergies);
+}
@@ -14,7 +14,7 @@ QuasiperiodicDisorder::QuasiperiodicDisorder(double W, double beta, double phi0)
     Expects(beta >= 0);
 }
 
-double QuasiperiodicDisorder::calculate(const FockBasis::Vector &vector, const HamiltonianGenerator &generator) {
+double QuasiperiodicDisorder::calculate(FockBasis::VectorView vector, const HamiltonianGenerator &generator) const {
     static_cast<void>(generator);
 
     double energy{};
@@ -24,6 +24,17 @@ double QuasiperiodicDisorder::calculate(const FockBasis::Vector &vector, const H
     return energy;
 }
 
+void QuasiperiodicDisorder::addToDiagonal(const SiteOccupations &occupations, const HamiltonianGenerator &generator,
+                                          arma::vec &diagonal) const
+{
+    static_cast<void>(generator);
+
+    std::vector<double> siteEnergies(occupations.getNumberOfSites());
+    for (std::size_t i{}; i < siteEnergies.size(); i++)
+        siteEnergies[i] = this->W * std::cos(2*M_PI*this->beta*i + this->phi0);
+    diagonal += occupations.calculateWeightedSum(siteEnergies);
+}
+
 void QuasiperiodicDisorder::setPhi0(double phi0) {
     this->phi0 = phi0;
 }
\ No newline at end of file
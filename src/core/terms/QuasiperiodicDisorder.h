@@ -25,7 +25,10 @@ class QuasiperiodicDisorder : public DiagonalTerm {
 public:
     QuasiperiodicDisorder(double W, double beta, double phi0);
 
-    double calculate(const FockBasis::Vector &vector, const HamiltonianGenerator &generator) override;
+    double calculate(FockBasis::VectorView vector, const HamiltonianGenerator &generator) const override;
+
+    void addToDiagonal(const SiteOccupations &occupations, const HamiltonianGenerator &generator,
+                       arma::vec &diagonal) const override;
 
     void setPhi0(double phi0);
 };
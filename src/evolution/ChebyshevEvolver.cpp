@@ -4,6 +4,11 @@
 
 #include <complex>
 #include <chrono>
+#include <map>
+#include <mutex>
+#include <cmath>
+#include <optional>
+#include <algorithm>
 
 #include "ChebyshevEvolver.h"
 #include "utils/Assertions.h"
@@ -12,152 +17,267 @@
 using namespace std::complex_literals;
 
 namespace {
+    std::map<double, std::size_t> orderCache;
+    std::mutex orderCacheMutex;
+
     /**
-     * @brief returns (matrix * vec)[elementIdx] using CSR matrix * dense vector multiplication scheme
+     * @brief Returns the smallest N >= @a x for which \f$ 2 \sum_{k > N} |J_k(x)| \le \f$ @a maxError.
+     * @details Coefficients are calculated until they are negligible compared to @a maxError and then summed from the
+     * end. Since they decay superexponentially there, the omitted rest is bounded by the last one. If no order up to
+     * @a maxOrder is sufficient, a number greater than @a maxOrder is returned (without further calculations when
+     * already @a x exceeds @a maxOrder).
      */
-    inline std::complex<double> csrMatTimesCxVecElem(const arma::cx_vec &vec, const std::vector<double> &matrixData,
-                                                     const std::vector<std::size_t> &matrixColIdx,
-                                                     const std::vector<std::size_t> &matrixRowPtr,
-                                                     std::size_t elementIdx)
-    {
-        std::complex<double> Ax_i = 0.0;
-        for (std::size_t dataIdx = matrixRowPtr[elementIdx]; dataIdx < matrixRowPtr[elementIdx + 1]; dataIdx++)
-            Ax_i += matrixData[dataIdx] * vec[matrixColIdx[dataIdx]];
-        return Ax_i;
+    std::size_t find_order_for_error(double x, double maxError, std::size_t maxOrder) {
+        if (x >= static_cast<double>(maxOrder))
+            return maxOrder + 1;
+
+        std::vector<double> absCoefficients{0};
+        for (std::size_t k = 1; ; k++) {
+            absCoefficients.push_back(2 * std::abs(std::cyl_bessel_j(k, x)));
+            if (static_cast<double>(k) > x && absCoefficients.back() < 1e-4 * maxError)
+                break;
+        }
+
+        auto minOrder = static_cast<std::size_t>(std::ceil(x));
+        double tail = absCoefficients.back();
+        std::size_t order = absCoefficients.size() - 1;
+        while (order > minOrder && tail + absCoefficients[order] <= maxError) {
+            tail += absCoefficients[order];
+            order--;
+        }
+        return std::max<std::size_t>(order, 1);
     }
 }
 
 /**
- * @brief Perform one Chebyshev step by this->dt.
- * @details It uses custom sparse matrix - dense vector multiplication, since this from Armadillo is lame.
+ * @brief Perform one Chebyshev step by this->dt from all columns of @a states and store them in @a result.
+ * @details The hamiltonian is not rescaled explicitly - the rescaling is applied to the vectors after acting with it,
+ * so no copy of the hamiltonian is made. The coefficients have to be prepared up to this->N order and the workspace
+ * allocated for the same number of columns. Single states can be passed as arma::cx_vec. @a result must not alias any
+ * of the workspace vectors.
  */
-arma::cx_vec ChebyshevEvolver::evolveState(const arma::cx_vec &state) {
-    // Rescales so that hamiltonian's eigenvalues lie in [-1, 1] range
-    arma::sp_mat hamiltonianRescaled = (this->hamiltonian - arma::speye(arma::size(this->hamiltonian)) * this->b)
-                                       / this->a;
-
-    // We just steal sparse matrix data from Armadillo's matrix. Note, that it uses CSC format and we interpret it as
-    // CSR, but it's ok since the matrix is Hermitean
-    // details: https://en.wikipedia.org/wiki/Sparse_matrix#Compressed_sparse_row_(CSR,_CRS_or_Yale_format)
-    std::vector<double> hamData(hamiltonianRescaled.values, hamiltonianRescaled.values + hamiltonianRescaled.n_nonzero);
-    std::vector<std::size_t> hamColIdx(hamiltonianRescaled.row_indices,
-                                      hamiltonianRescaled.row_indices + hamiltonianRescaled.n_nonzero);
-    std::vector<std::size_t> hamRowPtr(hamiltonianRescaled.col_ptrs,
-                                     hamiltonianRescaled.col_ptrs + hamiltonianRescaled.n_rows + 1);
-
-    // Now we perform Chebyshev expansion summation as stated in paper:
+void ChebyshevEvolver::evolveStates(const arma::cx_mat &states, arma::cx_mat &result) {
+    // We perform Chebyshev expansion summation as stated in paper:
     // Many-body localization in presence of cavity mediated long-range interactions
     // using Clenshaw algorithm from:
     // https://en.wikipedia.org/wiki/Clenshaw_algorithm
     // All vague variable names follow from this Wikipedia link.
-    // In this case a_0 = J_0(this->a t), a_k = 2(-i)^k J_k(this->a t)
-    arma::cx_vec bNext(arma::size(state), arma::fill::zeros);
-    arma::cx_vec bNextNext(arma::size(state), arma::fill::zeros);
-    arma::cx_vec B(arma::size(state));  // Capital b not to collide with this->b
+    // In this case a_0 = J_0(this->a t), a_k = 2(-i)^k J_k(this->a t) - real factors are precomputed in
+    // this->coefficients
+    // The rescaled hamiltonian, with eigenvalues in [-1, 1] range, is (H - this->b) / this->a
+    // Everything is done on real planes: the first half of the elements of the workspace are real parts, the second
+    // half - imaginary parts
+    Expects(this->coefficients.size() > this->N);
+    Expects(states.n_rows == this->bNext.n_rows && 2 * states.n_cols == this->bNext.n_cols);
+
+    std::size_t planeSize = states.n_elem;
+    double *realPlane = this->statePlanes.memptr();
+    double *imagPlane = realPlane + planeSize;
+    _OMP_PARALLEL_FOR
+    for (std::size_t j = 0; j < planeSize; j++) {
+        realPlane[j] = states[j].real();
+        imagPlane[j] = states[j].imag();
+    }
+
+    double twoOverA = 2 / this->a;
+    this->bNext.zeros();
+    this->bNextNext.zeros();
 
     // Iteratively reach bNext = b_1, bNext = b_2
     for (std::size_t i = this->N; i > 0; i--) {
-        std::complex<double> coeff = 2. * std::pow(-1i, i) * std::cyl_bessel_j(i, this->a * this->dt);
+        // Multiplication by -i maps the planes (real, imag) to (imag, -real), so the factor (-i)^i of a_i swaps the
+        // planes for odd i and the signs follow from (-i)^i = 1, -i, -1, i for i % 4 = 0, 1, 2, 3
+        double coeff = this->coefficients[i];
+        const double *realSource = (i % 2 == 0) ? realPlane : imagPlane;
+        const double *imagSource = (i % 2 == 0) ? imagPlane : realPlane;
+        double realCoeff = (i % 4 == 0 || i % 4 == 1) ? coeff : -coeff;
+        double imagCoeff = (i % 4 == 0 || i % 4 == 3) ? coeff : -coeff;
+
+        this->hamiltonian.applyToBlock(this->bNext, this->hamiltonianTimesBNext);
 
         _OMP_PARALLEL_FOR
-        for (std::size_t j = 0; j < state.size(); j++)
-            B[j] = coeff * state[j] + 2. * csrMatTimesCxVecElem(bNext, hamData, hamColIdx, hamRowPtr, j) - bNextNext[j];
-        bNextNext = bNext;
-        bNext = B;
+        for (std::size_t j = 0; j < planeSize; j++) {
+            std::size_t jImag = j + planeSize;
+            this->B[j] = realCoeff * realSource[j]
+                         + twoOverA * (this->hamiltonianTimesBNext[j] - this->b * this->bNext[j])
+                         - this->bNextNext[j];
+            this->B[jImag] = imagCoeff * imagSource[j]
+                             + twoOverA * (this->hamiltonianTimesBNext[jImag] - this->b * this->bNext[jImag])
+                             - this->bNextNext[jImag];
+        }
+        // Rotate the vectors: bNextNext <- bNext, bNext <- B, and the old bNextNext will be overwritten as B
+        this->bNextNext.swap(this->bNext);
+        this->bNext.swap(this->B);
     }
 
-    // Now, compute p_n and store it in B
-    std::complex<double> coeff = std::cyl_bessel_j(0, this->a * this->dt);
+    // Now, compute p_n and store it in result
+    double coeff = this->coefficients[0];
+    this->hamiltonian.applyToBlock(this->bNext, this->hamiltonianTimesBNext);
 
+    result.set_size(states.n_rows, states.n_cols);
     _OMP_PARALLEL_FOR
-    for (std::size_t i = 0; i < state.size(); i++) {
-        B[i] = coeff * state[i] + csrMatTimesCxVecElem(bNext, hamData, hamColIdx, hamRowPtr, i) - bNextNext[i];
-        B[i] *= std::exp(-1i * this->b * this->dt);
+    for (std::size_t j = 0; j < planeSize; j++) {
+        std::size_t jImag = j + planeSize;
+        double realPart = coeff * realPlane[j]
+                          + (this->hamiltonianTimesBNext[j] - this->b * this->bNext[j]) / this->a
+                          - this->bNextNext[j];
+        double imagPart = coeff * imagPlane[j]
+                          + (this->hamiltonianTimesBNext[jImag] - this->b * this->bNext[jImag]) / this->a
+                          - this->bNextNext[jImag];
+        result[j] = std::complex<double>(realPart, imagPart) * this->phase;
     }
-
-    return B;
 }
 
 void ChebyshevEvolver::prepareFor(const arma::cx_vec &initialState, double maxTime, std::size_t maxSteps_) {
     Expects(maxTime > 0);
     Expects(maxSteps_ > 0);
-    Expects(initialState.size() == this->hamiltonian.n_cols);
+    Expects(initialState.size() == this->hamiltonian.size());
 
+    this->currentState = initialState;
+    this->blockMode = false;
+    this->prepareWorkspace(1, maxTime, maxSteps_);
+    this->selectOrder(initialState);
+}
+
+void ChebyshevEvolver::prepareForBlock(const arma::cx_mat &initialStates, double maxTime, std::size_t maxSteps_) {
+    Expects(maxTime > 0);
+    Expects(maxSteps_ > 0);
+    Expects(initialStates.n_rows == this->hamiltonian.size());
+    Expects(initialStates.n_cols > 0);
+
+    this->currentStates = initialStates;
+    this->blockMode = true;
+    this->prepareWorkspace(initialStates.n_cols, maxTime, maxSteps_);
+    this->selectOrder(initialStates);
+}
+
+/**
+ * @brief Resets the time and allocates the workspace for @a numStates states evolved simultaneously.
+ */
+void ChebyshevEvolver::prepareWorkspace(std::size_t numStates, double maxTime, std::size_t maxSteps_) {
     this->t = 0;
     this->dt = maxTime / static_cast<double>(maxSteps_);
-    this->currentState = initialState;
     this->currentStep = 0;
     this->maxSteps = maxSteps_;
 
-    this->optimizeOrder(initialState);
+    std::size_t size = this->hamiltonian.size();
+    this->statePlanes.set_size(size, 2 * numStates);
+    this->bNext.set_size(size, 2 * numStates);
+    this->bNextNext.set_size(size, 2 * numStates);
+    this->B.set_size(size, 2 * numStates);
+    this->hamiltonianTimesBNext.set_size(size, 2 * numStates);
+    if (this->blockMode)
+        this->evolvedStates.set_size(size, numStates);
+    else
+        this->evolvedState.set_size(size);
+    this->coefficients.clear();
+    this->phase = std::exp(-1i * this->b * this->dt);
 }
 
 /**
- * @brief Finds the optimal order of Chebychev expansion, requiring that norm leakage per step should not be greater
- * than MAXIMAL_NORM_LEAKAGE
+ * @brief Extends the table of expansion coefficients for the current dt to contain orders from 0 to @a order.
  */
-void ChebyshevEvolver::optimizeOrder(const arma::cx_vec &initialState) {
-    arma::cx_vec evolvedState;
-    double normLeakage{};
-    double initialNorm = arma::norm(initialState);
-
-    this->logger.info() << "Optimizing Chebyshev expansion order:" << std::endl;
-
-    // Exponentially find the upper limit for order
-    this->N = 1;
-    do {
-        this->N *= 2;
-        Assert(this->N <= 2048);
-        evolvedState = this->evolveState(initialState);
-        normLeakage = std::abs(initialNorm - arma::norm(evolvedState));
-        Assert(!std::isnan(normLeakage));
-        this->logger.info() << "Trying " << this->N << "... Norm leakage: " << normLeakage << std::endl;
-    } while (normLeakage > MAXIMAL_NORM_LEAKAGE);
-
-    // Now, find optimal order using bisection
-    std::size_t minN = this->N / 2;
-    std::size_t maxN = this->N;
-    do {
-        std::size_t midN = (minN + maxN) / 2;
-        this->N = midN;
-        evolvedState = this->evolveState(initialState);
-        normLeakage = std::abs(initialNorm - arma::norm(evolvedState));
-        Assert(!std::isnan(normLeakage));
-        this->logger.info() << "Trying " << this->N << "... Norm leakage: " << normLeakage << std::endl;
+void ChebyshevEvolver::prepareCoefficients(std::size_t order) {
+    double x = this->a * this->dt;
+    std::size_t oldSize = this->coefficients.size();
+    if (oldSize > order)
+        return;
 
-        if (normLeakage <= MAXIMAL_NORM_LEAKAGE)
-            maxN = midN;
+    this->coefficients.resize(order + 1);
+    for (std::size_t i = oldSize; i <= order; i++) {
+        if (i == 0)
+            this->coefficients[i] = std::cyl_bessel_j(0, x);
         else
-            minN = midN;
-    } while (maxN - minN > 1);
+            this->coefficients[i] = 2 * std::cyl_bessel_j(i, x);
+    }
+}
+
+/**
+ * @brief Selects the order of Chebyshev expansion from the decay of the coefficients, so that the error per step is
+ * not greater than MAXIMAL_ERROR.
+ * @details Since Chebyshev polynomials of the rescaled hamiltonian have norm not greater than 1, the error of the
+ * expansion truncated at the order N is bounded by \f$ 2 \sum_{k > N} |J_k(a\,dt)| \f$. For k > a dt Bessel functions
+ * decay superexponentially, so the sum can be calculated from a finite number of terms. The order is found for a*dt
+ * rounded up to 1/ORDER_CACHE_RESOLUTION - for N > a dt, |J_k(x)| grow with x, so the bound is also valid for the
+ * actual a*dt. The orders are cached and shared between all evolvers, so they are calculated once for all time
+ * segments and realisations. On the cache miss, a single step is additionally performed to verify the norm leakage -
+ * if it exceeds MAXIMAL_NORM_LEAKAGE, the order is doubled (up to MAXIMAL_ORDER) and the step is repeated, before the
+ * order is cached. The mutex guarding the cache is held only for the lookup and the insertion, so evolvers with
+ * different a*dt do not wait for each other. If a*dt is so large that MAXIMAL_ORDER does not meet MAXIMAL_ERROR, the
+ * order is capped at MAXIMAL_ORDER with a warning instead of aborting the simulation.
+ */
+void ChebyshevEvolver::selectOrder(const arma::cx_mat &initialStates) {
+    double x = this->a * this->dt;
+    double xKey = std::ceil(x * ORDER_CACHE_RESOLUTION) / ORDER_CACHE_RESOLUTION;
+
+    std::optional<std::size_t> cachedOrder;
+    {
+        std::lock_guard<std::mutex> lock(orderCacheMutex);
+        auto cached = orderCache.find(xKey);
+        if (cached != orderCache.end())
+            cachedOrder = cached->second;
+    }
+    if (cachedOrder.has_value()) {
+        this->N = *cachedOrder;
+        this->prepareCoefficients(this->N);
+        this->logger.info() << "Chebyshev expansion order for a*dt = " << x << ": " << this->N << " (cached)";
+        this->logger << std::endl;
+        return;
+    }
+
+    arma::cx_mat &evolved = this->blockMode ? this->evolvedStates : this->evolvedState;
+    double initialNorm = arma::norm(initialStates, "fro");
+    auto calculateNormLeakage = [&]() {
+        this->prepareCoefficients(this->N);
+        this->evolveStates(initialStates, evolved);
+        double normLeakage = std::abs(initialNorm - arma::norm(evolved, "fro"));
+        Assert(!std::isnan(normLeakage));
+        return normLeakage;
+    };
 
-    this->logger.info() << "Optimal orders needed: " << N << std::endl;
+    this->N = find_order_for_error(xKey, MAXIMAL_ERROR, MAXIMAL_ORDER);
+    if (this->N > MAXIMAL_ORDER) {
+        this->logger.warn() << "a*dt = " << x << " requires the Chebyshev order above " << MAXIMAL_ORDER << " for ";
+        this->logger << "the error " << MAXIMAL_ERROR << "; capping the order, consider a smaller time step";
+        this->logger << std::endl;
+        this->N = MAXIMAL_ORDER;
+    }
+    double normLeakage = calculateNormLeakage();
+    while (normLeakage > MAXIMAL_NORM_LEAKAGE && this->N < MAXIMAL_ORDER) {
+        this->logger.verbose() << "Norm leakage " << normLeakage << " for the order " << this->N << " exceeds ";
+        this->logger << MAXIMAL_NORM_LEAKAGE << ", doubling the order" << std::endl;
+        this->N = std::min(2 * this->N, MAXIMAL_ORDER);
+        normLeakage = calculateNormLeakage();
+    }
+
+    this->logger.info() << "Chebyshev expansion order for a*dt = " << x << ": " << this->N << ", norm leakage: ";
+    this->logger << normLeakage << std::endl;
+    if (normLeakage > MAXIMAL_NORM_LEAKAGE) {
+        this->logger.warn() << "Norm leakage exceeds " << MAXIMAL_NORM_LEAKAGE << " for the maximal order ";
+        this->logger << MAXIMAL_ORDER << std::endl;
+    }
+
+    // If another evolver has cached the order for the same a*dt in the meantime, its order is kept
+    std::lock_guard<std::mutex> lock(orderCacheMutex);
+    orderCache.emplace(xKey, this->N);
 }
 
 /**
- * @brief Finds the highest and lowest eigenvalues of the hamiltonian which are needed in the expansion using sparse
- * matrix techniques
+ * @brief Finds the highest and lowest eigenvalues of the hamiltonian which are needed in the expansion
+ * @details The bounds (for example Lanczos Ritz values) may lie slightly inside the spectrum, while Chebyshev
+ * polynomials blow up outside [-1, 1], so the range is widened by SPECTRUM_MARGIN of its width, as in
+ * PolynomialFilteredEigensolver.
  */
 void ChebyshevEvolver::findSpectrumRange() {
-    std::size_t numEigvals = std::min<std::size_t>(MIN_EIGVAL, this->hamiltonian.n_rows - 1);
-    arma::vec minEigval, maxEigval;
     this->logger.verbose() << "Calculating spectrum bounds started... " << std::endl;
 
     arma::wall_clock timer;
     timer.tic();
-    Assert(arma::eigs_sym(minEigval, this->hamiltonian, numEigvals, "sa"));
-    double EminTime = timer.toc();
-
-    timer.tic();
-    Assert(arma::eigs_sym(maxEigval, this->hamiltonian, numEigvals, "la"));
-    double EmaxTime = timer.toc();
-
-    double Emin = minEigval.front();
-    double Emax = maxEigval.back();
-    this->a = (Emax - Emin) / 2;
+    auto [Emin, Emax] = this->hamiltonian.findSpectrumBounds();
+    double margin = SPECTRUM_MARGIN * (Emax - Emin);
+    this->a = (Emax - Emin) / 2 + margin;
     this->b = (Emax + Emin) / 2;
-    this->logger.info() << "Calculating spectrum range done (Emin: " << EminTime << " s, ";
-    this->logger << "Emax: " << EmaxTime << " s)." << std::endl;
+    this->logger.info() << "Calculating spectrum range done (" << timer.toc() << " s)." << std::endl;
 }
 
 void ChebyshevEvolver::evolve() {
@@ -166,14 +286,26 @@ void ChebyshevEvolver::evolve() {
     this->currentStep++;
     this->t += this->dt;
 
-    this->currentState = this->evolveState(this->currentState);
+    if (this->blockMode) {
+        this->evolveStates(this->currentStates, this->evolvedStates);
+        this->currentStates.swap(this->evolvedStates);
+    } else {
+        this->evolveStates(this->currentState, this->evolvedState);
+        this->currentState.swap(this->evolvedState);
+    }
 }
 
 const arma::cx_vec &ChebyshevEvolver::getCurrentState() const {
+    Expects(!this->blockMode);
     return this->currentState;
 }
 
-ChebyshevEvolver::ChebyshevEvolver(const arma::sp_mat &hamiltonian, Logger &logger)
+const arma::cx_mat &ChebyshevEvolver::getCurrentStates() const {
+    Expects(this->blockMode);
+    return this->currentStates;
+}
+
+ChebyshevEvolver::ChebyshevEvolver(const HamiltonianOperator &hamiltonian, Logger &logger)
         : hamiltonian{hamiltonian}, logger{logger}
 {
     this->findSpectrumRange();
@@ -6,18 +6,34 @@
 #define MBL_ED_CHEBYSHEVEVOLVER_H
 
 
+#include <vector>
+#include <complex>
+
 #include "Evolver.h"
 
+#include "core/HamiltonianOperator.h"
 #include "utils/Logger.h"
 
 /**
  * @brief Evolver usign Chebyshev expansion technique from paper:
  * <em>Many-body localization in presence of cavity mediated long-range interactions</em>
+ * @details The expansion coefficients for a given time step and the vectors used in the summation are prepared once in
+ * prepareFor(), so a single step consists only of the actions of the hamiltonian and vector updates. The order of the
+ * expansion is chosen from the decay of the coefficients with an explicit error bound and cached between the evolvers
+ * (see selectOrder()).
+ * <p> Since the hamiltonian is real, the real and imaginary parts of the vectors are evolved as separate real
+ * planes, and the factors \f$ (-i)^k \f$ of the coefficients just swap the planes and change their signs. Thus, the
+ * expansion uses only real arithmetic and both planes are multiplied by the hamiltonian in a single pass.
+ * <p> Many states can be evolved at once (see prepareForBlock()). Then the Clenshaw recurrence runs on the whole
+ * block and the hamiltonian acts on it using HamiltonianOperator::applyToBlock(), so the matrix elements are read
+ * once per order for all states.
  */
 class ChebyshevEvolver : public Evolver {
 private:
-    const arma::sp_mat &hamiltonian;
+    const HamiltonianOperator &hamiltonian;
     arma::cx_vec currentState;
+    arma::cx_mat currentStates;
+    bool blockMode{};
     double a{};
     double b{};
     std::size_t N{};
@@ -27,23 +43,49 @@ private:
     std::size_t maxSteps{};
     Logger &logger;
 
-    static constexpr std::size_t MIN_EIGVAL = 20;
+    // Real parts of expansion coefficients a_0 = J_0(a dt), a_k = 2(-i)^k J_k(a dt), so J_0(a dt) and 2 J_k(a dt), for
+    // the current dt and the phase exp(-i b dt)
+    std::vector<double> coefficients;
+    std::complex<double> phase{};
+
+    // Workspace of Clenshaw algorithm, allocated once in prepareFor() and reused in all steps. The vectors are real -
+    // the first half of columns are real parts of the states evolved simultaneously, the second half - imaginary parts
+    arma::mat statePlanes;
+    arma::mat bNext;
+    arma::mat bNextNext;
+    arma::mat B;     // Capital b not to collide with this->b
+    arma::mat hamiltonianTimesBNext;
+    arma::cx_vec evolvedState;
+    arma::cx_mat evolvedStates;
+
+    static constexpr double MAXIMAL_ERROR = 1e-12;
     static constexpr double MAXIMAL_NORM_LEAKAGE = 1e-12;
+    static constexpr std::size_t MAXIMAL_ORDER = 2048;
+    static constexpr double ORDER_CACHE_RESOLUTION = 64;
+    static constexpr double SPECTRUM_MARGIN = 0.01;
 
     void findSpectrumRange();
-    void optimizeOrder(const arma::cx_vec &initialState);
-    [[nodiscard]] arma::cx_vec evolveState(const arma::cx_vec &state);
+    void prepareCoefficients(std::size_t order);
+    void prepareWorkspace(std::size_t numStates, double maxTime, std::size_t maxSteps_);
+    void selectOrder(const arma::cx_mat &initialStates);
+    void evolveStates(const arma::cx_mat &states, arma::cx_mat &result);
 
 public:
     /**
      * @brief Constructs the evolver which will be using given @a hamiltonian
+     * @details The evolver only acts with @a hamiltonian on vectors, so it works both with the sparse matrix and
+     * matrix-free hamiltonians. @a hamiltonian has to outlive the evolver.
      */
-    ChebyshevEvolver(const arma::sp_mat &hamiltonian, Logger &logger);
+    ChebyshevEvolver(const HamiltonianOperator &hamiltonian, Logger &logger);
 
     void prepareFor(const arma::cx_vec &initialState, double maxTime, std::size_t maxSteps_) override;
     void evolve() override;
     [[nodiscard]] const arma::cx_vec &getCurrentState() const override;
     [[nodiscard]] double getDt() const override;
+
+    [[nodiscard]] bool supportsBlockEvolution() const override { return true; }
+    void prepareForBlock(const arma::cx_mat &initialStates, double maxTime, std::size_t maxSteps_) override;
+    [[nodiscard]] const arma::cx_mat &getCurrentStates() const override;
 };
 
 
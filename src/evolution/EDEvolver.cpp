@@ -12,8 +12,23 @@ void EDEvolver::prepareFor(const arma::cx_vec &initialState, double maxTime, std
     Expects(numSteps_ > 0);
     Expects(initialState.size() == this->eigensystem.size());
 
-    this->dt = maxTime / static_cast<double>(numSteps_);
     this->currentState = initialState;
+    this->blockMode = false;
+    this->prepareEvolutionOperator(maxTime, numSteps_);
+}
+
+void EDEvolver::prepareForBlock(const arma::cx_mat &initialStates, double maxTime, std::size_t numSteps_) {
+    Expects(maxTime > 0);
+    Expects(numSteps_ > 0);
+    Expects(initialStates.n_rows == this->eigensystem.size());
+
+    this->currentStates = initialStates;
+    this->blockMode = true;
+    this->prepareEvolutionOperator(maxTime, numSteps_);
+}
+
+void EDEvolver::prepareEvolutionOperator(double maxTime, std::size_t numSteps_) {
+    this->dt = maxTime / static_cast<double>(numSteps_);
     this->currentStep = 0;
     this->numSteps = numSteps_;
 
@@ -28,13 +43,22 @@ void EDEvolver::evolve() {
     // Actually this->currentStep == this->steps here will give 1 step too much, but do not throw for convenience of use
     Assert(this->currentStep <= this->numSteps);
     this->currentStep++;
-    this->currentState = this->evolutionOperator * this->currentState;
+    if (this->blockMode)
+        this->currentStates = this->evolutionOperator * this->currentStates;
+    else
+        this->currentState = this->evolutionOperator * this->currentState;
 }
 
 const arma::cx_vec &EDEvolver::getCurrentState() const {
+    Expects(!this->blockMode);
     return this->currentState;
 }
 
+const arma::cx_mat &EDEvolver::getCurrentStates() const {
+    Expects(this->blockMode);
+    return this->currentStates;
+}
+
 EDEvolver::EDEvolver(const Eigensystem &eigensystem) : eigensystem{eigensystem} {
     Expects(eigensystem.hasEigenvectors());
 }
@@ -17,11 +17,15 @@ private:
     const Eigensystem &eigensystem;
     arma::cx_mat evolutionOperator;
     arma::cx_vec currentState;
+    arma::cx_mat currentStates;
+    bool blockMode{};
     double dt{};
     double t{};
     std::size_t currentStep{};
     std::size_t numSteps{};
 
+    void prepareEvolutionOperator(double maxTime, std::size_t numSteps_);
+
 public:
     /**
      * @brief Constructs the evolver using the given @a eigensystem.
@@ -32,6 +36,10 @@ public:
     void evolve() override;
     [[nodiscard]] const arma::cx_vec &getCurrentState() const override;
     [[nodiscard]] double getDt() const override;
+
+    [[nodiscard]] bool supportsBlockEvolution() const override { return true; }
+    void prepareForBlock(const arma::cx_mat &initialStates, double maxTime, std::size_t numSteps_) override;
+    [[nodiscard]] const arma::cx_mat &getCurrentStates() const override;
 };
 
 
@@ -5,6 +5,8 @@
 #ifndef MBL_ED_EVOLVER_H
 #define MBL_ED_EVOLVER_H
 
+#include <stdexcept>
+
 #include <armadillo>
 
 /**
@@ -30,6 +32,30 @@ public:
 
     [[nodiscard]] virtual const arma::cx_vec &getCurrentState() const = 0;
     [[nodiscard]] virtual double getDt() const = 0;
+
+    /**
+     * @brief Returns true if the evolver can evolve many states at once using prepareForBlock().
+     */
+    [[nodiscard]] virtual bool supportsBlockEvolution() const { return false; }
+
+    /**
+     * @brief Block version of prepareFor(): all columns of @a initialStates are evolved simultaneously.
+     * @details After it, evolve() advances all states and they are accessible via getCurrentStates(), while
+     * getCurrentState() should not be used. The default implementation throws - supportsBlockEvolution() should be
+     * checked first.
+     */
+    virtual void prepareForBlock([[maybe_unused]] const arma::cx_mat &initialStates, [[maybe_unused]] double maxTime,
+                                 [[maybe_unused]] std::size_t numSteps)
+    {
+        throw std::logic_error("Evolver: block evolution is not supported");
+    }
+
+    /**
+     * @brief Returns the states evolved in the block mode (see prepareForBlock()), one per column.
+     */
+    [[nodiscard]] virtual const arma::cx_mat &getCurrentStates() const {
+        throw std::logic_error("Evolver: block evolution is not supported");
+    }
 };
 
 #endif //MBL_ED_EVOLVER_H
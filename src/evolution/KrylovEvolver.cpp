@@ -0,0 +1,165 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#include <complex>
+#include <cmath>
+#include <algorithm>
+
+#include "KrylovEvolver.h"
+#include "utils/Assertions.h"
+
+using namespace std::complex_literals;
+
+KrylovEvolver::KrylovEvolver(const HamiltonianOperator &hamiltonian, Logger &logger)
+        : hamiltonian{hamiltonian}, logger{logger}
+{ }
+
+void KrylovEvolver::prepareFor(const arma::cx_vec &initialState, double maxTime, std::size_t maxSteps_) {
+    Expects(maxTime > 0);
+    Expects(maxSteps_ > 0);
+    Expects(initialState.size() == this->hamiltonian.size());
+
+    this->t = 0;
+    this->dt = maxTime / static_cast<double>(maxSteps_);
+    this->currentState = initialState;
+    this->currentStep = 0;
+    this->maxSteps = maxSteps_;
+
+    // Substep length is kept from the previous segment, if there was one - it is already adjusted to the hamiltonian
+    if (this->substepLength == 0 || this->substepLength > this->dt)
+        this->substepLength = this->dt;
+
+    std::size_t krylovDimension = std::min<std::size_t>(MAX_KRYLOV_DIMENSION, initialState.size());
+    this->krylovVectors.resize(krylovDimension);
+    for (auto &krylovVector : this->krylovVectors)
+        krylovVector.set_size(initialState.size());
+    this->hamiltonianTimesVector.set_size(initialState.size());
+}
+
+/**
+ * @brief Performs Lanczos iteration starting from normalized @a state and fills this->krylovVectors and
+ * this->tridiagonalMatrix. Returns the dimension of the subspace.
+ * @details Krylov vectors are fully reorthogonalized. The norm of the residual after the last vector is stored in
+ * @a nextBeta - it is 0 if the subspace turned out to be invariant.
+ */
+std::size_t KrylovEvolver::buildKrylovSubspace(const arma::cx_vec &state, double &nextBeta) {
+    std::size_t maxDimension = this->krylovVectors.size();
+    std::vector<double> alphas, betas;
+    alphas.reserve(maxDimension);
+    betas.reserve(maxDimension);
+
+    this->krylovVectors[0] = state / arma::norm(state);
+    std::size_t dimension{};
+    double maxAbsAlpha{};
+    nextBeta = 0;
+    while (dimension < maxDimension) {
+        const arma::cx_vec &vector = this->krylovVectors[dimension];
+        this->hamiltonian.apply(vector, this->hamiltonianTimesVector);
+        arma::cx_vec &residual = this->hamiltonianTimesVector;
+
+        double alpha = std::real(arma::cdot(vector, residual));
+        residual -= alpha * vector;
+        if (dimension > 0)
+            residual -= betas.back() * this->krylovVectors[dimension - 1];
+        for (std::size_t i{}; i <= dimension; i++)
+            residual -= arma::cdot(this->krylovVectors[i], residual) * this->krylovVectors[i];
+
+        alphas.push_back(alpha);
+        maxAbsAlpha = std::max(maxAbsAlpha, std::abs(alpha));
+        dimension++;
+        nextBeta = arma::norm(residual);
+        if (nextBeta <= BREAKDOWN_THRESHOLD * std::max(maxAbsAlpha, 1.)) {
+            nextBeta = 0;
+            break;
+        }
+        if (dimension < maxDimension) {
+            betas.push_back(nextBeta);
+            this->krylovVectors[dimension] = residual / nextBeta;
+        }
+    }
+
+    this->tridiagonalMatrix.zeros(dimension, dimension);
+    for (std::size_t i{}; i < dimension; i++) {
+        this->tridiagonalMatrix(i, i) = alphas[i];
+        if (i + 1 < dimension)
+            this->tridiagonalMatrix(i, i + 1) = this->tridiagonalMatrix(i + 1, i) = betas[i];
+    }
+    return dimension;
+}
+
+/**
+ * @brief Evolves this->currentState by this->dt, dividing it into adaptive substeps.
+ */
+void KrylovEvolver::performSubsteps() {
+    double timeLeft = this->dt;
+    std::size_t numSubsteps{};
+    while (timeLeft > 0) {
+        double norm = arma::norm(this->currentState);
+        double nextBeta{};
+        std::size_t dimension = this->buildKrylovSubspace(this->currentState, nextBeta);
+
+        arma::vec ritzValues;
+        arma::mat ritzVectors;
+        Assert(arma::eig_sym(ritzValues, ritzVectors, this->tridiagonalMatrix));
+        arma::cx_mat complexRitzVectors = arma::conv_to<arma::cx_mat>::from(ritzVectors);
+        arma::cx_vec firstComponents = complexRitzVectors.row(0).st();
+
+        // Shrink the substep until the error estimate is satisfactory. For invariant subspace the result is exact
+        double h = std::min(this->substepLength, timeLeft);
+        bool cutByStepEnd = (h < this->substepLength);
+        bool shrunk = false;
+        arma::cx_vec coefficients;
+        double error{};
+        double allowedError{};
+        do {
+            arma::cx_vec phases = arma::exp(-1i * h * ritzValues);
+            coefficients = complexRitzVectors * (phases % firstComponents);
+            error = norm * nextBeta * std::abs(coefficients[dimension - 1]);
+            allowedError = MAXIMAL_ERROR * h / this->dt;
+            if (error > allowedError) {
+                h *= std::max(0.1, STEP_SAFETY_FACTOR * std::pow(allowedError / error, 1. / dimension));
+                shrunk = true;
+            }
+            Assert(h > 0);
+        } while (error > allowedError);
+
+        this->currentState.zeros();
+        for (std::size_t i{}; i < dimension; i++)
+            this->currentState += (norm * coefficients[i]) * this->krylovVectors[i];
+
+        // Propose the next substep length: the shrunk one if it had to be shrunk, a longer one if the error is well
+        // below the allowed one. The substep cut by the end of dt does not say anything, so the length is kept then
+        if (shrunk) {
+            this->substepLength = h;
+        } else if (!cutByStepEnd) {
+            double growth = MAX_STEP_GROWTH;
+            if (error > 0)
+                growth = STEP_SAFETY_FACTOR * std::pow(allowedError / error, 1. / dimension);
+            this->substepLength = std::min(h * std::clamp(growth, 1., MAX_STEP_GROWTH), this->dt);
+        }
+
+        timeLeft -= h;
+        if (timeLeft < this->dt * 1e-12)
+            timeLeft = 0;
+        numSubsteps++;
+    }
+    this->logger.verbose() << "Krylov step done in " << numSubsteps << " substeps." << std::endl;
+}
+
+void KrylovEvolver::evolve() {
+    // Actually this->currentStep == this->steps here will give 1 step too much, but do not throw for convenience of use
+    Assert(this->currentStep <= this->maxSteps);
+    this->currentStep++;
+    this->t += this->dt;
+
+    this->performSubsteps();
+}
+
+const arma::cx_vec &KrylovEvolver::getCurrentState() const {
+    return this->currentState;
+}
+
+double KrylovEvolver::getDt() const {
+    return this->dt;
+}
@@ -0,0 +1,67 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#ifndef MBL_ED_KRYLOVEVOLVER_H
+#define MBL_ED_KRYLOVEVOLVER_H
+
+#include <vector>
+
+#include "Evolver.h"
+
+#include "core/HamiltonianOperator.h"
+#include "utils/Logger.h"
+
+/**
+ * @brief Evolver approximating \f$ e^{-iHt}|\psi\rangle \f$ in the Krylov subspace built by Lanczos iteration.
+ * @details <p> For the state \f$ |\psi\rangle \f$, Lanczos iteration gives orthonormal Krylov vectors \f$ V_m \f$ and
+ * tridiagonal \f$ T_m \f$, and \f$ e^{-iHh}|\psi\rangle \approx \| \psi \| V_m e^{-iT_m h} e_1 \f$. The exponential of
+ * a small \f$ T_m \f$ is computed by its diagonalization.
+ * <p> Each step by dt is divided into substeps of adaptive length h. The a posteriori error of a substep is estimated
+ * as \f$ \| \psi \| \beta_{m+1} |e_m^T e^{-iT_m h} e_1| \f$ - if it exceeds the fraction h/dt of MAXIMAL_ERROR, h is
+ * reduced using the same Krylov basis. The next substep length is adjusted based on the error, so the evolver settles
+ * at the largest steps allowed by the required precision.
+ * <p> Contrary to ChebyshevEvolver, spectrum bounds are not needed. The hamiltonian is used only via its action on
+ * vectors, and MAX_KRYLOV_DIMENSION vectors of the size of the state are stored.
+ */
+class KrylovEvolver : public Evolver {
+private:
+    static constexpr double MAXIMAL_ERROR = 1e-12;
+    static constexpr std::size_t MAX_KRYLOV_DIMENSION = 30;
+    static constexpr double BREAKDOWN_THRESHOLD = 1e-13;
+    static constexpr double STEP_SAFETY_FACTOR = 0.9;
+    static constexpr double MAX_STEP_GROWTH = 2;
+
+    const HamiltonianOperator &hamiltonian;
+    arma::cx_vec currentState;
+    double t{};
+    double dt{};
+    double substepLength{};
+    std::size_t currentStep{};
+    std::size_t maxSteps{};
+    Logger &logger;
+
+    // Lanczos workspace, allocated once in prepareFor()
+    std::vector<arma::cx_vec> krylovVectors;
+    arma::cx_vec hamiltonianTimesVector;
+    arma::mat tridiagonalMatrix;
+
+    std::size_t buildKrylovSubspace(const arma::cx_vec &state, double &nextBeta);
+    void performSubsteps();
+
+public:
+    /**
+     * @brief Constructs the evolver which will be using given @a hamiltonian
+     * @details The evolver only acts with @a hamiltonian on vectors, so it works both with the sparse matrix and
+     * matrix-free hamiltonians. @a hamiltonian has to outlive the evolver.
+     */
+    KrylovEvolver(const HamiltonianOperator &hamiltonian, Logger &logger);
+
+    void prepareFor(const arma::cx_vec &initialState, double maxTime, std::size_t maxSteps_) override;
+    void evolve() override;
+    [[nodiscard]] const arma::cx_vec &getCurrentState() const override;
+    [[nodiscard]] double getDt() const override;
+};
+
+
+#endif //MBL_ED_KRYLOVEVOLVER_H
@@ -5,6 +5,9 @@
 #include "OservablesTimeEvolution.h"
 
 #include <utility>
+#include <complex>
+
+#include "utils/Assertions.h"
 
 std::vector<TimeEvolutionEntry>
 OservablesTimeEvolution::perform(const std::vector<EvolutionTimeSegment> &timeSegmentation,
@@ -37,6 +40,57 @@ OservablesTimeEvolution::perform(const std::vector<EvolutionTimeSegment> &timeSe
     return observablesEvolution;
 }
 
+std::vector<std::vector<TimeEvolutionEntry>>
+OservablesTimeEvolution::performBlock(const std::vector<EvolutionTimeSegment> &timeSegmentation,
+                                      const arma::cx_mat &initialStates, Evolver &evolver, Logger &logger)
+{
+    Expects(evolver.supportsBlockEvolution());
+
+    this->timeStep = 0;
+    this->time = 0;
+
+    arma::cx_mat evolvedStates = initialStates;
+
+    std::vector<std::vector<TimeEvolutionEntry>> observablesEvolutions(initialStates.n_cols);
+    double lastMaxTime{};
+    for (const auto &timeSegment : timeSegmentation) {
+        logger.verbose() << "Calculating evolution operator... " << std::endl;
+        arma::wall_clock timer;
+        timer.tic();
+        evolver.prepareForBlock(evolvedStates, timeSegment.maxTime - lastMaxTime, timeSegment.numSteps);
+        logger.info() << "Calculating evolution operator done (" << timer.toc() << " s).";
+        logger << std::endl;
+
+        this->performBlockTimeSegmentEvolution(timeSegment.numSteps, evolver, logger, observablesEvolutions);
+        evolvedStates = evolver.getCurrentStates();
+        lastMaxTime = timeSegment.maxTime;
+    }
+    this->performBlockTimeSegmentEvolution(1, evolver, logger, observablesEvolutions);
+
+    return observablesEvolutions;
+}
+
+/**
+ * @brief Calculates all observables for @a state and returns the entry with stored ones for the current time.
+ */
+TimeEvolutionEntry OservablesTimeEvolution::calculateEntry(const arma::cx_vec &state) {
+    for (auto &primaryObservable : this->primaryObservables)
+        primaryObservable->calculateForState(state);
+    for (auto &secondaryObservable : this->secondaryObservables)
+        secondaryObservable->calculateForObservables(this->primaryObservables);
+
+    TimeEvolutionEntry entry(this->time, this->numOfObservableValues);
+    std::vector<double> observableValues;
+    observableValues.reserve(this->numOfObservableValues);
+    for (const auto &storedObservable : this->storedObservables) {
+        auto singleObservableValues = storedObservable->getValues();
+        observableValues.insert(observableValues.end(), singleObservableValues.begin(),
+                                singleObservableValues.end());
+    }
+    entry.addValues(observableValues);
+    return entry;
+}
+
 /**
  * @brief Based on the prepared evolution operator and observavles, do the actual evolution of a single time segment
  * with a constant time step.
@@ -51,22 +105,7 @@ OservablesTimeEvolution::performTimeSegmentEvolution(std::size_t numSteps, Evolv
         logger << std::endl;
 
         timer.tic();
-
-        for (auto &primaryObservable : this->primaryObservables)
-            primaryObservable->calculateForState(evolver.getCurrentState());
-        for (auto &secondaryObservable : this->secondaryObservables)
-            secondaryObservable->calculateForObservables(this->primaryObservables);
-
-        TimeEvolutionEntry entry(this->time, this->numOfObservableValues);
-        std::vector<double> observableValues;
-        observableValues.reserve(this->numOfObservableValues);
-        for (const auto &storedObservable : this->storedObservables) {
-            auto singleObservableValues = storedObservable->getValues();
-            observableValues.insert(observableValues.end(), singleObservableValues.begin(),
-                                    singleObservableValues.end());
-        }
-        entry.addValues(observableValues);
-        observablesEvolution.push_back(entry);
+        observablesEvolution.push_back(this->calculateEntry(evolver.getCurrentState()));
         double observablesTime = timer.toc();
 
         timer.tic();
@@ -82,6 +121,42 @@ OservablesTimeEvolution::performTimeSegmentEvolution(std::size_t numSteps, Evolv
     return observablesEvolution;
 }
 
+/**
+ * @brief The same as performTimeSegmentEvolution(), but for all states from the block evolution. The entries for
+ * subsequent steps are appended to @a observablesEvolutions, one vector per state.
+ */
+void OservablesTimeEvolution::performBlockTimeSegmentEvolution(
+        std::size_t numSteps, Evolver &evolver, Logger &logger,
+        std::vector<std::vector<TimeEvolutionEntry>> &observablesEvolutions)
+{
+    arma::wall_clock timer;
+    for (std::size_t timeIdx{}; timeIdx < numSteps; timeIdx++) {
+        logger.verbose() << "Calculating step " << this->timeStep << ", time " << this->time << " started...";
+        logger << std::endl;
+
+        timer.tic();
+        const arma::cx_mat &states = evolver.getCurrentStates();
+        Assert(states.n_cols == observablesEvolutions.size());
+        for (std::size_t stateIdx{}; stateIdx < states.n_cols; stateIdx++) {
+            // Column is aliased instead of copied into a temporary vector at each step
+            const arma::cx_vec state(const_cast<std::complex<double>*>(states.colptr(stateIdx)), states.n_rows, false,
+                                     true);
+            observablesEvolutions[stateIdx].push_back(this->calculateEntry(state));
+        }
+        double observablesTime = timer.toc();
+
+        timer.tic();
+        evolver.evolve();
+        double evolutionTime = timer.toc();
+
+        logger.info() << "Calculating step " << this->timeStep << ", time " << this->time << " done (observables: ";
+        logger << observablesTime << " s, block state evolution: " << evolutionTime << " s)." << std::endl;
+
+        this->timeStep++;
+        this->time += evolver.getDt();
+    }
+}
+
 void OservablesTimeEvolution::setStoredObservables(const std::vector<std::shared_ptr<Observable>> &storedObservables_) {
     this->storedObservables = storedObservables_;
     this->numOfObservableValues = 0;
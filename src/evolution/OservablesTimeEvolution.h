@@ -34,6 +34,9 @@ private:
 
     [[nodiscard]] std::vector<TimeEvolutionEntry> performTimeSegmentEvolution(std::size_t numSteps, Evolver &evolver,
                                                                               Logger &logger);
+    void performBlockTimeSegmentEvolution(std::size_t numSteps, Evolver &evolver, Logger &logger,
+                                          std::vector<std::vector<TimeEvolutionEntry>> &observablesEvolutions);
+    [[nodiscard]] TimeEvolutionEntry calculateEntry(const arma::cx_vec &state);
 
 public:
     virtual ~OservablesTimeEvolution() = default;
@@ -67,6 +70,17 @@ public:
     [[nodiscard]] virtual std::vector<TimeEvolutionEntry>
     perform(const std::vector<EvolutionTimeSegment> &timeSegmentation, const arma::cx_vec &initialState,
             Evolver &evolver, Logger &logger);
+
+    /**
+     * @brief Block version of perform(): all columns of @a initialStates are evolved simultaneously.
+     * @details @a evolver has to support the block evolution (see Evolver::prepareForBlock()). The observables are
+     * still calculated for each state separately.
+     * @return The vector of the results for all columns of @a initialStates, each one of the same form as from
+     * perform().
+     */
+    [[nodiscard]] virtual std::vector<std::vector<TimeEvolutionEntry>>
+    performBlock(const std::vector<EvolutionTimeSegment> &timeSegmentation, const arma::cx_mat &initialStates,
+                 Evolver &evolver, Logger &logger);
 };
 
 
@@ -13,29 +13,59 @@
 void TimeEvolution::addEvolution(Evolver &evolver, Logger &logger, const std::vector<arma::cx_vec> &externalVectors) {
     Expects(externalVectors.size() == this->countExternalVectors());
 
-    std::size_t externalVectorsCounter{};
-    for (auto &evolution : this->vectorEvolutions) {
-        arma::cx_vec initialState;
+    std::vector<arma::cx_vec> initialStates = this->prepareInitialStates(externalVectors);
+    auto addObservablesEvolution = [](VectorEvolution &evolution, const auto &observablesEvolution) {
+        Assert(observablesEvolution.size() == evolution.timeEntries.size());
+        std::transform(evolution.timeEntries.begin(), evolution.timeEntries.end(), observablesEvolution.begin(),
+                       evolution.timeEntries.begin(), std::plus{});
+    };
+
+    if (this->blockEvolution && evolver.supportsBlockEvolution()) {
+        logger.info() << "Evolving " << initialStates.size() << " vectors simultaneously" << std::endl;
+        arma::cx_mat initialStatesBlock(this->fockBasis->size(), initialStates.size());
+        for (std::size_t i{}; i < initialStates.size(); i++)
+            initialStatesBlock.col(i) = initialStates[i];
+
+        auto observablesEvolutions = this->occupationEvolution->performBlock(this->timeSegmentation,
+                                                                             initialStatesBlock, evolver, logger);
+        Assert(observablesEvolutions.size() == this->vectorEvolutions.size());
+        for (std::size_t i{}; i < this->vectorEvolutions.size(); i++)
+            addObservablesEvolution(this->vectorEvolutions[i], observablesEvolutions[i]);
+        return;
+    }
 
+    for (std::size_t i{}; i < this->vectorEvolutions.size(); i++) {
+        auto &evolution = this->vectorEvolutions[i];
+        logger.info() << "Evolving vector " << evolution.getInitialVectorName() << std::endl;
+        auto observablesEvolution = this->occupationEvolution->perform(this->timeSegmentation, initialStates[i],
+                                                                       evolver, logger);
+        addObservablesEvolution(evolution, observablesEvolution);
+    }
+}
+
+/**
+ * @brief Returns initial states for all TimeEvolution::vectorEvolutions, taking ExternalVector -s from
+ * @a externalVectors in order.
+ */
+std::vector<arma::cx_vec> TimeEvolution::prepareInitialStates(const std::vector<arma::cx_vec> &externalVectors) const {
+    std::vector<arma::cx_vec> initialStates;
+    initialStates.reserve(this->vectorEvolutions.size());
+    std::size_t externalVectorsCounter{};
+    for (const auto &evolution : this->vectorEvolutions) {
         if (std::holds_alternative<FockBasis::Vector>(evolution.initialVector)) {
             FockBasis::Vector initialFockVector = std::get<FockBasis::Vector>(evolution.initialVector);
             auto initialIdx = this->fockBasis->findIndex(initialFockVector);
             Assert(initialIdx.has_value());
-            initialState = arma::cx_vec(this->fockBasis->size(), arma::fill::zeros);
+            arma::cx_vec initialState(this->fockBasis->size(), arma::fill::zeros);
             initialState[*initialIdx] = 1;
+            initialStates.push_back(std::move(initialState));
         } else {    // holds alternative ExternalVector
             Assert(externalVectorsCounter < externalVectors.size());
-            initialState = externalVectors[externalVectorsCounter];
+            initialStates.push_back(externalVectors[externalVectorsCounter]);
             externalVectorsCounter++;
         }
-
-        logger.info() << "Evolving vector " << evolution.getInitialVectorName() << std::endl;
-        auto observablesEvolution = this->occupationEvolution->perform(this->timeSegmentation, initialState, evolver,
-                                                                       logger);
-        Assert(observablesEvolution.size() == evolution.timeEntries.size());
-        std::transform(evolution.timeEntries.begin(), evolution.timeEntries.end(), observablesEvolution.begin(),
-                       evolution.timeEntries.begin(), std::plus{});
     }
+    return initialStates;
 }
 
 void TimeEvolution::storeResult(std::ostream &out) const {
@@ -57,7 +87,7 @@ void TimeEvolution::storeResult(std::ostream &out) const {
 TimeEvolution::TimeEvolution(const TimeEvolutionParameters &parameters,
                              std::unique_ptr<OservablesTimeEvolution> occupationEvolution)
         : fockBasis{parameters.fockBasis}, occupationEvolution{std::move(occupationEvolution)},
-          timeSegmentation{parameters.timeSegmentation}
+          timeSegmentation{parameters.timeSegmentation}, blockEvolution{parameters.blockEvolution}
 {
     Expects(!parameters.vectorsToEvolve.empty());
 
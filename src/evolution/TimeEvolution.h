@@ -45,6 +45,10 @@ private:
     std::unique_ptr<OservablesTimeEvolution> occupationEvolution;
     std::vector<VectorEvolution> vectorEvolutions{};
     std::vector<EvolutionTimeSegment> timeSegmentation{};
+    bool blockEvolution{};
+
+    [[nodiscard]] std::vector<arma::cx_vec>
+    prepareInitialStates(const std::vector<arma::cx_vec> &externalVectors) const;
 
 public:
     /**
@@ -61,6 +65,8 @@ public:
      * averaged will the old ones. If field @a initialVectors from @a parameters from the constructor contained some
      * TimeEvolutionParameters::ExternalVector alternatives, the actual arma::cx_vec vectors should be passed through
      * @a externalVectors. The rest are FockBasis::Vectors product vectors and are prepared on the go.
+     * <p> If TimeEvolutionParameters::blockEvolution was set and @a evolver supports it, all vectors are evolved at
+     * once using OservablesTimeEvolution::performBlock().
      */
     void addEvolution(Evolver &evolver, Logger &logger, const std::vector<arma::cx_vec> &externalVectors = {});
 
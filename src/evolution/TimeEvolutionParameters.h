@@ -60,6 +60,12 @@ struct TimeEvolutionParameters {
      */
     std::vector<std::shared_ptr<Observable>> storedObservables;
 
+    /**
+     * @brief If true, all vectors to evolve are evolved simultaneously, provided that the Evolver supports it (see
+     * Evolver::prepareForBlock()).
+     */
+    bool blockEvolution{};
+
     /**
      * @brief Constructs CorrelationsTimeEvolutionParameters::vectorsToEvolve from a string.
      * @details It can be either a tag
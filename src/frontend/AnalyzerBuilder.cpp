@@ -217,10 +217,10 @@ std::unique_ptr<Analyzer> AnalyzerBuilder::build(const std::vector<std::string>
         taskStream >> taskName;
         if (taskName == "mgr") {
             auto band = parse_band(params.K, fockBasis->size(), taskStream, "mgr");
-            analyzer->addTask(std::make_unique<MeanGapRatio>(band));
+            analyzer->addTask(std::make_unique<MeanGapRatio>(band, params.streamStatistics));
         } else if (taskName == "mipr") {
             auto band = parse_band(params.K, fockBasis->size(), taskStream, "mipr");
-            analyzer->addTask(std::make_unique<MeanInverseParticipationRatio>(band));
+            analyzer->addTask(std::make_unique<MeanInverseParticipationRatio>(band, params.streamStatistics));
         } else if (taskName == "ipr") {
             auto band = parse_band(params.K, fockBasis->size(), taskStream, "ipr");
             analyzer->addTask(std::make_unique<InverseParticipationRatio>(band));
@@ -229,13 +229,13 @@ std::unique_ptr<Analyzer> AnalyzerBuilder::build(const std::vector<std::string>
             taskStream >> bins;
             ValidateMsg(taskStream, "Wrong format, use: cdf [number of bins]");
             Validate(bins >= 2);
-            analyzer->addTask(std::make_unique<CDF>(bins));
+            analyzer->addTask(std::make_unique<CDF>(bins, params.streamStatistics));
         } else if (taskName == "pdf") {
             std::size_t bins;
             taskStream >> bins;
             ValidateMsg(taskStream, "Wrong format, use: pdf [number of bins]");
             Validate(bins >= 2);
-            analyzer->addTask(std::make_unique<PDF>(bins));
+            analyzer->addTask(std::make_unique<PDF>(bins, params.streamStatistics));
         } else if (taskName == "evolution") {
             analyzer->addTask(build_evolution_task(params, task, fockBasis, hamiltonianGenerator));
         } else if (taskName == "dressed") {
@@ -250,7 +250,7 @@ std::unique_ptr<Analyzer> AnalyzerBuilder::build(const std::vector<std::string>
             taskStream >> numBins;
             ValidateMsg(taskStream, "Wrong format, use: mgrs [number of bins]");
             Validate(numBins > 0);
-            analyzer->addTask(std::make_unique<BulkMeanGapRatio>(numBins));
+            analyzer->addTask(std::make_unique<BulkMeanGapRatio>(numBins, params.streamStatistics));
         } else if (taskName == "obs") {
             bool store{};
             if (taskStream.str().find("store") != std::string::npos) {
@@ -272,7 +272,7 @@ std::unique_ptr<Analyzer> AnalyzerBuilder::build(const std::vector<std::string>
             builder.build(observablesParams, params, fockBasis, hamiltonianGenerator);
             auto eigenstateObservables = std::make_unique<EigenstateObservables>(
                 numBins, builder.releasePrimaryObservables(), builder.releaseSecondaryObservables(),
-                builder.releaseStoredObservables()
+                builder.releaseStoredObservables(), params.streamStatistics
             );
             if (store)
                 eigenstateObservables->startStoringObservables(auxiliaryDir / params.getOutputFileSignature());
@@ -282,7 +282,7 @@ std::unique_ptr<Analyzer> AnalyzerBuilder::build(const std::vector<std::string>
             taskStream >> q;
             Validate(q > 0);
             auto band = parse_band(params.K, fockBasis->size(), taskStream,"pe [q parameter]");
-            analyzer->addTask(std::make_unique<ParticipationEntropy>(q, band));
+            analyzer->addTask(std::make_unique<ParticipationEntropy>(q, band, params.streamStatistics));
         } else {
             throw ValidationException("Unknown analyzer task: " + taskName);
         }
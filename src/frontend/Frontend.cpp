@@ -45,6 +45,7 @@ void Frontend::ed(int argc, char **argv) {
     std::vector<std::string> onTheFlyTasks;
     std::vector<std::string> overridenParams;
     std::string verbosity;
+    std::size_t numWorkers{};
 
     options.add_options()
             ("h,help", "prints help for this mode")
@@ -65,6 +66,14 @@ void Frontend::ed(int argc, char **argv) {
                             "-P N=1 (-PN=1 does not work) act as one would append N=1 to [general] section of input"
                             "file. To override or even add some hamiltonian terms use -P termName.paramName=value",
              cxxopts::value<std::vector<std::string>>(overridenParams))
+            ("w,workers", "the number of simulations performed at once in separate threads, each using a single "
+                          "OpenMP thread. It pays off for small systems, where multithreaded BLAS does not scale. Each "
+                          "simulation uses its own random stream, so the results do not depend on the number of "
+                          "workers. Storing eigenstate observables (obs store) is not supported",
+             cxxopts::value<std::size_t>(numWorkers)->default_value("1"))
+            ("l,pipeline", "generate and diagonalize the next simulation in the background, while the current one is "
+                           "analyzed and its eigensystem is stored. It requires memory for two eigensystems and two "
+                           "Hamiltonians and it is not supported for more than 1 worker")
             ("V,verbosity", "how verbose the output should be. Allowed values, with increasing verbosity: "
                             "error, warn, info, verbose, debug",
              cxxopts::value<std::string>(verbosity)->default_value("info"));
@@ -87,6 +96,16 @@ void Frontend::ed(int argc, char **argv) {
         die("Input file must be specified with option -i [input file name]", logger);
     if (!std::filesystem::exists(directory) || !std::filesystem::is_directory(directory))
         die("Output directory " + directory.string() + " does not exist or is not a directory", logger);
+    if (numWorkers == 0)
+        die("Number of workers must be positive", logger);
+    if (numWorkers > 1) {
+        for (const auto &task : onTheFlyTasks)
+            if (task.rfind("obs", 0) == 0 && task.find("store") != std::string::npos)
+                die("Storing eigenstate observables is not supported for more than 1 worker", logger);
+    }
+    bool pipelined = parsedOptions.count("pipeline");
+    if (pipelined && numWorkers > 1)
+        die("Pipeline is not supported for more than 1 worker", logger);
 
     // Prepare parameters
     IO io(logger);
@@ -108,16 +127,30 @@ void Frontend::ed(int argc, char **argv) {
     auto basis = std::shared_ptr<FockBasis>(basisGenerator.generate(params.N, params.K));
     logger.info() << "Preparing Fock basis done (" << timer.toc() << " s)." << std::endl;
 
-    // Prepare HamiltonianGenerator, Analyzer and AveragingModel
-    auto rnd = std::make_unique<RND>();
-    auto hamiltonianGenerator = HamiltonianGeneratorBuilder{}.build(params, basis, *rnd);
-    auto analyzer = AnalyzerBuilder{}.build(onTheFlyTasks, params, basis, *hamiltonianGenerator, directory);
-    auto averagingModel = AveragingModelFactory{}.create(params.averagingModel);
+    // Prepare HamiltonianGenerator, Analyzer and AveragingModel - separately for each parallel worker
+    ExactDiagonalizationParameters simulationParams = this->prepareExactDiagonalizationParameters(directory, params);
+    simulationParams.pipelined = pipelined;
+    auto createSimulation = [&]() {
+        auto rnd = std::make_unique<RND>();
+        auto hamiltonianGenerator = HamiltonianGeneratorBuilder{}.build(params, basis, *rnd);
+        auto analyzer = AnalyzerBuilder{}.build(onTheFlyTasks, params, basis, *hamiltonianGenerator, directory);
+        auto averagingModel = AveragingModelFactory{}.create(params.averagingModel);
+        auto simulation = std::make_unique<ExactDiagonalization<>>(std::move(hamiltonianGenerator),
+                                                                   std::move(averagingModel), std::move(rnd),
+                                                                   simulationParams, std::move(analyzer));
+        if (pipelined) {
+            // The next realisation is prepared on separate objects, so nothing is shared with the analysis
+            auto pipelineRnd = std::make_unique<RND>();
+            auto pipelineHamiltonianGenerator = HamiltonianGeneratorBuilder{}.build(params, basis, *pipelineRnd);
+            simulation->setPipelineResources(std::move(pipelineHamiltonianGenerator),
+                                             AveragingModelFactory{}.create(params.averagingModel),
+                                             std::move(pipelineRnd));
+        }
+        return simulation;
+    };
 
     // Prepare and run simulations
-    ExactDiagonalizationParameters simulationParams = this->prepareExactDiagonalizationParameters(directory, params);
-    ExactDiagonalization simulation(std::move(hamiltonianGenerator), std::move(averagingModel), std::move(rnd),
-                                    simulationParams, std::move(analyzer));
+    auto simulation = createSimulation();
 
     SimulationsSpan simulationsSpan;
     simulationsSpan.from = params.from;
@@ -125,11 +158,19 @@ void Frontend::ed(int argc, char **argv) {
     simulationsSpan.total = params.totalSimulations;
     RestorableSimulationExecutor restorableSimulationExecutor(simulationsSpan, params.getOutputFileSignatureWithRange(),
                                                               params.splitWorkload, params.secureSimulationState);
-    restorableSimulationExecutor.performSimulations(simulation, params.seed, logger);
+    restorableSimulationExecutor.setDynamicScheduling(params.schedulerChunkSize,
+                                                      std::chrono::seconds(params.schedulerClaimTimeout));
+    if (numWorkers > 1) {
+        logger.info() << "Using " << numWorkers << " parallel workers" << std::endl;
+        restorableSimulationExecutor.setParallelWorkers(numWorkers, [&createSimulation]() {
+            return std::unique_ptr<RestorableSimulation>(createSimulation());
+        });
+    }
+    restorableSimulationExecutor.performSimulations(*simulation, params.seed, logger);
 
     // Save results
     if (restorableSimulationExecutor.shouldSaveSimulation()) {
-        const Analyzer &analyzerRef = simulation.getAnalyzer();
+        const Analyzer &analyzerRef = simulation->getAnalyzer();
         io.printInlineResults(params, paramsToPrint, analyzerRef.getInlineResultsHeader(),
                               analyzerRef.getInlineResultsFields());
         if (outputFilename.empty())
@@ -165,6 +206,15 @@ ExactDiagonalizationParameters Frontend::prepareExactDiagonalizationParameters(c
     else
         throw ValidationException("Unknown store format: " + params.storeFormat);
 
+    if (params.eigensolver == "dense")
+        simulationParams.eigensolver = ExactDiagonalizationParameters::Eigensolver::DENSE;
+    else if (params.eigensolver == "polfed")
+        simulationParams.eigensolver = ExactDiagonalizationParameters::Eigensolver::POLFED;
+    else
+        throw ValidationException("Unknown eigensolver: " + params.eigensolver);
+    simulationParams.polfedEpsilon = params.polfedEpsilon;
+    simulationParams.polfedEigenpairs = params.polfedEigenpairs;
+
     simulationParams.fileSignature = directory / params.getOutputFileSignature();
     return simulationParams;
 }
@@ -333,7 +383,8 @@ void Frontend::validateEigensystemFiles(Logger &logger, const std::vector<std::s
 void Frontend::chebyshev(int argc, char **argv) {
     // Parse options
     cxxopts::Options options(argv[0],
-                             Fold("Performs evolution using Chebyshev expansion technique.").width(80));
+                             Fold("Performs evolution using Chebyshev expansion technique (or Krylov subspace "
+                                  "technique, see --krylov).").width(80));
 
     std::string inputFilename;
     std::vector<std::string> overridenParamsEntries;
@@ -368,6 +419,13 @@ void Frontend::chebyshev(int argc, char **argv) {
                                 "those specified by --vectors). This option overrides the param as in --set_param, "
                                 "applied after --set_param, but for the separate initial Hamiltonian in quantum quench",
              cxxopts::value<std::vector<std::string>>(quenchParamsEntries))
+            ("m,matrix_free", "when specified, Hamiltonians are not stored as sparse matrices, but their action on "
+                              "vectors is computed on the fly. It saves memory at the cost of speed")
+            ("k,krylov", "when specified, Lanczos (Krylov subspace) evolver with adaptive time steps is used instead "
+                         "of Chebyshev expansion. It does not need spectrum bounds and allows for larger time steps")
+            ("b,block", "when specified, all vectors (including the quenched one) are evolved simultaneously, so "
+                        "the hamiltonian is traversed once for all of them in each step. It uses more memory. Ignored "
+                        "together with --krylov")
             ("V,verbosity", "how verbose the output should be. Allowed values, with increasing verbosity: "
                             "error, warn, info, verbose, debug",
              cxxopts::value<std::string>(verbosity)->default_value("info"));
@@ -444,6 +502,7 @@ void Frontend::chebyshev(int argc, char **argv) {
     evolutionParams.numberOfSites = params.K;
     evolutionParams.fockBasis = basis;
     evolutionParams.setVectorsToEvolveFromTags(vectorsToEvolveTags); // This one also does the validation
+    evolutionParams.blockEvolution = parsedOptions.count("block");
 
     ObservablesBuilder observablesBuilder;
     observablesBuilder.build(observableStrings, params, basis, *hamiltonianGenerator);
@@ -459,7 +518,11 @@ void Frontend::chebyshev(int argc, char **argv) {
     simulationsSpan.total = params.totalSimulations;
     RestorableSimulationExecutor simulationExecutor(simulationsSpan, params.getOutputFileSignatureWithRange(),
                                                     params.splitWorkload, params.secureSimulationState);
+    simulationExecutor.setDynamicScheduling(params.schedulerChunkSize,
+                                            std::chrono::seconds(params.schedulerClaimTimeout));
 
+    bool matrixFree = parsedOptions.count("matrix_free");
+    bool krylov = parsedOptions.count("krylov");
     std::unique_ptr<ChebyshevEvolution<>> evolution;
     if (quenchParams.has_value()) {
         using ExternalVector = TimeEvolutionParameters::ExternalVector;
@@ -470,12 +533,13 @@ void Frontend::chebyshev(int argc, char **argv) {
         evolution = std::make_unique<ChebyshevEvolution<>>(
                 std::move(hamiltonianGenerator), std::move(averagingModel), std::move(rnd),
                 std::make_unique<TimeEvolution>(evolutionParams, std::move(observablesEvolution)),
-                std::make_unique<QuenchCalculator>(), std::move(quenchHamiltonianGenerator), std::move(quenchRnd)
+                std::make_unique<QuenchCalculator>(), std::move(quenchHamiltonianGenerator), std::move(quenchRnd),
+                matrixFree, krylov
         );
     } else {
         evolution = std::make_unique<ChebyshevEvolution<>>(
             std::move(hamiltonianGenerator), std::move(averagingModel), std::move(rnd),
-            std::make_unique<TimeEvolution>(evolutionParams, std::move(observablesEvolution))
+            std::make_unique<TimeEvolution>(evolutionParams, std::move(observablesEvolution)), matrixFree, krylov
         );
     }
 
@@ -519,6 +583,8 @@ void Frontend::quench(int argc, char **argv) {
             ("q,quench_param", "overrides the param as in --set_param, applied after --set_param, but for the initial"
                                "Hamiltonian in quantum quench",
              cxxopts::value<std::vector<std::string>>(quenchParamsEntries))
+            ("m,matrix_free", "when specified, Hamiltonians are not stored as sparse matrices, but their action on "
+                              "vectors is computed on the fly. It saves memory at the cost of speed")
             ("V,verbosity", "how verbose the output should be. Allowed values, with increasing verbosity: "
                             "error, warn, info, verbose, debug",
              cxxopts::value<std::string>(verbosity)->default_value("info"));
@@ -588,12 +654,15 @@ void Frontend::quench(int argc, char **argv) {
     simulationsSpan.total = params.totalSimulations;
     RestorableSimulationExecutor simulationExecutor(simulationsSpan, params.getOutputFileSignatureWithRange(),
                                                     params.splitWorkload, params.secureSimulationState);
+    simulationExecutor.setDynamicScheduling(params.schedulerChunkSize,
+                                            std::chrono::seconds(params.schedulerClaimTimeout));
 
     // Prepare and run quenches
+    bool matrixFree = parsedOptions.count("matrix_free");
     auto quenchCalculator = std::make_unique<QuenchCalculator>();
     QuenchDataSimulation simulation(std::move(initialHamiltonianGenerator), std::move(initialRnd),
                                     std::move(finalHamiltonianGenerator), std::move(finalRnd),
-                                    std::move(averagingModel), std::move(quenchCalculator));
+                                    std::move(averagingModel), std::move(quenchCalculator), matrixFree);
     simulationExecutor.performSimulations(simulation, params.seed, logger);
 
     // Save results
@@ -684,7 +753,7 @@ void Frontend::randomStates(int argc, char **argv) {
     observablesBuilder.build(observableStrings, params, basis, std::nullopt);
     RandomStateObservables simulation(std::move(rnd), std::move(basis), observablesBuilder.releasePrimaryObservables(),
                                       observablesBuilder.releaseSecondaryObservables(),
-                                      observablesBuilder.releaseStoredObservables());
+                                      observablesBuilder.releaseStoredObservables(), params.streamStatistics);
 
     SimulationsSpan simulationsSpan;
     simulationsSpan.from = params.from;
@@ -692,6 +761,8 @@ void Frontend::randomStates(int argc, char **argv) {
     simulationsSpan.total = params.totalSimulations;
     RestorableSimulationExecutor restorableSimulationExecutor(simulationsSpan, params.getOutputFileSignatureWithRange(),
                                                               params.splitWorkload, params.secureSimulationState);
+    restorableSimulationExecutor.setDynamicScheduling(params.schedulerChunkSize,
+                                                      std::chrono::seconds(params.schedulerClaimTimeout));
     restorableSimulationExecutor.performSimulations(simulation, params.seed, logger);
 
     // Save results
@@ -792,7 +863,7 @@ void Frontend::printGeneralHelp(const std::string &cmd) {
     this->out << Fold("Performs one or more analyzer tasks after loading simulation results from the files.")
                  .width(80).margin(4) << std::endl;
     this->out << "chebyshev" << std::endl;
-    this->out << Fold("Performs time evolution using Chebyshev expansion technique.")
+    this->out << Fold("Performs time evolution using Chebyshev expansion (or Krylov subspace) technique.")
                  .width(80).margin(4) << std::endl;
     this->out << "quench" << std::endl;
     this->out << Fold("Performs quantum quench from some initial to final Hamiltonian and print energy info.")
@@ -42,13 +42,44 @@ namespace {
 
         return std::make_unique<HubbardHop>(distances, Js);
     }
+
+    std::unique_ptr<LookupCavityZ2> make_lookup_cavity_z2(double U1, const CavityConstants &cavityConstants,
+                                                          std::shared_ptr<CavityZCache> zCache)
+    {
+        auto lookupCavityZ2 = std::make_unique<LookupCavityZ2>(U1, cavityConstants);
+        lookupCavityZ2->enableZCache(std::move(zCache));
+        return lookupCavityZ2;
+    }
+
+    std::unique_ptr<LookupCavityYZ> make_lookup_cavity_yz(double U1, const CavityConstants &cavityConstants,
+                                                          std::shared_ptr<CavityZCache> zCache)
+    {
+        auto lookupCavityYZ = std::make_unique<LookupCavityYZ>(U1, cavityConstants);
+        lookupCavityYZ->enableZCache(std::move(zCache));
+        return lookupCavityYZ;
+    }
 }
 
 std::unique_ptr<HamiltonianGenerator>
 HamiltonianGeneratorBuilder::build(const Parameters &params, std::shared_ptr<FockBasis> fockBasis, RND &rnd)
 {
     std::size_t numberOfSites = fockBasis->getNumberOfSites();
-    auto generator = std::make_unique<HamiltonianGenerator>(fockBasis, params.usePeriodicBC);
+    auto generator = std::make_unique<HamiltonianGenerator>(fockBasis, params.usePeriodicBC,
+                                                            params.reuseHamiltonianStructure);
+    if (params.symmetrySectors == "none")
+        generator->setSymmetrySectorsMode(HamiltonianGenerator::SymmetrySectorsMode::NONE);
+    else if (params.symmetrySectors == "declared")
+        generator->setSymmetrySectorsMode(HamiltonianGenerator::SymmetrySectorsMode::DECLARED);
+    else
+        generator->setSymmetrySectorsMode(HamiltonianGenerator::SymmetrySectorsMode::DETECT);
+
+    // A single Z cache is shared by all cavity terms, so Z values are computed once per realisation
+    std::shared_ptr<CavityZCache> zCache;
+    auto getZCache = [&zCache, &generator]() {
+        if (zCache == nullptr)
+            zCache = std::make_shared<CavityZCache>(*generator);
+        return zCache;
+    };
 
     for (auto &term : params.hamiltonianTerms) {
         std::string termName = term.first;
@@ -98,7 +129,7 @@ HamiltonianGeneratorBuilder::build(const Parameters &params, std::shared_ptr<Foc
             if (!cavityConstantsFile)
                 throw std::runtime_error("Cannot open " + cavityConstantsFilename + " to read cavity constants");
             CavityConstants cavityConstants = CavityConstantsReader::load(cavityConstantsFile);
-            generator->addDiagonalTerm(std::make_unique<LookupCavityZ2>(U1, cavityConstants));
+            generator->addDiagonalTerm(make_lookup_cavity_z2(U1, cavityConstants, getZCache()));
         } else if (termName == "lookupCavityYZ") {
             double U1 = termParams.getDouble("U1");
             Validate(U1 >= 0);
@@ -107,7 +138,7 @@ HamiltonianGeneratorBuilder::build(const Parameters &params, std::shared_ptr<Foc
             if (!cavityConstantsFile)
                 throw std::runtime_error("Cannot open " + cavityConstantsFilename + " to read cavity constants");
             CavityConstants cavityConstants = CavityConstantsReader::load(cavityConstantsFile);
-            generator->addHoppingTerm(std::make_unique<LookupCavityYZ>(U1, cavityConstants));
+            generator->addHoppingTerm(make_lookup_cavity_yz(U1, cavityConstants, getZCache()));
         } else if (termName == "lookupCavityY2") {
             double U1 = termParams.getDouble("U1");
             Validate(U1 >= 0);
@@ -125,8 +156,8 @@ HamiltonianGeneratorBuilder::build(const Parameters &params, std::shared_ptr<Foc
             if (!cavityConstantsFile)
                 throw std::runtime_error("Cannot open " + cavityConstantsFilename + " to read cavity constants");
             CavityConstants cavityConstants = CavityConstantsReader::load(cavityConstantsFile);
-            generator->addDiagonalTerm(std::make_unique<LookupCavityZ2>(U1, cavityConstants));
-            generator->addHoppingTerm(std::make_unique<LookupCavityYZ>(U1, cavityConstants));
+            generator->addDiagonalTerm(make_lookup_cavity_z2(U1, cavityConstants, getZCache()));
+            generator->addHoppingTerm(make_lookup_cavity_yz(U1, cavityConstants, getZCache()));
         } else if (termName == "lookupCavityZ2_YZ_Y2") {
             double U1 = termParams.getDouble("U1");
             Validate(U1 >= 0);
@@ -135,8 +166,8 @@ HamiltonianGeneratorBuilder::build(const Parameters &params, std::shared_ptr<Foc
             if (!cavityConstantsFile)
                 throw std::runtime_error("Cannot open " + cavityConstantsFilename + " to read cavity constants");
             CavityConstants cavityConstants = CavityConstantsReader::load(cavityConstantsFile);
-            generator->addDiagonalTerm(std::make_unique<LookupCavityZ2>(U1, cavityConstants));
-            generator->addHoppingTerm(std::make_unique<LookupCavityYZ>(U1, cavityConstants));
+            generator->addDiagonalTerm(make_lookup_cavity_z2(U1, cavityConstants, getZCache()));
+            generator->addHoppingTerm(make_lookup_cavity_yz(U1, cavityConstants, getZCache()));
             generator->addDoubleHoppingTerm(std::make_unique<LookupCavityY2>(U1, cavityConstants));
         } else if (termName == "constantForce") {
             double F = termParams.getDouble("F");
@@ -47,6 +47,22 @@ Parameters::Parameters(std::istream &input) {
             this->splitWorkload = generalConfig.getBoolean("splitWorkload");
         else if (key == "secureSimulationState")
             this->secureSimulationState = generalConfig.getBoolean("secureSimulationState");
+        else if (key == "schedulerChunkSize")
+            this->schedulerChunkSize = generalConfig.getUnsignedLong("schedulerChunkSize");
+        else if (key == "schedulerClaimTimeout")
+            this->schedulerClaimTimeout = generalConfig.getUnsignedLong("schedulerClaimTimeout");
+        else if (key == "streamStatistics")
+            this->streamStatistics = generalConfig.getBoolean("streamStatistics");
+        else if (key == "symmetrySectors")
+            this->symmetrySectors = generalConfig.getString("symmetrySectors");
+        else if (key == "reuseHamiltonianStructure")
+            this->reuseHamiltonianStructure = generalConfig.getBoolean("reuseHamiltonianStructure");
+        else if (key == "eigensolver")
+            this->eigensolver = generalConfig.getString("eigensolver");
+        else if (key == "polfedEpsilon")
+            this->polfedEpsilon = generalConfig.getDouble("polfedEpsilon");
+        else if (key == "polfedEigenpairs")
+            this->polfedEigenpairs = generalConfig.getUnsignedLong("polfedEigenpairs");
         else
             throw ParametersParseException("Unknown parameter " + key);
     }
@@ -79,10 +95,25 @@ void Parameters::autocompleteAndValidate() {
     Validate(K > 0);
     if (this->splitWorkload)
         ValidateMsg(this->secureSimulationState, "If splitWorkoload = true, secureSimulationState should also be true");
+    if (this->schedulerChunkSize > 0) {
+        ValidateMsg(this->splitWorkload, "If schedulerChunkSize > 0, splitWorkload should be true");
+        ValidateMsg(this->schedulerClaimTimeout > 0, "schedulerClaimTimeout should be positive");
+    }
 
     ValidateMsg(!this->saveEigenstates || this->saveEigenenergies,
                 "Eigenstates cannot be stored without eigenenergies");
     ValidateMsg(!this->saveEigenstates || this->calculateEigenvectors, "Eigenvectors must be calculated to be stored");
+    ValidateMsg(this->symmetrySectors == "detect" || this->symmetrySectors == "declared"
+                || this->symmetrySectors == "none",
+                "symmetrySectors should be one of: detect, declared, none");
+    ValidateMsg(this->eigensolver == "dense" || this->eigensolver == "polfed",
+                "eigensolver should be one of: dense, polfed");
+    if (this->eigensolver == "polfed") {
+        ValidateMsg(this->polfedEpsilon > 0 && this->polfedEpsilon < 1, "polfedEpsilon should be in (0, 1)");
+        ValidateMsg(this->polfedEigenpairs > 0, "polfedEigenpairs should be positive");
+        ValidateMsg(this->calculateEigenvectors, "polfed eigensolver always calculates eigenvectors");
+        ValidateMsg(!this->saveEigenenergies, "Eigenenergies from polfed eigensolver cannot be stored");
+    }
 }
 
 void Parameters::printGeneral(std::ostream &out) const {
@@ -101,6 +132,18 @@ void Parameters::printGeneral(std::ostream &out) const {
     out << "seed                  : " << this->seed << std::endl;
     out << "splitWorkload         : " << (this->splitWorkload ? "true" : "false") << std::endl;
     out << "secureSimulationState : " << (this->secureSimulationState ? "true" : "false") << std::endl;
+    if (this->schedulerChunkSize > 0) {
+        out << "schedulerChunkSize    : " << this->schedulerChunkSize << std::endl;
+        out << "schedulerClaimTimeout : " << this->schedulerClaimTimeout << std::endl;
+    }
+    out << "streamStatistics      : " << (this->streamStatistics ? "true" : "false") << std::endl;
+    out << "symmetrySectors       : " << this->symmetrySectors << std::endl;
+    out << "reuseHamiltonianStructure : " << (this->reuseHamiltonianStructure ? "true" : "false") << std::endl;
+    out << "eigensolver           : " << this->eigensolver << std::endl;
+    if (this->eigensolver == "polfed") {
+        out << "polfedEpsilon         : " << this->polfedEpsilon << std::endl;
+        out << "polfedEigenpairs      : " << this->polfedEigenpairs << std::endl;
+    }
 }
 
 void Parameters::printHamiltonianTerms(std::ostream &out) const {
@@ -145,6 +188,22 @@ std::string Parameters::getByName(const std::string &name) const {
         return std::to_string(this->splitWorkload);
     else if (name == "secureSimulationState")
         return std::to_string(this->secureSimulationState);
+    else if (name == "schedulerChunkSize")
+        return std::to_string(this->schedulerChunkSize);
+    else if (name == "schedulerClaimTimeout")
+        return std::to_string(this->schedulerClaimTimeout);
+    else if (name == "streamStatistics")
+        return this->streamStatistics ? "true" : "false";
+    else if (name == "symmetrySectors")
+        return this->symmetrySectors;
+    else if (name == "reuseHamiltonianStructure")
+        return this->reuseHamiltonianStructure ? "true" : "false";
+    else if (name == "eigensolver")
+        return this->eigensolver;
+    else if (name == "polfedEpsilon")
+        return this->doubleToString(this->polfedEpsilon);
+    else if (name == "polfedEigenpairs")
+        return std::to_string(this->polfedEigenpairs);
 
     // Hamiltonian term parameters
     for (auto &term : this->hamiltonianTerms) {
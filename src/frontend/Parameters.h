@@ -47,6 +47,14 @@ public:
     std::size_t seed{};
     bool splitWorkload = false;
     bool secureSimulationState = true;
+    std::size_t schedulerChunkSize = 0;
+    std::size_t schedulerClaimTimeout = 3600;
+    bool streamStatistics = false;
+    std::string symmetrySectors = "none";
+    bool reuseHamiltonianStructure = false;
+    std::string eigensolver = "dense";
+    double polfedEpsilon = 0.5;
+    std::size_t polfedEigenpairs = 100;
 
     /**
      * @brief All keys from sections @a [term.termName] are mapped to separate config under @a termName key in the map.
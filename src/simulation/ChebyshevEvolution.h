@@ -12,6 +12,7 @@
 #include "evolution/TimeEvolution.h"
 #include "simulation/SimulationsSpan.h"
 #include "evolution/ChebyshevEvolver.h"
+#include "evolution/KrylovEvolver.h"
 #include "core/HamiltonianGenerator.h"
 #include "core/AveragingModel.h"
 #include "core/RND.h"
@@ -22,12 +23,13 @@
  * @brief A class performing time evolutions using Chebyshev expansion technique.
  * @details See TimeEvolution and its "slave" classes to see what is calculated. The hamiltonian generator is prepared
  * for each simulation according to a specific averaging model and, if desired, the quench stated is prepared for
- * evolution (see constructor). The template parameters default to standard classes and exist solely for mocking
- * purposes. See the default classes description for details of what they do.
+ * evolution (see constructor). Alternatively, KrylovEvolver can be used instead of ChebyshevEvolver. The template
+ * parameters default to standard classes and exist solely for mocking purposes. See the default classes description
+ * for details of what they do.
  */
 template<typename HamiltonianGenerator_t = HamiltonianGenerator, typename AveragingModel_t = AveragingModel,
          typename TimeEvolution_t = TimeEvolution, typename QuenchCalculator_t = QuenchCalculator,
-         typename ChebyshevEvolver_t = ChebyshevEvolver>
+         typename ChebyshevEvolver_t = ChebyshevEvolver, typename KrylovEvolver_t = KrylovEvolver>
 class ChebyshevEvolution : public RestorableSimulation {
 private:
     std::unique_ptr<HamiltonianGenerator_t> hamiltonianGenerator;
@@ -41,22 +43,26 @@ private:
     std::unique_ptr<HamiltonianGenerator_t> quenchHamiltonianGenerator;
     std::unique_ptr<RND> quenchRnd;
 
+    bool matrixFree{};
+    bool krylov{};
 
     auto prepareHamiltonianAndPossiblyQuenchVector(std::size_t simulationIndex, std::size_t totalSimulations,
                                                    Logger &logger) const
     {
         std::vector<arma::cx_vec> additionalVectors;
 
+        this->rnd->setSimulationIndex(simulationIndex);
         this->averagingModel->setupHamiltonianGenerator(*this->hamiltonianGenerator, *this->rnd, simulationIndex,
                                                         totalSimulations);
-        arma::sp_mat hamiltonian = this->hamiltonianGenerator->generate();
+        auto hamiltonian = this->hamiltonianGenerator->generateOperator(this->matrixFree);
 
         if (this->quenchCalculator != nullptr) {
+            this->quenchRnd->setSimulationIndex(simulationIndex);
             this->averagingModel->setupHamiltonianGenerator(*this->quenchHamiltonianGenerator, *this->quenchRnd,
                                                             simulationIndex, totalSimulations);
-            arma::sp_mat initialHamiltonian = this->quenchHamiltonianGenerator->generate();
+            auto initialHamiltonian = this->quenchHamiltonianGenerator->generateOperator(this->matrixFree);
 
-            this->quenchCalculator->addQuench(initialHamiltonian, hamiltonian);
+            this->quenchCalculator->addQuench(*initialHamiltonian, *hamiltonian);
 
             // Yup, Armadillo wouldn't let you initialize arma::cx_vec by arma::vec easily, we have to do this nonsense
             const arma::vec &quenchedStateDouble = this->quenchCalculator->getLastQuenchedState();
@@ -68,7 +74,7 @@ private:
             logger << "; quantum error: " << this->quenchCalculator->getLastQuenchEpsilonQuantumUncertainty() << ". ";
             logger << std::endl;
         }
-        return std::make_pair(hamiltonian, additionalVectors);
+        return std::make_pair(std::move(hamiltonian), additionalVectors);
     }
 
 public:
@@ -76,18 +82,21 @@ public:
      * @brief Constructor, where HamiltonianGenerator and RND for quench should be passed, or set to nullptr if
      * quench should not be done.
      * @details If quench is to be done, @a parameters.initialVectors has to have exactly one external vector slot
-     * provided, 0 otherwise.
+     * provided, 0 otherwise. If @a matrixFree is @a true, hamiltonians are not stored as sparse matrices, but their
+     * action on vectors is computed on the fly (see HamiltonianGenerator::generateOperator()). If @a krylov is
+     * @a true, KrylovEvolver is used instead of ChebyshevEvolver.
      */
     ChebyshevEvolution(std::unique_ptr<HamiltonianGenerator_t> hamiltonianGenerator,
                        std::unique_ptr<AveragingModel_t> averagingModel, std::unique_ptr<RND> rnd,
                        std::unique_ptr<TimeEvolution_t> timeEvolution,
                        std::unique_ptr<QuenchCalculator_t> quenchCalculator,
                        std::unique_ptr<HamiltonianGenerator_t> quenchHamiltonianGenerator,
-                       std::unique_ptr<RND> quenchRnd)
+                       std::unique_ptr<RND> quenchRnd, bool matrixFree = false, bool krylov = false)
             : hamiltonianGenerator{std::move(hamiltonianGenerator)}, averagingModel{std::move(averagingModel)},
               rnd{std::move(rnd)}, timeEvolution{std::move(timeEvolution)},
               quenchCalculator{std::move(quenchCalculator)},
-              quenchHamiltonianGenerator{std::move(quenchHamiltonianGenerator)}, quenchRnd{std::move(quenchRnd)}
+              quenchHamiltonianGenerator{std::move(quenchHamiltonianGenerator)}, quenchRnd{std::move(quenchRnd)},
+              matrixFree{matrixFree}, krylov{krylov}
     {
         if (this->quenchCalculator == nullptr) {
             Expects(this->timeEvolution->countExternalVectors() == 0);
@@ -103,9 +112,9 @@ public:
      */
     ChebyshevEvolution(std::unique_ptr<HamiltonianGenerator_t> hamiltonianGenerator,
                        std::unique_ptr<AveragingModel_t> averagingModel, std::unique_ptr<RND> rnd,
-                       std::unique_ptr<TimeEvolution_t> timeEvolution)
+                       std::unique_ptr<TimeEvolution_t> timeEvolution, bool matrixFree = false, bool krylov = false)
             : ChebyshevEvolution(std::move(hamiltonianGenerator), std::move(averagingModel), std::move(rnd),
-                                 std::move(timeEvolution), nullptr, nullptr, nullptr)
+                                 std::move(timeEvolution), nullptr, nullptr, nullptr, matrixFree, krylov)
     { }
 
     void printQuenchInfo(Logger &logger) {
@@ -169,9 +178,15 @@ public:
 
         logger.verbose() << "Preparing evolver started... " << std::endl;
         timer.tic();
-        ChebyshevEvolver_t evolver(hamiltonian, logger);
-        logger.info() << "Preparing evolver done (" << timer.toc() << " s)." << std::endl;
-        this->timeEvolution->addEvolution(evolver, logger, additionalVectors);
+        if (this->krylov) {
+            KrylovEvolver_t evolver(*hamiltonian, logger);
+            logger.info() << "Preparing evolver done (" << timer.toc() << " s)." << std::endl;
+            this->timeEvolution->addEvolution(evolver, logger, additionalVectors);
+        } else {
+            ChebyshevEvolver_t evolver(*hamiltonian, logger);
+            logger.info() << "Preparing evolver done (" << timer.toc() << " s)." << std::endl;
+            this->timeEvolution->addEvolution(evolver, logger, additionalVectors);
+        }
         logger.info() << "Whole evolution took " << wholeTimer.toc() << " s." << std::endl;
     }
 
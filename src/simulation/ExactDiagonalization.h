@@ -11,6 +11,9 @@
 #include <memory>
 #include <fstream>
 #include <iterator>
+#include <future>
+#include <algorithm>
+#include <limits>
 
 #include <armadillo>
 #include <utility>
@@ -23,6 +26,7 @@
 #include "core/RND.h"
 #include "core/AveragingModel.h"
 #include "simulation/RestorableSimulation.h"
+#include "utils/Assertions.h"
 
 /**
  * @brief A class performing diagonalizations and optionaly some analyzer tasks.
@@ -44,6 +48,18 @@ private:
     std::unique_ptr<FileOstreamProvider> ostreamProvider;
     std::unique_ptr<Analyzer_t> analyzer;
     ExactDiagonalizationParameters params;
+    std::size_t spanEnd = std::numeric_limits<std::size_t>::max();
+
+    // In the pipelined mode: separate hamiltonian generator, averaging model and random generator preparing the next
+    // realisation, so that nothing is shared with the analysis of the current one
+    std::unique_ptr<HamiltonianGenerator_t> pipelineHamiltonianGenerator;
+    std::unique_ptr<AveragingModel_t> pipelineAveragingModel;
+    std::unique_ptr<RND> pipelineRnd;
+
+    // In the pipelined mode: the eigensystem of the next realisation being calculated in the background. It has to be
+    // the last member, so that the background calculation is finished before anything it uses is destroyed
+    std::size_t prefetchedSimulationIndex{};
+    std::future<Eigensystem> prefetchedEigensystem;
 
     void doSaveEigensystem(const Eigensystem &eigensystem, std::size_t index) const {
         std::ostringstream filenamePrefixStream;
@@ -67,6 +83,66 @@ private:
         }
     }
 
+    /**
+     * @brief If all eigenvectors are stored, they are all calculated, otherwise only the ones which are used by
+     * the analyzer (see Analyzer::getRequiredEigenvectors). For polfed eigensolver only a window of the spectrum is
+     * calculated.
+     */
+    Eigensystem calculateEigensystem(const HamiltonianGenerator_t &generator) const {
+        if (this->params.eigensolver == ExactDiagonalizationParameters::Eigensolver::POLFED) {
+            return generator.calculateEigensystemAroundEnergy(this->params.polfedEpsilon,
+                                                              this->params.polfedEigenpairs);
+        }
+
+        if (!this->params.calculateEigenvectors
+            || this->params.storeLevel == ExactDiagonalizationParameters::StoreLevel::EIGENSYSTEM)
+        {
+            return generator.calculateEigensystem(this->params.calculateEigenvectors);
+        }
+
+        return generator.calculatePartialEigensystem([this](const Eigensystem &eigensystem) {
+            return this->analyzer->getRequiredEigenvectors(eigensystem);
+        });
+    }
+
+    void setupHamiltonian(HamiltonianGenerator_t &generator, AveragingModel_t &model, RND &rnd_,
+                          std::size_t simulationIndex, std::size_t totalSimulations) const
+    {
+        rnd_.setSimulationIndex(simulationIndex);
+        model.setupHamiltonianGenerator(generator, rnd_, simulationIndex, totalSimulations);
+    }
+
+    /**
+     * @brief Returns the eigensystem prepared in the background if it is the one of @a simulationIndex, otherwise it
+     * waits for the background calculation to finish, discards it and prepares the eigensystem.
+     * @details In both cases, this->hamiltonianGenerator is set up for @a simulationIndex, since analyzer tasks may
+     * use it.
+     */
+    Eigensystem obtainEigensystem(std::size_t simulationIndex, std::size_t totalSimulations) {
+        this->setupHamiltonian(*this->hamiltonianGenerator, *this->averagingModel, *this->rnd, simulationIndex,
+                               totalSimulations);
+        if (this->prefetchedEigensystem.valid()) {
+            auto prefetched = std::move(this->prefetchedEigensystem);
+            if (this->prefetchedSimulationIndex == simulationIndex)
+                return prefetched.get();
+            prefetched.wait();
+        }
+        return this->calculateEigensystem(*this->hamiltonianGenerator);
+    }
+
+    /**
+     * @brief Starts preparing the eigensystem of @a simulationIndex in the background, using only the pipeline
+     * generator, averaging model and random generator.
+     */
+    void prefetchEigensystem(std::size_t simulationIndex, std::size_t totalSimulations) {
+        this->prefetchedSimulationIndex = simulationIndex;
+        this->prefetchedEigensystem = std::async(std::launch::async, [this, simulationIndex, totalSimulations]() {
+            this->setupHamiltonian(*this->pipelineHamiltonianGenerator, *this->pipelineAveragingModel,
+                                   *this->pipelineRnd, simulationIndex, totalSimulations);
+            return this->calculateEigensystem(*this->pipelineHamiltonianGenerator);
+        });
+    }
+
 public:
     /**
      * @brief The constructor with mockable eigenenergy file creating using own FileOstreamProvider.
@@ -95,38 +171,87 @@ public:
 
     const Analyzer_t &getAnalyzer() const { return *this->analyzer; }
 
+    /**
+     * @brief Sets the hamiltonian generator, averaging model and random generator used in the pipelined mode (see
+     * performSimulation()) to prepare the next realisation in the background.
+     * @details They have to be independent of the ones from the constructor (and of anything used by the analyzer),
+     * but created in the same way, so that they give the same hamiltonians.
+     */
+    void setPipelineResources(std::unique_ptr<HamiltonianGenerator_t> pipelineHamiltonianGenerator_,
+                              std::unique_ptr<AveragingModel_t> pipelineAveragingModel_,
+                              std::unique_ptr<RND> pipelineRnd_)
+    {
+        Expects(pipelineHamiltonianGenerator_ != nullptr);
+        Expects(pipelineAveragingModel_ != nullptr);
+        Expects(pipelineRnd_ != nullptr);
+        this->pipelineHamiltonianGenerator = std::move(pipelineHamiltonianGenerator_);
+        this->pipelineAveragingModel = std::move(pipelineAveragingModel_);
+        this->pipelineRnd = std::move(pipelineRnd_);
+    }
+
     void storeState(std::ostream &binaryOut) const override { this->analyzer->storeState(binaryOut); }
     void joinRestoredState(std::istream &binaryIn) override { this->analyzer->joinRestoredState(binaryIn); }
     void clear() override { this->analyzer->clear(); }
 
     void seedRandomGenerators(unsigned long seed) override {
         this->rnd->seed(seed);
+        if (this->pipelineRnd != nullptr)
+            this->pipelineRnd->seed(seed);
+    }
+
+    /**
+     * @brief In the pipelined mode, realisations from outside @a span are not prepared in advance.
+     */
+    void prepareForSpan(const SimulationsSpan &span) override {
+        this->spanEnd = span.to;
     }
 
     /**
      * @brief Perform simulation @a simulationIndex out of @a totalSimulations.
      * @details
      * <p> Before the simulation new hamiltonian is prepared according to @a AveragingModel_t. Then the
-     * diagonalization is performed. After that, optionally, eigenenergies are stored and some on-the-fly
+     * diagonalization is performed - if eigenvectors are not stored, only the ones needed by AnalyzerTask -s are
+     * calculated. After that, optionally, eigenenergies are stored and some on-the-fly
      * AnalyzerTask -s are performed.
+     * <p> If ExactDiagonalizationParameters::pipelined is true, after the diagonalization the next realisation is
+     * generated and diagonalized in the background (if its index is below @a totalSimulations and the end of the span
+     * from prepareForSpan()), while eigensystem files are written on another background thread and the analysis is
+     * performed. The eigensystem is then taken by the next call, so at most two eigensystems are held in memory at
+     * once. Storing is always finished before the method returns. The next realisation is prepared using the objects
+     * from setPipelineResources(), which have to be set, so the analysis can use the hamiltonian generator from the
+     * constructor, which is set up for the current realisation. The results are identical to the non-pipelined ones,
+     * since each realisation uses its own random stream (see RND::setSimulationIndex()).
      * <p> Eigenenergy files will be named `[Parameter::fileSignature]_[simulation index]_ngr.txt`.
      */
     void performSimulation(std::size_t simulationIndex, std::size_t totalSimulations, Logger &logger) override {
         logger.verbose() << "Performing diagonalization " << simulationIndex << " started..." << std::endl;
         arma::wall_clock timer;
         timer.tic();
-        this->averagingModel->setupHamiltonianGenerator(*this->hamiltonianGenerator, *this->rnd, simulationIndex,
-                                                        totalSimulations);
-        Eigensystem eigensystem = this->hamiltonianGenerator->calculateEigensystem(this->params.calculateEigenvectors);
+        Eigensystem eigensystem = this->obtainEigensystem(simulationIndex, totalSimulations);
         double diagonalizationTime = timer.toc();
 
+        std::future<void> storeFuture;
+        if (this->params.pipelined) {
+            Expects(this->pipelineHamiltonianGenerator != nullptr);
+            if (simulationIndex + 1 < std::min(totalSimulations, this->spanEnd))
+                this->prefetchEigensystem(simulationIndex + 1, totalSimulations);
+            if (this->params.storeLevel != ExactDiagonalizationParameters::StoreLevel::NONE) {
+                storeFuture = std::async(std::launch::async, [this, &eigensystem, simulationIndex]() {
+                    this->doSaveEigensystem(eigensystem, simulationIndex);
+                });
+            }
+        }
+
         logger.verbose() << "Performing analysis started..." << std::endl;
         timer.tic();
         this->analyzer->analyze(eigensystem, logger);
         double analyzingTime = timer.toc();
 
         timer.tic();
-        this->doSaveEigensystem(eigensystem, simulationIndex);
+        if (storeFuture.valid())
+            storeFuture.get();
+        else
+            this->doSaveEigensystem(eigensystem, simulationIndex);
         double storeTime = timer.toc();
 
         logger.info() << "Diagonalization " << simulationIndex << " done (diagonalization: " << diagonalizationTime;
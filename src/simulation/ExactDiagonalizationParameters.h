@@ -19,6 +19,19 @@ struct ExactDiagonalizationParameters {
         EIGENSYSTEM
     };
 
+    enum class Eigensolver {
+        /**
+         * @brief Full diagonalization of the dense matrix, see HamiltonianGenerator::calculateEigensystem().
+         */
+        DENSE,
+
+        /**
+         * @brief Only a window of the spectrum found by the sparse eigensolver, see
+         * HamiltonianGenerator::calculateEigensystemAroundEnergy().
+         */
+        POLFED
+    };
+
     /**
      * @brief If true, the diagonalization will produce both eigenvalues and eigenvectors.
      */
@@ -38,6 +51,28 @@ struct ExactDiagonalizationParameters {
      * @brief Format in which eigensystem should be stored, as passed to Armadillo @a .save method
      */
      arma::file_type fileType = arma::arma_binary;
+
+    /**
+     * @brief Which eigensolver to use. For Eigensolver::POLFED eigenvectors are always calculated and nothing can be
+     * stored.
+     */
+    Eigensolver eigensolver = Eigensolver::DENSE;
+
+    /**
+     * @brief The normalized to [0, 1] energy, around which Eigensolver::POLFED finds the eigenpairs.
+     */
+    double polfedEpsilon = 0.5;
+
+    /**
+     * @brief The number of eigenpairs found by Eigensolver::POLFED.
+     */
+    std::size_t polfedEigenpairs = 100;
+
+    /**
+     * @brief If true, the next realisation is generated and diagonalized in the background, while the current one is
+     * analyzed and stored. See ExactDiagonalization::performSimulation().
+     */
+    bool pipelined{};
 };
 
 #endif //MBL_ED_EXACTDIAGONALIZATIONPARAMETERS_H
@@ -34,20 +34,24 @@ private:
     std::unique_ptr<AveragingModel_t> averagingModel;
     std::unique_ptr<QuenchCalculator_t> quenchCalculator;
 
+    bool matrixFree{};
+
 public:
     /**
      * @brief Constructs the class.
      * @details Most of parameters are self-explainatory. We have initial and final hamiltonian generator and
-     * corresponding random generators, which should be seeded with the same seed.
+     * corresponding random generators, which should be seeded with the same seed. If @a matrixFree is @a true,
+     * hamiltonians are not stored as sparse matrices (see HamiltonianGenerator::generateOperator()).
      */
     QuenchDataSimulation(std::unique_ptr<HamiltonianGenerator_t> initialHamiltonianGenerator,
                          std::unique_ptr<RND> initialRnd,
                          std::unique_ptr<HamiltonianGenerator_t> finalHamiltonianGenerator,
                          std::unique_ptr<RND> finalRnd, std::unique_ptr<AveragingModel_t> averagingModel,
-                         std::unique_ptr<QuenchCalculator_t> quenchCalculator)
+                         std::unique_ptr<QuenchCalculator_t> quenchCalculator, bool matrixFree = false)
             : initialHamiltonianGenerator{std::move(initialHamiltonianGenerator)}, initialRnd{std::move(initialRnd)},
               finalHamiltonianGenerator{std::move(finalHamiltonianGenerator)}, finalRnd{std::move(finalRnd)},
-              averagingModel{std::move(averagingModel)}, quenchCalculator{std::move(quenchCalculator)}
+              averagingModel{std::move(averagingModel)}, quenchCalculator{std::move(quenchCalculator)},
+              matrixFree{matrixFree}
     { }
 
     [[nodiscard]] std::vector<std::string> getResultsHeader() const {
@@ -78,14 +82,16 @@ public:
         logger.verbose() << "Performing quench " << simulationIndex << " started... " << std::endl;
         timer.tic();
 
+        this->initialRnd->setSimulationIndex(simulationIndex);
+        this->finalRnd->setSimulationIndex(simulationIndex);
         this->averagingModel->setupHamiltonianGenerator(*this->initialHamiltonianGenerator, *this->initialRnd,
                                                         simulationIndex, totalSimulations);
         this->averagingModel->setupHamiltonianGenerator(*this->finalHamiltonianGenerator, *this->finalRnd,
                                                         simulationIndex, totalSimulations);
-        arma::sp_mat initialHamiltonian = this->initialHamiltonianGenerator->generate();
-        arma::sp_mat finalHamiltonian = this->finalHamiltonianGenerator->generate();
+        auto initialHamiltonian = this->initialHamiltonianGenerator->generateOperator(this->matrixFree);
+        auto finalHamiltonian = this->finalHamiltonianGenerator->generateOperator(this->matrixFree);
 
-        this->quenchCalculator->addQuench(initialHamiltonian, finalHamiltonian);
+        this->quenchCalculator->addQuench(*initialHamiltonian, *finalHamiltonian);
 
         logger.info() << "Performing quench " << simulationIndex << " done (" << timer.toc() << " s). ";
         logger << "epsilon: " << this->quenchCalculator->getLastQuenchEpsilon();
@@ -10,13 +10,13 @@
 
 
 void RandomStateObservables::storeState(std::ostream &binaryOut) const {
-    RestorableHelper::storeStateForHistogram(this->notNormalizedValues, binaryOut);
-    RestorableHelper::storeStateForHistogram(this->normalizedValues, binaryOut);
+    RestorableHelper::storeStateForSampleCollectors(this->notNormalizedValues, binaryOut);
+    RestorableHelper::storeStateForSampleCollectors(this->normalizedValues, binaryOut);
 }
 
 void RandomStateObservables::joinRestoredState(std::istream &binaryIn) {
-    RestorableHelper::joinRestoredStateForHistogram(this->notNormalizedValues, binaryIn);
-    RestorableHelper::joinRestoredStateForHistogram(this->normalizedValues, binaryIn);
+    RestorableHelper::joinRestoredStateForSampleCollectors(this->notNormalizedValues, binaryIn);
+    RestorableHelper::joinRestoredStateForSampleCollectors(this->normalizedValues, binaryIn);
 }
 
 void RandomStateObservables::clear() {
@@ -26,7 +26,7 @@ void RandomStateObservables::clear() {
         entry.clear();
 }
 
-void RandomStateObservables::performSimulation([[maybe_unused]] std::size_t simulationIndex,
+void RandomStateObservables::performSimulation(std::size_t simulationIndex,
                                                [[maybe_unused]] std::size_t totalSimulations,
                                                Logger &logger)
 {
@@ -34,6 +34,7 @@ void RandomStateObservables::performSimulation([[maybe_unused]] std::size_t simu
     arma::wall_clock timer;
     timer.tic();
 
+    this->rnd->setSimulationIndex(simulationIndex);
     std::size_t size = this->basis->size();
     arma::cx_vec state(size);
     std::generate(state.begin(), state.end(), [this, size]() { return this->nextGaussian(1./size); });
@@ -45,7 +46,7 @@ void RandomStateObservables::performSimulation([[maybe_unused]] std::size_t simu
 }
 
 void RandomStateObservables::addStateToObservables(const arma::cx_vec &state,
-                                                   std::vector<std::vector<double>> &observables) const
+                                                   std::vector<SampleCollector> &observables) const
 {
     for (auto &primaryObservable : primaryObservables)
         primaryObservable->calculateForState(state);
@@ -57,7 +58,7 @@ void RandomStateObservables::addStateToObservables(const arma::cx_vec &state,
         auto singleObservableValues = storedObservable->getValues();
         Assert(offset + singleObservableValues.size() <= numValues);
         for (std::size_t i{}; i < singleObservableValues.size(); i++)
-            observables[i + offset].push_back(singleObservableValues[i]);
+            observables[i + offset].add(singleObservableValues[i]);
         offset += singleObservableValues.size();
     }
     Assert(offset == numValues);
@@ -74,10 +75,10 @@ std::vector<std::string> RandomStateObservables::getValues() const {
 }
 
 void RandomStateObservables::appendObservable(std::vector<std::string> &result,
-                                              const std::vector<double> &observableValues) const
+                                              const SampleCollector &observableValues) const
 {
     Quantity meanValue;
-    meanValue.calculateFromSamples(observableValues);
+    meanValue.calculateFromCollector(observableValues);
     meanValue.separator = Quantity::SPACE;
     std::stringstream inOut;
     inOut << meanValue;
@@ -14,6 +14,7 @@
 #include "core/RND.h"
 #include "core/PrimaryObservable.h"
 #include "core/SecondaryObservable.h"
+#include "utils/SampleCollector.h"
 
 class RandomStateObservables : public RestorableSimulation {
 private:
@@ -24,28 +25,28 @@ private:
     std::vector<std::shared_ptr<Observable>> storedObservables;
 
     std::vector<std::string> header;
-    std::vector<std::vector<double>> normalizedValues;
-    std::vector<std::vector<double>> notNormalizedValues;
+    std::vector<SampleCollector> normalizedValues;
+    std::vector<SampleCollector> notNormalizedValues;
 
     std::size_t numValues{};
 
     double nextGaussian(double var);
     [[nodiscard]] std::size_t countStoredObservableValues() const;
     [[nodiscard]] std::vector<std::string> generateStoredObservablesHeader() const;
-    void addStateToObservables(const arma::cx_vec &state,std::vector<std::vector<double>> &observables) const;
-    void appendObservable(std::vector<std::string> &result, const std::vector<double> &observableValues) const;
+    void addStateToObservables(const arma::cx_vec &state, std::vector<SampleCollector> &observables) const;
+    void appendObservable(std::vector<std::string> &result, const SampleCollector &observableValues) const;
 
 public:
     RandomStateObservables(std::unique_ptr <RND> rnd, std::shared_ptr<FockBasis> basis,
                            std::vector <std::shared_ptr<PrimaryObservable>> primaryObservables,
                            std::vector <std::shared_ptr<SecondaryObservable>> secondaryObservables,
-                           std::vector <std::shared_ptr<Observable>> storedObservables)
+                           std::vector <std::shared_ptr<Observable>> storedObservables, bool streamStatistics = false)
             : rnd{std::move(rnd)}, basis{std::move(basis)}, primaryObservables{std::move(primaryObservables)},
               secondaryObservables{std::move(secondaryObservables)}, storedObservables{std::move(storedObservables)}
     {
         this->numValues = this->countStoredObservableValues();
-        this->normalizedValues.resize(this->numValues);
-        this->notNormalizedValues.resize(this->numValues);
+        this->normalizedValues.resize(this->numValues, SampleCollector(streamStatistics));
+        this->notNormalizedValues.resize(this->numValues, SampleCollector(streamStatistics));
         this->header = this->generateStoredObservablesHeader();
     }
 
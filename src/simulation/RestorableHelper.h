@@ -12,6 +12,8 @@
 #include <memory>
 
 #include "utils/Assertions.h"
+#include "utils/Accumulator.h"
+#include "utils/SampleCollector.h"
 #include "Restorable.h"
 
 /**
@@ -166,6 +168,82 @@ public:
             binEntries.insert(binEntries.end(), entriesRestored.begin(), entriesRestored.end());
         }
     }
+
+    /**
+     * @brief Restorable::storeState for Accumulator.
+     */
+    static void storeStateForAccumulator(const Accumulator &accumulator, std::ostream &binaryOut) {
+        static_assert(std::is_trivially_copyable_v<Accumulator>);
+        binaryOut.write(reinterpret_cast<const char*>(&accumulator), sizeof(accumulator));
+        Assert(binaryOut.good());
+    }
+
+    /**
+     * @brief Restorable::joinRestoredState for Accumulator.
+     * @details Restored accumulator is merged into @a accumulator, so the size of the state does not depend on the
+     * number of samples.
+     */
+    static void joinRestoredStateForAccumulator(Accumulator &accumulator, std::istream &binaryIn) {
+        static_assert(std::is_trivially_copyable_v<Accumulator>);
+        Accumulator accumulatorRestored;
+        binaryIn.read(reinterpret_cast<char*>(&accumulatorRestored), sizeof(accumulatorRestored));
+        Assert(binaryIn.good());
+        accumulator.merge(accumulatorRestored);
+    }
+
+    /**
+     * @brief Restorable::storeState for SampleCollector.
+     * @details Non-streaming collector is stored as storeStateForVector() stores the samples, streaming one - as
+     * storeStateForAccumulator().
+     */
+    static void storeStateForSampleCollector(const SampleCollector &collector, std::ostream &binaryOut) {
+        if (collector.streaming)
+            storeStateForAccumulator(collector.accumulator, binaryOut);
+        else
+            storeStateForVector(collector.samples, binaryOut);
+    }
+
+    /**
+     * @brief Restorable::joinRestoredState for SampleCollector.
+     * @details Restored samples are concatenated with the ones from @a collector, or restored accumulator is merged,
+     * depending on the mode of @a collector. The state has to be stored in the same mode.
+     */
+    static void joinRestoredStateForSampleCollector(SampleCollector &collector, std::istream &binaryIn) {
+        if (collector.streaming)
+            joinRestoredStateForAccumulator(collector.accumulator, binaryIn);
+        else
+            joinRestoredStateForVector(collector.samples, binaryIn);
+    }
+
+    /**
+     * @brief Restorable::storeState for vector of SampleCollector -s with static size.
+     * @details For non-streaming collectors the format is the same as of storeStateForHistogram().
+     */
+    static void storeStateForSampleCollectors(const std::vector<SampleCollector> &collectors,
+                                              std::ostream &binaryOut)
+    {
+        std::size_t numCollectors = collectors.size();
+        binaryOut.write(reinterpret_cast<const char*>(&numCollectors), sizeof(numCollectors));
+        Assert(binaryOut.good());
+        for (const auto &collector : collectors)
+            storeStateForSampleCollector(collector, binaryOut);
+    }
+
+    /**
+     * @brief Restorable::joinRestoredState for vector of SampleCollector -s with static size.
+     * @details Loaded vector is asserted to have the same size as @a collectors and the corresponding collectors
+     * are joined.
+     */
+    static void joinRestoredStateForSampleCollectors(std::vector<SampleCollector> &collectors,
+                                                     std::istream &binaryIn)
+    {
+        std::size_t numCollectorsRestored{};
+        binaryIn.read(reinterpret_cast<char*>(&numCollectorsRestored), sizeof(numCollectorsRestored));
+        Assert(binaryIn.good());
+        Assert(numCollectorsRestored == collectors.size());
+        for (auto &collector : collectors)
+            joinRestoredStateForSampleCollector(collector, binaryIn);
+    }
 };
 
 
@@ -29,6 +29,14 @@ public:
      * values of @a totalSimulations, with @a simulationsIndex < @a totalSimulations. However calling clear() should
      * allow another set ot potentially different simmulations.
      */
+    /**
+     * @brief Informs the simulation that the simulations from @a span will be performed next, possibly by many calls
+     * of performSimulation().
+     * @details The simulation may use it, for example, not to prepare in advance the simulations from outside
+     * @a span. The default implementation does nothing.
+     */
+    virtual void prepareForSpan([[maybe_unused]] const SimulationsSpan &span) { }
+
     virtual void performSimulation(std::size_t simulationIndex, std::size_t totalSimulations, Logger &logger) = 0;
 
     /**
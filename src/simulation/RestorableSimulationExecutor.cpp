@@ -5,11 +5,86 @@
 #include <utility>
 #include <ostream>
 #include <fstream>
+#include <sstream>
 #include <regex>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <cstdio>
+#include <cctype>
+#include <algorithm>
 
 #include "RestorableSimulationExecutor.h"
+#include "SimulationJournal.h"
 #include "utils/Assertions.h"
 #include "utils/Utils.h"
+#include "utils/OMPMacros.h"
+#include "utils/BLASThreadsLimit.h"
+
+namespace {
+    /**
+     * @brief The outcome of a single simulation performed by a parallel worker: the state to be joined and the log.
+     */
+    struct WorkerResult {
+        std::string state;
+        std::string log;
+        std::exception_ptr exception;
+    };
+
+    /**
+     * @brief Creates an empty file, only if it does not exist. Returns false if it existed. The check and creation
+     * are atomic, so it can be used as a lock between processes.
+     */
+    bool create_file_exclusively(const std::filesystem::path &path) {
+        std::FILE *file = std::fopen(path.c_str(), "wx");
+        if (file == nullptr)
+            return false;
+        std::fclose(file);
+        return true;
+    }
+
+    /**
+     * @brief Touches the claim file in a background thread for as long as the object exists, so that other processes
+     * know that the claim is not abandoned.
+     */
+    class ClaimHeartbeat {
+    private:
+        std::filesystem::path claimPath;
+        std::chrono::milliseconds interval;
+        std::mutex mutex;
+        std::condition_variable stopRequested;
+        bool stopped{};
+        std::thread thread;
+
+        void run() {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            while (!this->stopRequested.wait_for(lock, this->interval, [this]() { return this->stopped; })) {
+                std::error_code error;
+                std::filesystem::last_write_time(this->claimPath, std::filesystem::file_time_type::clock::now(),
+                                                 error);
+            }
+        }
+
+    public:
+        ClaimHeartbeat(std::filesystem::path claimPath, std::chrono::seconds claimTimeout)
+                : claimPath{std::move(claimPath)},
+                  interval{std::max(std::chrono::milliseconds(claimTimeout) / 10, std::chrono::milliseconds(100))},
+                  thread([this]() { this->run(); })
+        { }
+
+        ~ClaimHeartbeat() {
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->stopped = true;
+            }
+            this->stopRequested.notify_one();
+            this->thread.join();
+        }
+    };
+}
 
 RestorableSimulationExecutor::RestorableSimulationExecutor(const SimulationsSpan &simulationsSpan,
                                                            std::string fileSignature, bool splitWorkload,
@@ -32,13 +107,20 @@ void RestorableSimulationExecutor::performSimulations(RestorableSimulation &simu
     this->shouldSaveSimulation_ = false;
 
     std::string stateFilename = this->fileSignature + "_state_" + simulation.getTagName() + ".bin";
-    SimulationStatus simulationStatus = this->tryRestoringSimulation(simulation, stateFilename, logger);
+    if (this->chunkSize > 0) {
+        this->performScheduledSimulations(simulation, stateFilename, seed, logger);
+        this->superviseSimulationsSplit(simulation, stateFilename, logger);
+        return;
+    }
+
+    SimulationJournal journal(this->workingDirectory / stateFilename, this->simulationsSpan);
+    SimulationStatus simulationStatus = this->tryRestoringSimulation(simulation, this->simulationsSpan, journal,
+                                                                     logger);
 
     SimulationsSpan actualSpan;
     actualSpan = this->simulationsSpan;
     actualSpan.from = simulationStatus.nextSimulationIndex;
-    simulation.seedRandomGenerators(seed + actualSpan.from);
-    this->doPerformSimulations(simulation, actualSpan, stateFilename, logger);
+    this->performSpan(simulation, actualSpan, journal, seed, logger);
 
     if (!this->splitWorkload) {
         this->shouldSaveSimulation_ = true;
@@ -49,56 +131,312 @@ void RestorableSimulationExecutor::performSimulations(RestorableSimulation &simu
 }
 
 RestorableSimulationExecutor::SimulationStatus
-RestorableSimulationExecutor::tryRestoringSimulation(RestorableSimulation &simulation, const std::string &stateFilename,
-                                                     Logger &logger) const
+RestorableSimulationExecutor::tryRestoringSimulation(RestorableSimulation &simulation, const SimulationsSpan &span,
+                                                     SimulationJournal &journal, Logger &logger) const
 {
     SimulationStatus simulationStatus;
-    std::ifstream stateFile(this->workingDirectory / stateFilename, std::ios::in | std::ios::binary);
-    if (stateFile.is_open()) {
-        simulationStatus = this->joinRestoredSimulations(simulation, stateFile);
-        Assert(simulationStatus.nextSimulationIndex > this->simulationsSpan.from);
-        Assert(simulationStatus.nextSimulationIndex <= this->simulationsSpan.to);
+    bool journalFound = journal.restore(simulation);
+    if (journal.hasDroppedTornRecord())
+        logger.warn() << "Torn record found at the end of the state file. It was dropped." << std::endl;
+    if (journal.hasDroppedInvalidHeader()) {
+        logger.warn() << "State file has a short or invalid header (it may be torn or come from an older version). ";
+        logger << "It was removed." << std::endl;
+    }
 
-        logger.warn() << "State file found, restored simulations [" << this->simulationsSpan.from << ", ";
+    if (journalFound && journal.getNextSimulationIndex() > span.from) {
+        simulationStatus.finished = journal.isFinished();
+        simulationStatus.nextSimulationIndex = journal.getNextSimulationIndex();
+
+        logger.warn() << "State file found, restored simulations [" << span.from << ", ";
         logger << (simulationStatus.nextSimulationIndex - 1) << "], performing [";
-        logger << simulationStatus.nextSimulationIndex << ", " << simulationsSpan.to << ") out of ";
-        logger << simulationsSpan.total << std::endl;
+        logger << simulationStatus.nextSimulationIndex << ", " << span.to << ") out of ";
+        logger << span.total << std::endl;
     } else {
-        logger.info() << "No state file found, starting simulations from scratch, [" << this->simulationsSpan.from;
-        logger << ", " << this->simulationsSpan.to << ") out of " << this->simulationsSpan.total << std::endl;
+        logger.info() << "No state file found, starting simulations from scratch, [" << span.from;
+        logger << ", " << span.to << ") out of " << span.total << std::endl;
 
         simulationStatus.finished = false;
-        simulationStatus.nextSimulationIndex = this->simulationsSpan.from;
+        simulationStatus.nextSimulationIndex = span.from;
     }
-    stateFile.close();
 
     return simulationStatus;
 }
 
+void RestorableSimulationExecutor::performSpan(RestorableSimulation &simulation, const SimulationsSpan &actualSpan,
+                                               SimulationJournal &journal, unsigned long seed,
+                                               Logger &logger) const
+{
+    simulation.prepareForSpan(actualSpan);
+    if (this->numWorkers > 1) {
+        this->doPerformParallelSimulations(simulation, actualSpan, journal, seed, logger);
+    } else {
+        simulation.seedRandomGenerators(seed);
+        this->doPerformSimulations(simulation, actualSpan, journal, logger);
+    }
+}
+
+void RestorableSimulationExecutor::performScheduledSimulations(RestorableSimulation &simulation,
+                                                               const std::string &stateFilename, unsigned long seed,
+                                                               Logger &logger) const
+{
+    std::size_t spanSize = this->simulationsSpan.to - this->simulationsSpan.from;
+    std::size_t numChunks = (spanSize + this->chunkSize - 1) / this->chunkSize;
+
+    // Passes are repeated as long as some work was done, because in the meantime other claims may have expired
+    bool anyChunkPerformed;
+    do {
+        anyChunkPerformed = false;
+        for (std::size_t chunk{}; chunk < numChunks; chunk++) {
+            SimulationsSpan chunkSpan = this->simulationsSpan;
+            chunkSpan.from = this->simulationsSpan.from + chunk * this->chunkSize;
+            chunkSpan.to = std::min(chunkSpan.from + this->chunkSize, this->simulationsSpan.to);
+            std::string chunkStateFilename = this->prepareChunkStateFilename(stateFilename, chunkSpan);
+            if (SimulationJournal::isFinished(this->workingDirectory / chunkStateFilename))
+                continue;
+
+            auto claimPath = this->tryClaimingChunk(chunkStateFilename, logger);
+            if (!claimPath.has_value())
+                continue;
+
+            logger.info() << "Claimed chunk [" << chunkSpan.from << ", " << chunkSpan.to << ")" << std::endl;
+            ClaimHeartbeat heartbeat(*claimPath, this->claimTimeout);
+            simulation.clear();
+            SimulationJournal journal(this->workingDirectory / chunkStateFilename, chunkSpan);
+            SimulationStatus simulationStatus = this->tryRestoringSimulation(simulation, chunkSpan, journal, logger);
+            SimulationsSpan actualSpan = chunkSpan;
+            actualSpan.from = simulationStatus.nextSimulationIndex;
+            this->performSpan(simulation, actualSpan, journal, seed, logger);
+            anyChunkPerformed = true;
+        }
+    } while (anyChunkPerformed);
+
+    simulation.clear();
+}
+
+/**
+ * @brief Tries to claim the chunk with a given state file name. If the chunk is already claimed, but the claim was not
+ * touched for claimTimeout, it is stolen by creating the claim file of the next generation. Returns the path to the
+ * created claim file or std::nullopt if the chunk could not be claimed.
+ */
+std::optional<std::filesystem::path>
+RestorableSimulationExecutor::tryClaimingChunk(const std::string &chunkStateFilename, Logger &logger) const {
+    std::string claimPrefix = chunkStateFilename + ".claim.";
+    std::optional<std::size_t> lastGeneration;
+    std::filesystem::path lastClaimPath;
+    for (const auto &entry : std::filesystem::directory_iterator(this->workingDirectory)) {
+        std::string name = entry.path().filename();
+        if (name.rfind(claimPrefix, 0) != 0)
+            continue;
+        std::string generationString = name.substr(claimPrefix.size());
+        auto isDigit = [](unsigned char c) { return std::isdigit(c); };
+        if (generationString.empty() || !std::all_of(generationString.begin(), generationString.end(), isDigit))
+            continue;
+
+        std::size_t generation = std::stoul(generationString);
+        if (!lastGeneration.has_value() || generation > *lastGeneration) {
+            lastGeneration = generation;
+            lastClaimPath = entry.path();
+        }
+    }
+
+    std::size_t generation{};
+    if (lastGeneration.has_value()) {
+        std::error_code error;
+        auto lastTouched = std::filesystem::last_write_time(lastClaimPath, error);
+        if (error || std::filesystem::file_time_type::clock::now() - lastTouched < this->claimTimeout)
+            return std::nullopt;
+        generation = *lastGeneration + 1;
+    }
+
+    std::filesystem::path claimPath = this->workingDirectory / (claimPrefix + std::to_string(generation));
+    if (!create_file_exclusively(claimPath))
+        return std::nullopt;
+    if (generation > 0)
+        logger.warn() << "Claim " << lastClaimPath.filename() << " has expired, stealing the chunk" << std::endl;
+    return claimPath;
+}
+
+/**
+ * @brief Replaces from and to in @a stateFilename by the bounds of @a chunkSpan.
+ */
+std::string RestorableSimulationExecutor::prepareChunkStateFilename(const std::string &stateFilename,
+                                                                    const SimulationsSpan &chunkSpan) const
+{
+    std::regex fromMatcher(R"(_from\.[0-9]+)");
+    std::regex toMatcher(R"(_to\.[0-9]+)");
+    Expects(std::regex_search(stateFilename, fromMatcher));
+    Expects(std::regex_search(stateFilename, toMatcher));
+
+    std::string chunkStateFilename = std::regex_replace(stateFilename, fromMatcher,
+                                                        "_from." + std::to_string(chunkSpan.from));
+    return std::regex_replace(chunkStateFilename, toMatcher, "_to." + std::to_string(chunkSpan.to));
+}
+
 void RestorableSimulationExecutor::doPerformSimulations(RestorableSimulation &simulation,
                                                         const SimulationsSpan &actualSpan,
-                                                        const std::string &stateFilename, Logger &logger) const
+                                                        SimulationJournal &journal, Logger &logger) const
 {
     std::string previousAdditionalText = logger.getAdditionalText();
 
-    for (std::size_t i = actualSpan.from; i < actualSpan.to; i++) {
-        if (previousAdditionalText.empty())
-            logger.setAdditionalText("i=" + std::to_string(i));
-        else
-            logger.setAdditionalText(previousAdditionalText + ", i=" + std::to_string(i));
+    // When the state is stored, the simulation holds only the state of the current simulation, which is appended to
+    // the journal. The accumulated state is restored from the journal afterwards (also after an exception)
+    try {
+        for (std::size_t i = actualSpan.from; i < actualSpan.to; i++) {
+            if (previousAdditionalText.empty())
+                logger.setAdditionalText("i=" + std::to_string(i));
+            else
+                logger.setAdditionalText(previousAdditionalText + ", i=" + std::to_string(i));
 
-        simulation.performSimulation(i, actualSpan.total, logger);
+            if (this->storeSimulations)
+                simulation.clear();
+            simulation.performSimulation(i, actualSpan.total, logger);
+            if (!this->storeSimulations)
+                continue;
 
+            journal.append(simulation, i + 1);
+            if (journal.shouldBeCompacted()) {
+                simulation.clear();
+                journal.restore(simulation);
+                journal.compact(simulation);
+            }
+        }
+    } catch (...) {
+        logger.setAdditionalText(previousAdditionalText);
         if (this->storeSimulations) {
-            std::ofstream storeFile(this->workingDirectory / stateFilename, std::ios::out | std::ios::binary);
-            SimulationStatus simulationStatus;
-            simulationStatus.finished = (i == actualSpan.to - 1);
-            simulationStatus.nextSimulationIndex = i + 1;
-            this->doStoreSimulations(simulation, storeFile, simulationStatus);
+            simulation.clear();
+            journal.restore(simulation);
         }
+        throw;
     }
 
     logger.setAdditionalText(previousAdditionalText);
+    if (this->storeSimulations) {
+        simulation.clear();
+        journal.restore(simulation);
+    }
+}
+
+void RestorableSimulationExecutor::doPerformParallelSimulations(RestorableSimulation &simulation,
+                                                                const SimulationsSpan &actualSpan,
+                                                                SimulationJournal &journal, unsigned long seed,
+                                                                Logger &logger) const
+{
+    std::string previousAdditionalText = logger.getAdditionalText();
+    Logger::LogType verbosityLevel = logger.getVerbosityLevel();
+
+    if (!BLASThreadsLimit::isSupported()) {
+        logger.warn() << "BLAS vendor was not recognized and its threads cannot be limited in " << this->numWorkers;
+        logger << " workers. Set OPENBLAS_NUM_THREADS=1 or MKL_NUM_THREADS=1 to avoid oversubscription" << std::endl;
+    }
+    BLASThreadsLimit blasThreadsLimit;
+
+    std::vector<std::unique_ptr<RestorableSimulation>> workerSimulations;
+    for (std::size_t i{}; i < this->numWorkers; i++) {
+        workerSimulations.push_back(this->workerFactory());
+        workerSimulations.back()->prepareForSpan(actualSpan);
+    }
+
+    std::map<std::size_t, WorkerResult> results;
+    std::mutex resultsMutex;
+    std::condition_variable resultReady;
+    std::atomic<std::size_t> nextSimulationIndex = actualSpan.from;
+    std::atomic<bool> stopped = false;
+
+    auto worker = [&](RestorableSimulation &workerSimulation) {
+        // Parallelism is already on the level of simulations
+        _OMP_SET_NUM_THREADS(1);
+        BLASThreadsLimit::limitCurrentThread();
+
+        while (!stopped) {
+            std::size_t i = nextSimulationIndex++;
+            if (i >= actualSpan.to)
+                break;
+
+            WorkerResult result;
+            std::ostringstream logStream;
+            Logger workerLogger(logStream);
+            workerLogger.setVerbosityLevel(verbosityLevel);
+            if (previousAdditionalText.empty())
+                workerLogger.setAdditionalText("i=" + std::to_string(i));
+            else
+                workerLogger.setAdditionalText(previousAdditionalText + ", i=" + std::to_string(i));
+
+            try {
+                workerSimulation.clear();
+                workerSimulation.seedRandomGenerators(seed);
+                workerSimulation.performSimulation(i, actualSpan.total, workerLogger);
+                std::ostringstream stateStream;
+                workerSimulation.storeState(stateStream);
+                result.state = stateStream.str();
+            } catch (...) {
+                result.exception = std::current_exception();
+                stopped = true;
+            }
+            result.log = logStream.str();
+
+            std::lock_guard<std::mutex> lock(resultsMutex);
+            results[i] = std::move(result);
+            resultReady.notify_one();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(this->numWorkers);
+    for (auto &workerSimulation : workerSimulations)
+        threads.emplace_back(worker, std::ref(*workerSimulation));
+
+    // Simulations are joined in the ascending order, so that the results are the same as in the serial mode
+    std::exception_ptr exception;
+    try {
+        for (std::size_t i = actualSpan.from; i < actualSpan.to; i++) {
+            WorkerResult result;
+            {
+                std::unique_lock<std::mutex> lock(resultsMutex);
+                resultReady.wait(lock, [&results, i]() { return results.find(i) != results.end(); });
+                result = std::move(results[i]);
+                results.erase(i);
+            }
+
+            static_cast<std::ostream &>(logger) << result.log;
+            if (result.exception != nullptr)
+                std::rethrow_exception(result.exception);
+
+            std::istringstream stateStream(result.state);
+            simulation.joinRestoredState(stateStream);
+            if (this->storeSimulations) {
+                journal.append(result.state, i + 1);
+                if (journal.shouldBeCompacted())
+                    journal.compact(simulation);
+            }
+        }
+    } catch (...) {
+        exception = std::current_exception();
+        stopped = true;
+    }
+
+    for (auto &thread : threads)
+        thread.join();
+    if (exception != nullptr)
+        std::rethrow_exception(exception);
+}
+
+void RestorableSimulationExecutor::setParallelWorkers(std::size_t numWorkers_, SimulationFactory workerFactory_) {
+    Expects(numWorkers_ > 0);
+    if (numWorkers_ > 1)
+        Expects(workerFactory_ != nullptr);
+
+    this->numWorkers = numWorkers_;
+    this->workerFactory = std::move(workerFactory_);
+}
+
+void RestorableSimulationExecutor::setDynamicScheduling(std::size_t chunkSize_, std::chrono::seconds claimTimeout_) {
+    if (chunkSize_ > 0) {
+        Expects(this->splitWorkload);
+        Expects(claimTimeout_.count() > 0);
+    }
+
+    this->chunkSize = chunkSize_;
+    this->claimTimeout = claimTimeout_;
 }
 
 void RestorableSimulationExecutor::superviseSimulationsSplit(RestorableSimulation &simulation,
@@ -125,6 +463,12 @@ void RestorableSimulationExecutor::superviseSimulationsSplit(RestorableSimulatio
     }
     logger.info() << "No state files are missing. Checking if all are finished." << std::endl;
 
+    if (this->chunkSize > 0) {
+        this->shouldSaveSimulation_ = this->tryMergingScheduledSimulations(simulation, stateFilename, stateFileDatas,
+                                                                           logger);
+        return;
+    }
+
     bool allSimulationsFinished = this->joinAllRestoredSimulations(simulation, stateFileDatas);
     this->shouldSaveSimulation_ = allSimulationsFinished;
     if (allSimulationsFinished) {
@@ -136,38 +480,91 @@ void RestorableSimulationExecutor::superviseSimulationsSplit(RestorableSimulatio
     }
 }
 
+/**
+ * @brief In the dynamic scheduling mode, the state files are merged only if all chunks are finished and no other
+ * process is already merging them. Other chunks may be still performed - then the last process will merge them.
+ */
+bool RestorableSimulationExecutor::tryMergingScheduledSimulations(RestorableSimulation &simulation,
+                                                                  const std::string &stateFilename,
+                                                                  const std::vector<StateFileData> &stateFileDatas,
+                                                                  Logger &logger) const
+{
+    auto isFinished = [](const StateFileData &data) { return SimulationJournal::isFinished(data.path); };
+    bool allChunksFinished = std::all_of(stateFileDatas.begin(), stateFileDatas.end(), isFinished);
+    if (!allChunksFinished) {
+        logger.info() << "Some chunks are still being performed. The last process will merge them." << std::endl;
+        return false;
+    }
+
+    std::filesystem::path mergeLockPath = this->workingDirectory / (stateFilename + ".merge");
+    if (!create_file_exclusively(mergeLockPath)) {
+        logger.info() << "Another process is merging the chunks. If it is not true, remove " << mergeLockPath;
+        logger << " and rerun." << std::endl;
+        return false;
+    }
+
+    if (!this->joinAllRestoredSimulations(simulation, stateFileDatas)) {
+        logger.error() << "Some simulations must have been interrupted. Rerun the whole batch." << std::endl;
+        std::filesystem::remove(mergeLockPath);
+        return false;
+    }
+
+    logger.info() << "All simulations are finished. Removing state and claim files." << std::endl;
+    std::string claimPattern = this->prepareStateFilenamePattern(stateFilename);
+    claimPattern.pop_back();
+    std::regex claimMatcher(claimPattern + R"(\.claim\.[0-9]+$)");
+    for (const auto &entry : std::filesystem::directory_iterator(this->workingDirectory)) {
+        std::string name = entry.path().filename();
+        if (std::regex_search(name, claimMatcher))
+            std::filesystem::remove(entry.path());
+    }
+    for (const auto &stateFileData : stateFileDatas)
+        std::filesystem::remove(stateFileData.path);
+    std::filesystem::remove(mergeLockPath);
+    return true;
+}
+
 bool RestorableSimulationExecutor::joinAllRestoredSimulations(RestorableSimulation &simulation,
                                                               const std::vector<StateFileData> &stateFileDatas) const
 {
     simulation.clear();
     for (const auto &stateFileData : stateFileDatas) {
-        std::ifstream file(stateFileData.path, std::ios::in | std::ios::binary);
-        Assert(file);
-        auto [finished, size] = joinRestoredSimulations(simulation, file);
-        if (!finished) {
+        SimulationsSpan span = this->simulationsSpan;
+        span.from = stateFileData.from;
+        span.to = stateFileData.to;
+        SimulationJournal journal(stateFileData.path, span);
+        bool journalFound = journal.restore(simulation);
+        Assert(journalFound);
+        if (!journal.isFinished()) {
             simulation.clear();
             return false;
-
         }
     }
     return true;
 }
 
+/**
+ * @brief Checks if the ranges of state files (which can be arbitrary chunks, given in any order) cover
+ * [0, SimulationsSpan::total) without overlaps.
+ */
 RestorableSimulationExecutor::StateFilesCoverage RestorableSimulationExecutor
     ::checkStateFilesCoverage(const std::vector<RestorableSimulationExecutor::StateFileData> &stateFileDatas) const
 {
-    for (std::size_t i = 0; i < stateFileDatas.size() - 1; i++)
-        if (stateFileDatas[i].to > stateFileDatas[i + 1].from)
+    std::vector<StateFileData> sortedStateFileDatas = stateFileDatas;
+    std::sort(sortedStateFileDatas.begin(), sortedStateFileDatas.end());
+
+    bool gapsFound = false;
+    std::size_t coveredTo{};
+    for (const auto &stateFileData : sortedStateFileDatas) {
+        if (stateFileData.from < coveredTo)
             return StateFilesCoverage::BROKEN;
+        if (stateFileData.from > coveredTo)
+            gapsFound = true;
+        coveredTo = stateFileData.to;
+    }
 
-    if (stateFileDatas.front().from != 0)
+    if (gapsFound || coveredTo != this->simulationsSpan.total)
         return StateFilesCoverage::INCOMPLETE;
-    if (stateFileDatas.back().to != this->simulationsSpan.total)
-        return StateFilesCoverage::INCOMPLETE;
-    for (std::size_t i = 0; i < stateFileDatas.size() - 1; i++)
-        if (stateFileDatas[i].to != stateFileDatas[i + 1].from)
-            return StateFilesCoverage::INCOMPLETE;
-
     return StateFilesCoverage::COMPLETE;
 }
 
@@ -207,21 +604,3 @@ std::string RestorableSimulationExecutor::prepareStateFilenamePattern(const std:
     pattern = "^" + pattern + "$";
     return pattern;
 }
-
-void RestorableSimulationExecutor::doStoreSimulations(const RestorableSimulation &simulation, std::ostream &binaryOut,
-                                                      const SimulationStatus &simulationStatus) const
-{
-    binaryOut.write(reinterpret_cast<const char*>(&simulationStatus), sizeof(simulationStatus));
-    Assert(binaryOut);
-    simulation.storeState(binaryOut);
-}
-
-RestorableSimulationExecutor::SimulationStatus
-RestorableSimulationExecutor::joinRestoredSimulations(RestorableSimulation &simulation, std::istream &binaryIn) const
-{
-    SimulationStatus simulationStatus{};
-    binaryIn.read(reinterpret_cast<char*>(&simulationStatus), sizeof(simulationStatus));
-    Assert(binaryIn);
-    simulation.joinRestoredState(binaryIn);
-    return simulationStatus;
-}
@@ -7,8 +7,12 @@
 
 #include <memory>
 #include <filesystem>
+#include <functional>
+#include <optional>
+#include <chrono>
 
 #include "RestorableSimulation.h"
+#include "SimulationJournal.h"
 #include "utils/Logger.h"
 
 /**
@@ -16,6 +20,13 @@
  * simulations split between multiple processes.
  */
 class RestorableSimulationExecutor {
+public:
+    /**
+     * @brief A function creating a new, independent instance of the simulation, used by parallel workers. See
+     * setParallelWorkers().
+     */
+    using SimulationFactory = std::function<std::unique_ptr<RestorableSimulation>()>;
+
 private:
     struct SimulationStatus {
         bool finished{};
@@ -44,17 +55,35 @@ private:
     bool splitWorkload{};
     bool shouldSaveSimulation_{};
     std::filesystem::path workingDirectory;
+    std::size_t numWorkers = 1;
+    SimulationFactory workerFactory;
+    std::size_t chunkSize{};
+    std::chrono::seconds claimTimeout{};
 
-    void doStoreSimulations(const RestorableSimulation &simulation, std::ostream &binaryOut,
-                            const SimulationStatus &simulationStatus) const;
     void superviseSimulationsSplit(RestorableSimulation &simulation, const std::string &stateFilename,
                                    Logger &logger);
 
+    void performSpan(RestorableSimulation &simulation, const SimulationsSpan &actualSpan, SimulationJournal &journal,
+                     unsigned long seed, Logger &logger) const;
     void doPerformSimulations(RestorableSimulation &simulation, const SimulationsSpan &actualSpan,
-                              const std::string &stateFilename, Logger &logger) const;
+                              SimulationJournal &journal, Logger &logger) const;
+    void doPerformParallelSimulations(RestorableSimulation &simulation, const SimulationsSpan &actualSpan,
+                                      SimulationJournal &journal, unsigned long seed, Logger &logger) const;
+
+    void performScheduledSimulations(RestorableSimulation &simulation, const std::string &stateFilename,
+                                     unsigned long seed, Logger &logger) const;
+    [[nodiscard]] std::optional<std::filesystem::path> tryClaimingChunk(const std::string &chunkStateFilename,
+                                                                      Logger &logger) const;
+    [[nodiscard]] std::string prepareChunkStateFilename(const std::string &stateFilename,
+                                                        const SimulationsSpan &chunkSpan) const;
+    [[nodiscard]] bool tryMergingScheduledSimulations(RestorableSimulation &simulation,
+                                                      const std::string &stateFilename,
+                                                      const std::vector<StateFileData> &stateFileDatas,
+                                                      Logger &logger) const;
 
     [[nodiscard]] SimulationStatus tryRestoringSimulation(RestorableSimulation &simulation,
-                                                          const std::string &stateFilename, Logger &logger) const;
+                                                          const SimulationsSpan &span, SimulationJournal &journal,
+                                                          Logger &logger) const;
 
     [[nodiscard]] bool joinAllRestoredSimulations(RestorableSimulation &simulation,
                                                   const std::vector<StateFileData> &stateFileDatas) const;
@@ -62,7 +91,6 @@ private:
     [[nodiscard]] std::string prepareStateFilenamePattern(const std::string &stateFilename) const;
     [[nodiscard]] std::vector<StateFileData> discoverStateFiles(const std::string &stateFilename) const;
     [[nodiscard]] StateFilesCoverage checkStateFilesCoverage(const std::vector<StateFileData> &stateFileDatas) const;
-    SimulationStatus joinRestoredSimulations(RestorableSimulation &simulation, std::istream &binaryIn) const;
 
 public:
     /**
@@ -84,10 +112,11 @@ public:
      * This is the short story.
      * <p> The long story: first of all, it checks, whether there exists a state file corresponding to this simulation
      * span. If so, it concludes, that this span was already being performed and had been interrupted. So it loads
-     * already done simulations and performs the rest. After each simulation the state is stored (provided
-     * secureSimulationState was set to true). Simulation::seedRandomGenerators is invoked with @a seed increased by the
-     * first simulation index to be performed. Note, that it would yield different results for interrupted vs not
-     * interrupted simulations, but it guarantees that simulations won't be repeated.
+     * already done simulations and performs the rest. After each simulation its state is appended to the state file,
+     * which is a SimulationJournal (provided secureSimulationState was set to true), so the cost of storing does not
+     * grow with the number of simulations. Simulation::seedRandomGenerators is invoked with @a seed and the
+     * simulations select independent random streams based on their indices (see RND), so the results are the same
+     * for interrupted vs not interrupted simulations. For parallel workers see setParallelWorkers().
      * <p> Later behaviour is determined by @a splitWorkload flag from the constructor. If false, the work is done,
      * state file is deleted, the method returns and shouldSaveSimulation() will return true. If the flag is true:
      * <ul>
@@ -100,9 +129,43 @@ public:
      * either the last running process will finish the job or user intervention is required for interrupted simulations
      * or broken ranges.
      * </ul>
+     * <p> If dynamic scheduling is enabled (see setDynamicScheduling()), the span is instead performed in chunks
+     * claimed by the processes sharing @a workingDirectory.
      */
     void performSimulations(RestorableSimulation &simulation, unsigned long seed, Logger &logger);
 
+    /**
+     * @brief Enables performing @a numWorkers_ simulations at once in separate threads.
+     * @details Each thread owns a separate simulation created by @a workerFactory_. For each simulation index it is
+     * cleared, seeded with the seed from performSimulations() and the simulation is performed.
+     * Then its state is joined to the main simulation passed to performSimulations() in the ascending order of
+     * indices (see Restorable::joinRestoredState()), so the results do not depend on the number of workers or the
+     * order, in which simulations finish. The state file is stored after each joined simulation, as in the serial
+     * mode. If secureSimulationState from the constructor is true, the serial mode also joins the states of single
+     * simulations in the same order, so the results are the same. Otherwise, serial simulations accumulate their
+     * results directly, which may differ by rounding errors (for example for streaming SampleCollector -s, where
+     * merging statistics is not bitwise equivalent to adding the samples one by one). OpenMP in worker threads is
+     * limited to a single thread, as well as OpenBLAS and MKL, if CMake detected them (see BLASThreadsLimit). For
+     * other BLAS vendors a warning is logged. For @a numWorkers_ equal 1 the serial mode is restored.
+     */
+    void setParallelWorkers(std::size_t numWorkers_, SimulationFactory workerFactory_);
+
+    /**
+     * @brief Enables the dynamic scheduling of the simulations span between many processes (using the same span and
+     * @a workingDirectory) instead of static from/to splits. It requires @a splitWorkload to be true.
+     * @details <p> The span is divided into chunks of @a chunkSize_ simulations. Each process claims chunks by
+     * atomically creating claim files in @a workingDirectory, performs them (each chunk has its own state file, named
+     * as if from/to were the chunk's bounds) and claims next ones, until no chunks are left. While a chunk is being
+     * performed, its claim file is touched periodically. If it has not been touched for @a claimTimeout_, the owner
+     * is considered dead and the chunk is stolen (continuing from its state file) by claiming the next generation of
+     * the claim. The results do not depend on which process performs which chunk, since each simulation uses its own
+     * random stream.
+     * <p> The last process to finish merges all state files in the ascending order (guarded by a merge lock file)
+     * and then shouldSaveSimulation() returns true. All state, claim and lock files are removed afterwards.
+     * For @a chunkSize_ equal 0 static splits are restored.
+     */
+    void setDynamicScheduling(std::size_t chunkSize_, std::chrono::seconds claimTimeout_);
+
     /**
      * @brief After invoking performSimulations(), it indicates, weather results should be saved of they are not ready.
      * @details Unless @a splitWorkload from the constructor is true, it will always return true for non-interrupted
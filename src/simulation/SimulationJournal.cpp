@@ -0,0 +1,260 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#include <fstream>
+#include <sstream>
+#include <array>
+#include <algorithm>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "SimulationJournal.h"
+#include "utils/Assertions.h"
+
+namespace {
+    std::array<std::uint32_t, 256> make_crc32_table() {
+        std::array<std::uint32_t, 256> table{};
+        for (std::uint32_t i{}; i < 256; i++) {
+            std::uint32_t value = i;
+            for (std::size_t bit{}; bit < 8; bit++)
+                value = (value & 1) ? (0xEDB88320 ^ (value >> 1)) : (value >> 1);
+            table[i] = value;
+        }
+        return table;
+    }
+
+    std::uint32_t crc32(const char *data, std::size_t size, std::uint32_t previousCrc = 0) {
+        static const auto table = make_crc32_table();
+        std::uint32_t crc = ~previousCrc;
+        for (std::size_t i{}; i < size; i++)
+            crc = table[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    template<typename T>
+    void write_value(std::ostream &out, T value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    template<typename T>
+    bool read_value(std::istream &in, T &value) {
+        in.read(reinterpret_cast<char*>(&value), sizeof(value));
+        return static_cast<bool>(in);
+    }
+
+    /**
+     * @brief Flushes the file or the directory @a path to the disk using fsync, so that it survives a crash of the
+     * machine.
+     */
+    void sync_to_disk(const std::filesystem::path &path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        Assert(fd >= 0);
+        int result = ::fsync(fd);
+        ::close(fd);
+        Assert(result == 0);
+    }
+
+    std::filesystem::path parent_directory(const std::filesystem::path &path) {
+        std::filesystem::path parent = path.parent_path();
+        return parent.empty() ? std::filesystem::path(".") : parent;
+    }
+
+    struct RecordHeader {
+        std::uint64_t nextSimulationIndex{};
+        std::uint64_t payloadSize{};
+        std::uint32_t checksum{};
+
+        [[nodiscard]] std::uint32_t calculateChecksum(const std::string &payload) const {
+            std::uint32_t crc = crc32(reinterpret_cast<const char*>(&this->nextSimulationIndex),
+                                      sizeof(this->nextSimulationIndex));
+            crc = crc32(reinterpret_cast<const char*>(&this->payloadSize), sizeof(this->payloadSize), crc);
+            return crc32(payload.data(), payload.size(), crc);
+        }
+    };
+
+    bool read_header(std::istream &in, const char (&magic)[8], SimulationsSpan &span) {
+        char magicRead[8]{};
+        in.read(magicRead, sizeof(magicRead));
+        if (!in || !std::equal(std::begin(magic), std::end(magic), magicRead))
+            return false;
+
+        std::uint64_t from{}, to{};
+        if (!read_value(in, from) || !read_value(in, to))
+            return false;
+        span.from = from;
+        span.to = to;
+        return true;
+    }
+}
+
+SimulationJournal::SimulationJournal(std::filesystem::path path, const SimulationsSpan &span)
+        : path{std::move(path)}, span{span}, nextSimulationIndex{span.from}
+{
+    Expects(span.from < span.to);
+}
+
+bool SimulationJournal::restore(Restorable &restorable) {
+    return this->scan(&restorable);
+}
+
+/**
+ * @brief Reads all records, validating them and joining them to @a restorable, if it is not nullptr. The torn final
+ * record is truncated from the file and the file with an invalid header is removed (also only if @a restorable is not
+ * nullptr).
+ */
+bool SimulationJournal::scan(Restorable *restorable) {
+    this->nextSimulationIndex = this->span.from;
+    this->numRecords = 0;
+    this->numSimulationsInFirstRecord = 0;
+    this->tornRecordDropped = false;
+    this->invalidHeaderDropped = false;
+
+    std::ifstream in(this->path, std::ios::in | std::ios::binary);
+    if (!in.is_open())
+        return false;
+
+    SimulationsSpan spanRead;
+    if (!read_header(in, MAGIC, spanRead)) {
+        // The same as for the torn record - nothing can be restored, so the span is performed from scratch
+        in.close();
+        this->invalidHeaderDropped = true;
+        if (restorable != nullptr)
+            std::filesystem::remove(this->path);
+        return false;
+    }
+    Assert(spanRead.from == this->span.from && spanRead.to == this->span.to);
+
+    std::streamoff validSize = in.tellg();
+    while (in.peek() != std::ifstream::traits_type::eof()) {
+        RecordHeader recordHeader;
+        std::string payload;
+        bool recordValid = read_value(in, recordHeader.nextSimulationIndex)
+                           && read_value(in, recordHeader.payloadSize)
+                           && read_value(in, recordHeader.checksum);
+        if (recordValid) {
+            std::uintmax_t fileSize = std::filesystem::file_size(this->path);
+            recordValid = recordHeader.payloadSize <= fileSize;
+        }
+        if (recordValid) {
+            payload.resize(recordHeader.payloadSize);
+            in.read(payload.data(), payload.size());
+            recordValid = in && recordHeader.checksum == recordHeader.calculateChecksum(payload)
+                          && recordHeader.nextSimulationIndex > this->nextSimulationIndex
+                          && recordHeader.nextSimulationIndex <= this->span.to;
+        }
+
+        if (!recordValid) {
+            this->tornRecordDropped = true;
+            break;
+        }
+
+        if (restorable != nullptr) {
+            std::istringstream payloadStream(payload);
+            restorable->joinRestoredState(payloadStream);
+        }
+        if (this->numRecords == 0)
+            this->numSimulationsInFirstRecord = recordHeader.nextSimulationIndex - this->span.from;
+        this->nextSimulationIndex = recordHeader.nextSimulationIndex;
+        this->numRecords++;
+        validSize = in.tellg();
+    }
+    in.close();
+
+    if (this->tornRecordDropped && restorable != nullptr)
+        std::filesystem::resize_file(this->path, validSize);
+    return true;
+}
+
+void SimulationJournal::append(const Restorable &restorable, std::size_t nextSimulationIndex_) {
+    std::ostringstream stateStream;
+    restorable.storeState(stateStream);
+    this->append(stateStream.str(), nextSimulationIndex_);
+}
+
+void SimulationJournal::append(const std::string &state, std::size_t nextSimulationIndex_) {
+    Expects(nextSimulationIndex_ > this->nextSimulationIndex);
+    Expects(nextSimulationIndex_ <= this->span.to);
+
+    bool exists = std::filesystem::exists(this->path);
+    std::ofstream out(this->path, std::ios::out | std::ios::binary | std::ios::app);
+    Assert(out.is_open());
+    if (!exists)
+        this->writeHeader(out);
+    this->writeRecord(out, state, nextSimulationIndex_);
+    out.close();
+    Assert(out);
+    sync_to_disk(this->path);
+    if (!exists)
+        sync_to_disk(parent_directory(this->path));
+
+    if (this->numRecords == 0)
+        this->numSimulationsInFirstRecord = nextSimulationIndex_ - this->span.from;
+    this->nextSimulationIndex = nextSimulationIndex_;
+    this->numRecords++;
+}
+
+void SimulationJournal::compact(const Restorable &accumulatedRestorable) {
+    Expects(this->numRecords > 0);
+
+    std::ostringstream stateStream;
+    accumulatedRestorable.storeState(stateStream);
+
+    std::filesystem::path temporaryPath = this->path;
+    temporaryPath += ".tmp";
+    std::ofstream out(temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    Assert(out.is_open());
+    this->writeHeader(out);
+    this->writeRecord(out, stateStream.str(), this->nextSimulationIndex);
+    out.close();
+    Assert(out);
+    // The temporary file has to be on the disk before it replaces the journal and the rename itself has to reach the
+    // disk before the old records are considered gone
+    sync_to_disk(temporaryPath);
+    std::filesystem::rename(temporaryPath, this->path);
+    sync_to_disk(parent_directory(this->path));
+
+    this->numRecords = 1;
+    this->numSimulationsInFirstRecord = this->nextSimulationIndex - this->span.from;
+}
+
+bool SimulationJournal::shouldBeCompacted() const {
+    return this->numRecords > MIN_RECORDS_TO_COMPACT && this->numRecords - 1 >= this->numSimulationsInFirstRecord;
+}
+
+void SimulationJournal::writeHeader(std::ostream &out) const {
+    out.write(MAGIC, sizeof(MAGIC));
+    write_value<std::uint64_t>(out, this->span.from);
+    write_value<std::uint64_t>(out, this->span.to);
+}
+
+void SimulationJournal::writeRecord(std::ostream &out, const std::string &state,
+                                    std::size_t nextSimulationIndex_) const
+{
+    RecordHeader recordHeader;
+    recordHeader.nextSimulationIndex = nextSimulationIndex_;
+    recordHeader.payloadSize = state.size();
+    recordHeader.checksum = recordHeader.calculateChecksum(state);
+
+    write_value(out, recordHeader.nextSimulationIndex);
+    write_value(out, recordHeader.payloadSize);
+    write_value(out, recordHeader.checksum);
+    out.write(state.data(), state.size());
+}
+
+bool SimulationJournal::isFinished(const std::filesystem::path &path) {
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    if (!in.is_open())
+        return false;
+
+    SimulationsSpan span;
+    if (!read_header(in, MAGIC, span) || span.from >= span.to)
+        return false;
+    in.close();
+
+    SimulationJournal journal(path, span);
+    journal.scan(nullptr);
+    return journal.isFinished();
+}
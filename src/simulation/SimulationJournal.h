@@ -0,0 +1,100 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#ifndef MBL_ED_SIMULATIONJOURNAL_H
+#define MBL_ED_SIMULATIONJOURNAL_H
+
+#include <filesystem>
+#include <string>
+#include <cstdint>
+
+#include "Restorable.h"
+#include "SimulationsSpan.h"
+
+/**
+ * @brief An append-only file storing the state of a span of simulations, used to restore them after interruption.
+ * @details <p> The file starts with a header: magic bytes and the span of simulations. Then the records follow. Each
+ * record consists of the index of the next simulation to be performed after the record, the size of the payload,
+ * CRC-32 checksum and the payload itself, which is a state (see Restorable::storeState()) to be joined with the
+ * states of the previous records. Thus, after each simulation only the state of this single simulation is appended,
+ * so the cost of writing does not grow with the number of performed simulations.
+ * <p> Records are joined in order on restore (see Restorable::joinRestoredState()). A torn or corrupted final record,
+ * for example after the crash during writing, is detected, dropped and truncated from the file. Similarly, a file with
+ * a short or invalid header (a crash while creating the file or a state file from before the journal was introduced)
+ * is removed and the simulations are started from scratch.
+ * <p> Periodically, the journal should be compacted: rewritten as a single record with the accumulated state. It is
+ * done when the number of records since the last compaction reaches the number of simulations in the compacted
+ * record (but not sooner than after MIN_RECORDS_TO_COMPACT records), so the total cost of compactions is linear in the
+ * number of simulations even for the states growing with each simulation.
+ */
+class SimulationJournal {
+private:
+    static constexpr char MAGIC[8] = {'M', 'B', 'L', 'E', 'D', 'J', 'R', '1'};
+    static constexpr std::size_t MIN_RECORDS_TO_COMPACT = 64;
+
+    std::filesystem::path path;
+    SimulationsSpan span;
+    std::size_t nextSimulationIndex{};
+    std::size_t numRecords{};
+    std::size_t numSimulationsInFirstRecord{};
+    bool tornRecordDropped{};
+    bool invalidHeaderDropped{};
+
+    bool scan(Restorable *restorable);
+    void writeHeader(std::ostream &out) const;
+    void writeRecord(std::ostream &out, const std::string &state, std::size_t nextSimulationIndex_) const;
+
+public:
+    /**
+     * @brief Prepares the journal in the file @a path for simulations [@a span.from, @a span.to). Nothing is read or
+     * written yet.
+     */
+    SimulationJournal(std::filesystem::path path, const SimulationsSpan &span);
+
+    /**
+     * @brief Joins the states from all valid records into @a restorable. Returns false if the file does not exist.
+     * @details A torn final record is dropped and removed from the file (see hasDroppedTornRecord()). A file with a
+     * short or invalid header is removed and false is returned (see hasDroppedInvalidHeader()).
+     */
+    bool restore(Restorable &restorable);
+
+    /**
+     * @brief Appends a record with the state of @a restorable, after which the next simulation is
+     * @a nextSimulationIndex_. The file (with the header) is created if it does not exist. The record is synced to the
+     * disk before returning, so it survives a crash of the machine.
+     */
+    void append(const Restorable &restorable, std::size_t nextSimulationIndex_);
+
+    /**
+     * @brief The same as append(const Restorable &, std::size_t), but the state is already stored in @a state.
+     */
+    void append(const std::string &state, std::size_t nextSimulationIndex_);
+
+    /**
+     * @brief Rewrites the journal as a single record with the state of @a accumulatedRestorable, which should
+     * contain joined states of all records. The file is replaced atomically: the new file is synced to the disk
+     * before it is renamed over the old one and the directory is synced afterwards.
+     */
+    void compact(const Restorable &accumulatedRestorable);
+
+    /**
+     * @brief Returns true if the journal should be compacted according to the policy described in the class
+     * description.
+     */
+    [[nodiscard]] bool shouldBeCompacted() const;
+
+    [[nodiscard]] std::size_t getNextSimulationIndex() const { return this->nextSimulationIndex; }
+    [[nodiscard]] bool isFinished() const { return this->nextSimulationIndex == this->span.to; }
+    [[nodiscard]] bool hasDroppedTornRecord() const { return this->tornRecordDropped; }
+    [[nodiscard]] bool hasDroppedInvalidHeader() const { return this->invalidHeaderDropped; }
+
+    /**
+     * @brief Returns true if the journal in the file @a path exists and all its simulations are finished. Span is
+     * read from the header of the file - if it is short or invalid, false is returned, consistently with restore().
+     */
+    [[nodiscard]] static bool isFinished(const std::filesystem::path &path);
+};
+
+
+#endif //MBL_ED_SIMULATIONJOURNAL_H
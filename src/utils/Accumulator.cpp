@@ -0,0 +1,78 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#include <cmath>
+
+#include "Accumulator.h"
+
+void Accumulator::add(double value) {
+    auto n1 = static_cast<double>(this->count);
+    this->count++;
+    auto n = static_cast<double>(this->count);
+
+    double delta = value - this->mean;
+    double deltaN = delta / n;
+    double deltaN2 = deltaN * deltaN;
+    double term1 = delta * deltaN * n1;
+
+    this->mean += deltaN;
+    this->m4 += term1 * deltaN2 * (n*n - 3*n + 3) + 6 * deltaN2 * this->m2 - 4 * deltaN * this->m3;
+    this->m3 += term1 * deltaN * (n - 2) - 3 * deltaN * this->m2;
+    this->m2 += term1;
+}
+
+void Accumulator::merge(const Accumulator &other) {
+    if (other.count == 0)
+        return;
+    if (this->count == 0) {
+        *this = other;
+        return;
+    }
+
+    auto nA = static_cast<double>(this->count);
+    auto nB = static_cast<double>(other.count);
+    double n = nA + nB;
+    double delta = other.mean - this->mean;
+    double delta2 = delta * delta;
+
+    double newMean = this->mean + delta * nB / n;
+    double newM2 = this->m2 + other.m2 + delta2 * nA * nB / n;
+    double newM3 = this->m3 + other.m3
+                   + delta2 * delta * nA * nB * (nA - nB) / (n*n)
+                   + 3 * delta * (nA * other.m2 - nB * this->m2) / n;
+    double newM4 = this->m4 + other.m4
+                   + delta2 * delta2 * nA * nB * (nA*nA - nA*nB + nB*nB) / (n*n*n)
+                   + 6 * delta2 * (nA*nA * other.m2 + nB*nB * this->m2) / (n*n)
+                   + 4 * delta * (nA * other.m3 - nB * this->m3) / n;
+
+    this->count += other.count;
+    this->mean = newMean;
+    this->m2 = newM2;
+    this->m3 = newM3;
+    this->m4 = newM4;
+}
+
+double Accumulator::getVariance() const {
+    if (this->count < 2)
+        return 0;
+    return this->m2 / static_cast<double>(this->count - 1);
+}
+
+double Accumulator::getMeanError() const {
+    if (this->count < 2)
+        return 0;
+    return std::sqrt(this->getVariance() / static_cast<double>(this->count));
+}
+
+double Accumulator::getSkewness() const {
+    if (this->count < 2 || this->m2 == 0)
+        return 0;
+    return std::sqrt(static_cast<double>(this->count)) * this->m3 / std::pow(this->m2, 1.5);
+}
+
+double Accumulator::getExcessKurtosis() const {
+    if (this->count < 2 || this->m2 == 0)
+        return 0;
+    return static_cast<double>(this->count) * this->m4 / (this->m2 * this->m2) - 3;
+}
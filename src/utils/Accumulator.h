@@ -0,0 +1,72 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#ifndef MBL_ED_ACCUMULATOR_H
+#define MBL_ED_ACCUMULATOR_H
+
+#include <cstddef>
+
+/**
+ * @brief A constant-memory accumulator of sample statistics: count, mean and central moments up to the 4th one.
+ * @details <p> Samples are added one by one using Welford's algorithm, so the full sample vector does not have to be
+ * kept. Two accumulators can be merged exactly (Chan's/Pébay's formulas), so partial results from different
+ * simulations or processes can be combined into the accumulator equivalent to the one which has seen all samples.
+ * <p> The class is trivially copyable, so it can be stored in binary form directly (see RestorableHelper).
+ */
+class Accumulator {
+private:
+    std::size_t count{};
+    double mean{};
+    double m2{};
+    double m3{};
+    double m4{};
+
+public:
+    /**
+     * @brief Adds a single sample @a value.
+     */
+    void add(double value);
+
+    /**
+     * @brief Merges samples from @a other accumulator into this one.
+     */
+    void merge(const Accumulator &other);
+
+    /**
+     * @brief Removes all samples.
+     */
+    void clear() { *this = Accumulator{}; }
+
+    [[nodiscard]] std::size_t getCount() const { return this->count; }
+    [[nodiscard]] bool empty() const { return this->count == 0; }
+
+    /**
+     * @brief Returns the mean of the samples or 0 if there are none.
+     */
+    [[nodiscard]] double getMean() const { return this->mean; }
+
+    /**
+     * @brief Returns unbiased sample variance (with n - 1 in the denominator) or 0 for less than 2 samples.
+     */
+    [[nodiscard]] double getVariance() const;
+
+    /**
+     * @brief Returns the estimated error of the mean, so the square root of sample variance divided by the number of
+     * samples. It is 0 for less than 2 samples.
+     */
+    [[nodiscard]] double getMeanError() const;
+
+    /**
+     * @brief Returns sample skewness \f$ g_1 = m_3 / m_2^{3/2} \f$ (biased estimator) or 0 if it is undefined.
+     */
+    [[nodiscard]] double getSkewness() const;
+
+    /**
+     * @brief Returns sample excess kurtosis \f$ g_2 = m_4 / m_2^2 - 3 \f$ (biased estimator) or 0 if it is undefined.
+     */
+    [[nodiscard]] double getExcessKurtosis() const;
+};
+
+
+#endif //MBL_ED_ACCUMULATOR_H
@@ -0,0 +1,43 @@
+//
+// Created by pkua on 17.10.2026.
+//
+
+#include "BLASThreadsLimit.h"
+
+// The functions are declared here, so that vendor headers are not needed
+#if defined(MBL_ED_OPENBLAS)
+    extern "C" void openblas_set_num_threads(int numThreads);
+    extern "C" int openblas_get_num_threads();
+#elif defined(MBL_ED_MKL)
+    extern "C" int MKL_Set_Num_Threads_Local(int numThreads);
+#endif
+
+BLASThreadsLimit::BLASThreadsLimit() {
+#if defined(MBL_ED_OPENBLAS)
+    this->previousNumThreads = openblas_get_num_threads();
+    openblas_set_num_threads(1);
+#endif
+}
+
+BLASThreadsLimit::~BLASThreadsLimit() {
+#if defined(MBL_ED_OPENBLAS)
+    openblas_set_num_threads(this->previousNumThreads);
+#endif
+}
+
+void BLASThreadsLimit::limitCurrentThread() {
+#if defined(MBL_ED_OPENBLAS)
+    // The limit is global - it was already set in the constructor, but setting it again does not hurt
+    openblas_set_num_threads(1);
+#elif defined(MBL_ED_MKL)
+    MKL_Set_Num_Threads_Local(1);
+#endif
+}
+
+bool BLASThreadsLimit::isSupported() {
+#if defined(MBL_ED_OPENBLAS) || defined(MBL_ED_MKL)
+    return true;
+#else
+    return false;
+#endif
+}
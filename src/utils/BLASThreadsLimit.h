@@ -0,0 +1,39 @@
+//
+// Created by pkua on 17.10.2026.
+//
+
+#ifndef MBL_ED_BLASTHREADSLIMIT_H
+#define MBL_ED_BLASTHREADSLIMIT_H
+
+/**
+ * @brief Limits BLAS (and LAPACK) routines called from worker threads to a single thread, for as long as the object
+ * exists.
+ * @details The object should be created before the worker threads are started and each worker should call
+ * limitCurrentThread(). The BLAS vendor is detected by CMake: for OpenBLAS the limit is global for the process (and
+ * the previous one is restored by the destructor), for MKL it is set locally for each worker thread. For other vendors
+ * nothing can be done (see isSupported()) - only OpenMP-based BLAS is limited then by limiting OpenMP threads.
+ */
+class BLASThreadsLimit {
+private:
+    [[maybe_unused]] int previousNumThreads{};
+
+public:
+    BLASThreadsLimit();
+    ~BLASThreadsLimit();
+
+    BLASThreadsLimit(const BLASThreadsLimit &) = delete;
+    BLASThreadsLimit &operator=(const BLASThreadsLimit &) = delete;
+
+    /**
+     * @brief Limits BLAS routines called from the current thread to a single thread.
+     */
+    static void limitCurrentThread();
+
+    /**
+     * @brief Returns true if the BLAS vendor was recognized and the number of its threads can be limited.
+     */
+    [[nodiscard]] static bool isSupported();
+};
+
+
+#endif //MBL_ED_BLASTHREADSLIMIT_H
@@ -93,6 +93,8 @@ public:
      */
     void setVerbosityLevel(LogType maxLogType_) { this->maxLogType = maxLogType_; }
 
+    [[nodiscard]] LogType getVerbosityLevel() const { return this->maxLogType; }
+
     operator std::ostream&() { return this->out; }
 
     Logger &info() { return this->changeLogType(INFO); }
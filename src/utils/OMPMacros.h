@@ -14,12 +14,14 @@
     #define _OMP_CRITICAL(x)    _Pragma(__OMP_STRINGIFY__(omp critical(x)))
     #define _OMP_MAXTHREADS     omp_get_max_threads()
     #define _OMP_THREAD_ID      omp_get_thread_num()
+    #define _OMP_SET_NUM_THREADS(x) omp_set_num_threads(x)
 #else
     #define _OMP_PARALLEL_FOR
     #define _OMP_ATOMIC
     #define _OMP_CRITICAL(x)
     #define _OMP_MAXTHREADS     1
     #define _OMP_THREAD_ID      0
+    #define _OMP_SET_NUM_THREADS(x)
 #endif
 
 #endif //MBL_ED_OMPMACROS_H
\ No newline at end of file
@@ -61,6 +61,18 @@ void Quantity::calculateFromSamples(const std::vector<double> &samples)
     }
 }
 
+void Quantity::calculateFromAccumulator(const Accumulator &accumulator) {
+    this->value = accumulator.getMean();
+    this->error = accumulator.getMeanError();
+}
+
+void Quantity::calculateFromCollector(const SampleCollector &collector) {
+    if (collector.isStreaming())
+        this->calculateFromAccumulator(collector.getAccumulator());
+    else
+        this->calculateFromSamples(collector.getSamples());
+}
+
 std::ostream &operator<<(std::ostream &stream, const Quantity &quantity)
 {
     if (!quantity.significantDigitsBasedOnError || quantity.error == 0) {
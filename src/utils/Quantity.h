@@ -9,6 +9,8 @@
 #include <iosfwd>
 
 #include "Assertions.h"
+#include "Accumulator.h"
+#include "SampleCollector.h"
 
 /**
  * @brief A simple class representing physical quantity with error.
@@ -59,6 +61,18 @@ public:
      */
     void calculateFromSamples(const std::vector<double> &samples);
 
+    /**
+     * @brief The same as calculateFromSamples(), but the samples were already gathered in @a accumulator.
+     * @param accumulator the Accumulator to calculate the quantity from
+     */
+    void calculateFromAccumulator(const Accumulator &accumulator);
+
+    /**
+     * @brief Calls calculateFromSamples() or calculateFromAccumulator(), depending on the mode of @a collector.
+     * @param collector the SampleCollector to calculate the quantity from
+     */
+    void calculateFromCollector(const SampleCollector &collector);
+
     /**
      * @brief Prints the quantity on given @a std::ostream The behaviour can be manipulated via Quantity::separator and
      * Quantity::significantDigitsBasedOnError fields.
@@ -0,0 +1,44 @@
+//
+// Created by pkua on 17.10.2026.
+//
+
+#include <numeric>
+
+#include "SampleCollector.h"
+#include "Assertions.h"
+
+void SampleCollector::add(double value) {
+    if (this->streaming)
+        this->accumulator.add(value);
+    else
+        this->samples.push_back(value);
+}
+
+void SampleCollector::clear() {
+    this->samples.clear();
+    this->accumulator.clear();
+}
+
+std::size_t SampleCollector::getCount() const {
+    if (this->streaming)
+        return this->accumulator.getCount();
+    else
+        return this->samples.size();
+}
+
+double SampleCollector::getMean() const {
+    if (this->streaming)
+        return this->accumulator.getMean();
+    else
+        return std::accumulate(this->samples.begin(), this->samples.end(), 0.) / this->samples.size();
+}
+
+const std::vector<double> &SampleCollector::getSamples() const {
+    Expects(!this->streaming);
+    return this->samples;
+}
+
+const Accumulator &SampleCollector::getAccumulator() const {
+    Expects(this->streaming);
+    return this->accumulator;
+}
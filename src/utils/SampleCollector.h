@@ -0,0 +1,58 @@
+//
+// Created by pkua on 17.10.2026.
+//
+
+#ifndef MBL_ED_SAMPLECOLLECTOR_H
+#define MBL_ED_SAMPLECOLLECTOR_H
+
+#include <vector>
+#include <cstddef>
+
+#include "Accumulator.h"
+
+/**
+ * @brief Collects samples of a single quantity either by keeping all of them or only in a streaming Accumulator.
+ * @details By default all samples are kept, as analyzer tasks always did. In the streaming mode only the Accumulator
+ * is updated, so the memory does not grow with the number of samples, but per-sample data is lost. Both modes are
+ * stored differently by RestorableHelper, so states from different modes cannot be joined.
+ */
+class SampleCollector {
+private:
+    bool streaming{};
+    std::vector<double> samples;
+    Accumulator accumulator;
+
+    friend class RestorableHelper;
+
+public:
+    SampleCollector() = default;
+
+    /**
+     * @brief Creates empty collector which, if @a streaming is true, keeps only the Accumulator of the samples.
+     */
+    explicit SampleCollector(bool streaming) : streaming{streaming} { }
+
+    void add(double value);
+    void clear();
+
+    [[nodiscard]] bool isStreaming() const { return this->streaming; }
+    [[nodiscard]] std::size_t getCount() const;
+
+    /**
+     * @brief Returns the mean of the samples.
+     */
+    [[nodiscard]] double getMean() const;
+
+    /**
+     * @brief Returns all samples; they are available only if the collector is not streaming.
+     */
+    [[nodiscard]] const std::vector<double> &getSamples() const;
+
+    /**
+     * @brief Returns the Accumulator of the samples; it is available only if the collector is streaming.
+     */
+    [[nodiscard]] const Accumulator &getAccumulator() const;
+};
+
+
+#endif //MBL_ED_SAMPLECOLLECTOR_H
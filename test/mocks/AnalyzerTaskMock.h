@@ -12,6 +12,7 @@
 class AnalyzerTaskMock : public trompeloeil::mock_interface<AnalyzerTask> {
 public:
     IMPLEMENT_MOCK2(analyze);
+    IMPLEMENT_CONST_MOCK1(getRequiredEigenvectors);
     IMPLEMENT_CONST_MOCK0(getName);
     IMPLEMENT_CONST_MOCK1(storeState);
     IMPLEMENT_MOCK1(joinRestoredState);
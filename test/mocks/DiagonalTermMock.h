@@ -10,7 +10,7 @@
 #include "core/DiagonalTerm.h"
 
 class DiagonalTermMock : public trompeloeil::mock_interface<DiagonalTerm> {
-    IMPLEMENT_MOCK2(calculate);
+    IMPLEMENT_CONST_MOCK2(calculate);
 };
 
 #endif //MBL_ED_DIAGONALTERMMOCK_H
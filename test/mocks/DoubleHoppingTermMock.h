@@ -10,7 +10,7 @@
 #include "core/DoubleHoppingTerm.h"
 
 class DoubleHoppingTermMock : public trompeloeil::mock_interface<DoubleHoppingTerm> {
-    IMPLEMENT_MOCK3(calculate);
+    IMPLEMENT_CONST_MOCK3(calculate);
 };
 
 #endif //MBL_ED_DOUBLEHOPPINGTERMMOCK_H
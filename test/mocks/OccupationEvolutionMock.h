@@ -14,6 +14,9 @@ public:
     MAKE_MOCK4(perform, std::vector<TimeEvolutionEntry>(const std::vector<EvolutionTimeSegment> &,
                                                            const arma::cx_vec &, Evolver &, Logger &),
                override);
+    MAKE_MOCK4(performBlock, std::vector<std::vector<TimeEvolutionEntry>>(const std::vector<EvolutionTimeSegment> &,
+                                                                          const arma::cx_mat &, Evolver &, Logger &),
+               override);
 };
 
 #endif //MBL_ED_OCCUPATIONEVOLUTIONMOCK_H
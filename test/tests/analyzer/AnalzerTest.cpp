@@ -41,6 +41,41 @@ TEST_CASE("Analzer: analyze") {
     analyzer.analyze(eigensystem, logger);
 }
 
+TEST_CASE("Analyzer: required eigenvectors") {
+    auto task1 = std::make_unique<AnalyzerTaskMock>();
+    auto task2 = std::make_unique<AnalyzerTaskMock>();
+    auto eigensystem = Eigensystem({1, 2, 3, 4, 5});
+    using Indices = std::optional<std::vector<std::size_t>>;
+
+    SECTION("union of tasks' indices") {
+        REQUIRE_CALL(*task1, getRequiredEigenvectors(eigensystem))
+                .RETURN(Indices(std::vector<std::size_t>{1, 2}));
+        REQUIRE_CALL(*task2, getRequiredEigenvectors(eigensystem))
+                .RETURN(Indices(std::vector<std::size_t>{2, 3}));
+        Analyzer analyzer;
+        analyzer.addTask(std::move(task1));
+        analyzer.addTask(std::move(task2));
+
+        auto indices = analyzer.getRequiredEigenvectors(eigensystem);
+
+        REQUIRE(indices == Indices(std::vector<std::size_t>{1, 2, 3}));
+    }
+
+    SECTION("one task requiring all") {
+        REQUIRE_CALL(*task1, getRequiredEigenvectors(eigensystem))
+                .RETURN(Indices(std::vector<std::size_t>{1, 2}));
+        REQUIRE_CALL(*task2, getRequiredEigenvectors(eigensystem))
+                .RETURN(std::nullopt);
+        Analyzer analyzer;
+        analyzer.addTask(std::move(task1));
+        analyzer.addTask(std::move(task2));
+
+        auto indices = analyzer.getRequiredEigenvectors(eigensystem);
+
+        REQUIRE_FALSE(indices.has_value());
+    }
+}
+
 TEST_CASE("Analzyer: print inline header") {
     auto task1 = std::make_unique<InlineAnalyzerTaskMock>();
     auto task2 = std::make_unique<InlineAnalyzerTaskMock>();
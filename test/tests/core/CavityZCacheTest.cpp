@@ -0,0 +1,37 @@
+//
+// Created by pkua on 17.10.2026.
+//
+
+#include <catch2/catch.hpp>
+
+#include "core/CavityZCache.h"
+#include "core/FockBasisGenerator.h"
+#include "core/HamiltonianGenerator.h"
+
+using Vector = FockBasis::Vector;
+
+TEST_CASE("CavityZCache") {
+    std::shared_ptr<const FockBasis> basis = FockBasisGenerator{}.generate(2, 2);
+    HamiltonianGenerator generator(basis, false);
+    CavityConstants::Realisation realisation1{0.4, {{1, 2, 3}, {4, 5, 6}}};
+    CavityConstants::Realisation realisation2{0.5, {{7, 8, 9}, {10, 11, 12}}};
+    CavityZCache zCache(generator);
+
+    SECTION("values") {
+        auto values = zCache.getValues(realisation2);
+
+        REQUIRE(values->size() == basis->size());
+        CHECK((*values)[basis->findIndex(Vector{1, 1}).value()] == Approx(19));
+        CHECK((*values)[basis->findIndex(Vector{0, 2}).value()] == Approx(22));
+        CHECK(zCache.isFor(*basis));
+    }
+
+    SECTION("values for the same realisation are shared") {
+        auto values1 = zCache.getValues(realisation1);
+        auto values2 = zCache.getValues(realisation2);
+
+        CHECK(zCache.getValues(realisation1) == values1);
+        CHECK(zCache.getValues(realisation2) == values2);
+        CHECK(values1 != values2);
+    }
+}
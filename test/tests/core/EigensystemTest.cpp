@@ -47,6 +47,70 @@ TEST_CASE("Eigensystem: eigenvalues and eigenvectors") {
     CHECK_THAT(eigensystem.getEigenstate(2), IsApproxEqual(arma::vec{-0.5, 0.5, M_SQRT1_2}, 1e-15));
 }
 
+TEST_CASE("Eigensystem: part of eigenvectors") {
+    arma::vec eigenenergies{0, 0.5, 1, 2};
+    arma::mat eigenstates{{ 3,      -1},
+                          { 0,       1},
+                          { 0, M_SQRT2},
+                          { 0,       0}};
+    Eigensystem eigensystem(eigenenergies, eigenstates, 1);
+
+    REQUIRE(eigensystem.size() == 4);
+    REQUIRE(eigensystem.hasEigenvectors());
+    CHECK_FALSE(eigensystem.hasAllEigenvectors());
+    CHECK(eigensystem.getFirstEigenvectorIndex() == 1);
+    CHECK(eigensystem.getNumberOfEigenvectors() == 2);
+    CHECK_FALSE(eigensystem.hasEigenvector(0));
+    CHECK(eigensystem.hasEigenvector(1));
+    CHECK(eigensystem.hasEigenvector(2));
+    CHECK_FALSE(eigensystem.hasEigenvector(3));
+    CHECK_THAT(eigensystem.getEigenenergies(), IsApproxEqual(eigenenergies, 1e-15));
+    CHECK_THAT(eigensystem.getEigenstate(1), IsApproxEqual(arma::vec{1, 0, 0, 0}, 1e-15));
+    CHECK_THAT(eigensystem.getEigenstate(2), IsApproxEqual(arma::vec{-0.5, 0.5, M_SQRT1_2, 0}, 1e-15));
+    CHECK_THROWS(eigensystem.getEigenstate(0));
+    CHECK_THROWS(eigensystem.getEigenstate(3));
+    CHECK_THROWS(eigensystem.getEigenstates());
+
+    std::stringstream energiesOut, statesOut;
+    CHECK_THROWS(eigensystem.store(energiesOut, statesOut));
+}
+
+TEST_CASE("Eigensystem: part of eigenvectors - incorrect") {
+    arma::mat eigenstates{{1, 0}, {0, 1}, {0, 0}};
+
+    CHECK_THROWS(Eigensystem({0, 1, 2}, eigenstates, 2));
+    CHECK_THROWS(Eigensystem({1, 0, 2}, eigenstates, 0));
+    CHECK_THROWS(Eigensystem({0, 1, 2}, arma::mat{{1, 0}, {0, 1}}, 0));
+}
+
+TEST_CASE("Eigensystem: window of the spectrum") {
+    arma::vec eigenenergies{1, 0};
+    arma::mat eigenstates{{0,  2},
+                          {1,  0},
+                          {0,  0},
+                          {0,  0}};
+    Eigensystem eigensystem(eigenenergies, eigenstates, std::make_pair(-2., 2.));
+
+    REQUIRE(eigensystem.size() == 2);
+    CHECK_FALSE(eigensystem.hasFullSpectrum());
+    CHECK(eigensystem.getSpectrumBounds() == std::make_pair(-2., 2.));
+    REQUIRE(eigensystem.hasAllEigenvectors());
+    CHECK_THAT(eigensystem.getEigenenergies(), IsApproxEqual(arma::vec{0, 1}, 1e-15));
+    CHECK_THAT(eigensystem.getEigenstate(0), IsApproxEqual(arma::vec{1, 0, 0, 0}, 1e-15));
+    CHECK_THAT(eigensystem.getEigenstate(1), IsApproxEqual(arma::vec{0, 1, 0, 0}, 1e-15));
+    CHECK_THAT(eigensystem.getNormalizedEigenenergies(), IsApproxEqual(arma::vec{0.5, 0.75}, 1e-15));
+
+    std::stringstream energiesOut, statesOut;
+    CHECK_THROWS(eigensystem.store(energiesOut));
+    CHECK_THROWS(eigensystem.store(energiesOut, statesOut));
+}
+
+TEST_CASE("Eigensystem: window of the spectrum - incorrect") {
+    CHECK_THROWS(Eigensystem({0, 1}, {{1, 0}, {0, 1}, {0, 0}}, std::make_pair(2., -2.)));
+    CHECK_THROWS(Eigensystem({0, 1}, {{1}, {0}, {0}}, std::make_pair(-2., 2.)));
+    CHECK_THROWS(Eigensystem({0, 1, 2}, {{1, 0, 0}, {0, 1, 0}}, std::make_pair(-2., 2.)));
+}
+
 TEST_CASE("Eigensystem: eigenvalues sorting") {
     arma::vec eigenenergies{0.5, 1, 0};
     arma::mat eigenstates{{         0, 1,      -0.5},
@@ -22,4 +22,19 @@ TEST_CASE("FockBaseGenerator: 3 bosons in 3 sites") {
     REQUIRE((*base)[7] == FockBasis::Vector{0, 2, 1});
     REQUIRE((*base)[8] == FockBasis::Vector{0, 1, 2});
     REQUIRE((*base)[9] == FockBasis::Vector{0, 0, 3});
-}
\ No newline at end of file
+}
+
+TEST_CASE("FockBaseGenerator: ranking and hash indexing schemes agree") {
+    FockBasisGenerator generator;
+
+    auto rankingBase = generator.generate(4, 5, FockBasis::IndexingScheme::RANKING);
+    auto hashBase = generator.generate(4, 5, FockBasis::IndexingScheme::HASH);
+
+    REQUIRE(rankingBase->getIndexingScheme() == FockBasis::IndexingScheme::RANKING);
+    REQUIRE(hashBase->getIndexingScheme() == FockBasis::IndexingScheme::HASH);
+    REQUIRE(rankingBase->size() == 70);
+    for (std::size_t i{}; i < rankingBase->size(); i++) {
+        CHECK(rankingBase->findIndex((*rankingBase)[i]) == i);
+        CHECK(hashBase->findIndex((*rankingBase)[i]) == i);
+    }
+}
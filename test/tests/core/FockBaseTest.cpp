@@ -92,4 +92,83 @@ TEST_CASE("FockBase: number of sites") {
 
         REQUIRE_THROWS(base.getNumberOfSites());
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("FockBase: ranking indexing scheme") {
+    SECTION("searching") {
+        FockBasis base(FockBasis::IndexingScheme::RANKING);
+        base.add(FockBasis::Vector{2, 0, 0});
+        base.add(FockBasis::Vector{1, 1, 0});
+        base.add(FockBasis::Vector{1, 0, 1});
+        base.add(FockBasis::Vector{0, 2, 0});
+        base.add(FockBasis::Vector{0, 1, 1});
+        base.add(FockBasis::Vector{0, 0, 2});
+
+        for (std::size_t i{}; i < base.size(); i++)
+            CHECK(base.findIndex(base[i]) == i);
+    }
+
+    SECTION("non-existing search") {
+        FockBasis base(FockBasis::IndexingScheme::RANKING);
+        base.add(FockBasis::Vector{2, 0, 0});
+        base.add(FockBasis::Vector{1, 1, 0});
+        base.add(FockBasis::Vector{1, 0, 1});
+
+        CHECK(base.findIndex(FockBasis::Vector{0, 2, 0}) == std::nullopt);   // not (yet) added
+        CHECK(base.findIndex(FockBasis::Vector{1, 1, 1}) == std::nullopt);
+        CHECK(base.findIndex(FockBasis::Vector{1, 0, 0}) == std::nullopt);
+        CHECK(base.findIndex(FockBasis::Vector{2, 0, 0, 0}) == std::nullopt);
+    }
+
+    SECTION("adding out of order should throw") {
+        FockBasis base(FockBasis::IndexingScheme::RANKING);
+        base.add(FockBasis::Vector{2, 0, 0});
+
+        REQUIRE_THROWS(base.add(FockBasis::Vector{1, 0, 1}));
+    }
+}
+
+TEST_CASE("FockBase: index after hop") {
+    auto indexingScheme = GENERATE(FockBasis::IndexingScheme::HASH, FockBasis::IndexingScheme::RANKING);
+    FockBasis base(indexingScheme);
+    base.add(FockBasis::Vector{2, 0, 0});
+    base.add(FockBasis::Vector{1, 1, 0});
+    base.add(FockBasis::Vector{1, 0, 1});
+    base.add(FockBasis::Vector{0, 2, 0});
+
+    CHECK(base.findIndexAfterHop(base[0], 0, 1) == 1);
+    CHECK(base.findIndexAfterHop(base[0], 0, 2) == 2);
+    CHECK(base.findIndexAfterHop(base[1], 0, 1) == 3);
+    CHECK(base.findIndexAfterHop(base[1], 1, 0) == 0);
+    CHECK(base.findIndexAfterHop(base[3], 1, 2) == std::nullopt);   // {0, 1, 1} not added
+    REQUIRE_THROWS(base.findIndexAfterHop(base[0], 1, 2));          // no particle to move
+}
+
+TEST_CASE("FockBase: compact storage") {
+    FockBasis base;
+    base.add(FockBasis::Vector{1, 2, 3});
+    base.add(FockBasis::Vector{255, 0, 7});
+
+    SECTION("views") {
+        FockBasis::VectorView view = base[1];
+
+        REQUIRE(view.size() == 3);
+        REQUIRE(view[0] == 255);
+        REQUIRE(view == FockBasis::Vector{255, 0, 7});
+        REQUIRE(FockBasis::Vector(view) == FockBasis::Vector{255, 0, 7});
+    }
+
+    SECTION("iteration") {
+        std::vector<FockBasis::Vector> vectors;
+        for (auto vector : base)
+            vectors.emplace_back(vector);
+
+        REQUIRE(vectors == std::vector<FockBasis::Vector>{{1, 2, 3}, {255, 0, 7}});
+        REQUIRE(base.end() - base.begin() == 2);
+    }
+
+    SECTION("occupations out of range") {
+        REQUIRE_THROWS(FockBasis::Vector{3, -1, 0});
+        REQUIRE_THROWS(FockBasis::Vector{256, 0, 0});
+    }
+}
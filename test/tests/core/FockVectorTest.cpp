@@ -48,4 +48,19 @@ TEST_CASE("FockVector: printing") {
     std::ostringstream out;
     out << empty << "|" << v;
     REQUIRE(out.str() == "|0.3.7.0");
-}
\ No newline at end of file
+}
+
+TEST_CASE("FockVector: view") {
+    FockVector v{0, 3, 7, 0};
+    FockVectorView view = v;
+
+    REQUIRE(view.size() == 4);
+    REQUIRE(view[2] == 7);
+    REQUIRE(view == FockVector{0, 3, 7, 0});
+    REQUIRE(view != FockVector{0, 3, 7, 1});
+    REQUIRE(view + FockVector{1, 2} == FockVector{0, 3, 7, 0, 1, 2});
+
+    std::ostringstream out;
+    out << view;
+    REQUIRE(out.str() == "0.3.7.0");
+}
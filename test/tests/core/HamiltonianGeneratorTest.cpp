@@ -9,10 +9,17 @@
 #include "mocks/DoubleHoppingTermMock.h"
 
 #include "matchers/ArmaApproxEqualCatchMatcher.h"
+#include "object_mothers/HamiltonianGeneratorMother.h"
 
 #include "core/FockBasisGenerator.h"
 #include "core/HamiltonianGenerator.h"
+#include "core/terms/HubbardHop.h"
+#include "core/terms/HubbardOnsite.h"
+#include "core/terms/QuasiperiodicDisorder.h"
+#include "core/terms/ListOnsite.h"
+#include "core/terms/LookupCavityY2.h"
 #include "utils/Assertions.h"
+#include "utils/OMPMacros.h"
 
 using namespace trompeloeil;
 
@@ -117,6 +124,105 @@ TEST_CASE("HamiltonianGenerator: diagonal") {
     REQUIRE_THAT(result, IsApproxEqual(expected, 1e-8));
 }
 
+TEST_CASE("HamiltonianGenerator: reused structure") {
+    SECTION("double hop 2 on 3") {
+        auto hopping = std::make_unique<DoubleHoppingTermMock>();
+        ALLOW_CALL(*hopping, calculate(_, _, _))
+                .WITH(_3.getSiteDistance(_1.fromSite, _1.toSite) == 1
+                      && _3.getSiteDistance(_2.fromSite, _2.toSite) == 1)
+                .RETURN(1);
+        FockBasisGenerator baseGenerator;
+        auto fockBase = baseGenerator.generate(2, 3);
+        HamiltonianGenerator hamiltonianGenerator(std::move(fockBase), false, true);
+        hamiltonianGenerator.addDoubleHoppingTerm(std::move(hopping));
+
+        arma::mat firstResult = arma::mat(hamiltonianGenerator.generate());
+        arma::mat secondResult = arma::mat(hamiltonianGenerator.generate());
+
+        arma::mat expected = {{      2, 0,   M_SQRT2,         2, 0,       0},
+                              {      0, 5,         0,         0, 3,       0},
+                              {M_SQRT2, 0,         2, 2*M_SQRT2, 0, M_SQRT2},
+                              {      2, 0, 2*M_SQRT2,         4, 0,       2},
+                              {      0, 3,         0,         0, 5,       0},
+                              {      0, 0,   M_SQRT2,         2, 0,       2}};
+        REQUIRE_THAT(firstResult, IsApproxEqual(expected, 1e-8));
+        REQUIRE_THAT(secondResult, IsApproxEqual(expected, 1e-8));
+    }
+
+    SECTION("terms changed between realisations") {
+        auto fockBase = std::shared_ptr<FockBasis>(FockBasisGenerator{}.generate(3, 5));
+        auto disorder = std::make_shared<QuasiperiodicDisorder>(2, 0.3, 0.5);
+        HamiltonianGenerator reusingGenerator(fockBase, true, true);
+        HamiltonianGenerator freshGenerator(fockBase, true);
+        for (auto generator : {&reusingGenerator, &freshGenerator}) {
+            generator->addHoppingTerm(std::make_unique<HubbardHop>(std::vector<std::size_t>{1, 2},
+                                                                   std::vector<double>{1, 0.5}));
+            generator->addDiagonalTerm(std::make_unique<HubbardOnsite>(3));
+            generator->addDiagonalTerm(disorder);
+        }
+        (void)reusingGenerator.generate();
+
+        disorder->setPhi0(1.5);
+
+        REQUIRE_THAT(arma::mat(reusingGenerator.generate()),
+                     IsApproxEqual(arma::mat(freshGenerator.generate()), 1e-12));
+    }
+
+    SECTION("squared hopping operator changed between realisations") {
+        auto fockBase = std::shared_ptr<FockBasis>(FockBasisGenerator{}.generate(3, 4));
+        CavityConstants cavityConstants;
+        cavityConstants.addRealisation(CavityConstants::Realisation{0.4, {{1, 2, 0.3}, {4, 5, -0.6}, {7, 8, 0.9},
+                                                                          {1, 1, 0.2}}});
+        cavityConstants.addRealisation(CavityConstants::Realisation{0.5, {{2, 1, -0.4}, {3, 5, 0.8}, {6, 7, 0.1},
+                                                                          {2, 2, -0.5}}});
+        auto cavityY2 = std::make_shared<LookupCavityY2>(1.5, cavityConstants);
+        HamiltonianGenerator reusingGenerator(fockBase, false, true);
+        HamiltonianGenerator freshGenerator(fockBase, false);
+        for (auto generator : {&reusingGenerator, &freshGenerator}) {
+            generator->addHoppingTerm(std::make_unique<HubbardHop>(1));
+            generator->addDoubleHoppingTerm(cavityY2);
+        }
+        REQUIRE_THAT(arma::mat(reusingGenerator.generate()),
+                     IsApproxEqual(arma::mat(freshGenerator.generate()), 1e-12));
+
+        cavityY2->changeRealisation(1);
+
+        REQUIRE_THAT(arma::mat(reusingGenerator.generate()),
+                     IsApproxEqual(arma::mat(freshGenerator.generate()), 1e-12));
+    }
+
+    SECTION("cache is invalidated by adding a term") {
+        auto fockBase = std::shared_ptr<FockBasis>(FockBasisGenerator{}.generate(2, 3));
+        HamiltonianGenerator reusingGenerator(fockBase, false, true);
+        HamiltonianGenerator freshGenerator(fockBase, false);
+        reusingGenerator.addDiagonalTerm(std::make_unique<HubbardOnsite>(1));
+        freshGenerator.addDiagonalTerm(std::make_unique<HubbardOnsite>(1));
+        (void)reusingGenerator.generate();
+
+        reusingGenerator.addHoppingTerm(std::make_unique<HubbardHop>(1));
+        freshGenerator.addHoppingTerm(std::make_unique<HubbardHop>(1));
+
+        REQUIRE_THAT(arma::mat(reusingGenerator.generate()),
+                     IsApproxEqual(arma::mat(freshGenerator.generate()), 1e-12));
+    }
+}
+
+#ifdef _OPENMP
+TEST_CASE("HamiltonianGenerator: result does not depend on the number of threads") {
+    auto hamiltonianGenerator = HamiltonianGeneratorMother(4, 6).hubbardQuasiperiodic(1, 2, 3, 0.3, 0.5);
+    int maxThreads = omp_get_max_threads();
+
+    omp_set_num_threads(1);
+    arma::sp_mat serialResult = hamiltonianGenerator->generate();
+    omp_set_num_threads(3);
+    arma::sp_mat parallelResult = hamiltonianGenerator->generate();
+    omp_set_num_threads(maxThreads);
+
+    REQUIRE(parallelResult.n_nonzero == serialResult.n_nonzero);
+    REQUIRE_THAT(arma::mat(parallelResult), IsApproxEqual(arma::mat(serialResult), 0));
+}
+#endif
+
 TEST_CASE("HamiltonianGenerator: diagonalization") {
     SECTION("diagonal") {
         // Simple {2, 1} on diagonal - it should only get the order {1, 2} right
@@ -158,6 +264,32 @@ TEST_CASE("HamiltonianGenerator: diagonalization") {
         REQUIRE_THAT(result.getEigenstates().col(1), IsApproxEqual(arma::vec{M_SQRT1_2, M_SQRT1_2}, 1e-8)
                                                      || IsApproxEqual(arma::vec{-M_SQRT1_2, -M_SQRT1_2}, 1e-8));
     }
+
+    SECTION("off-diagonal, part of eigenvectors") {
+        auto hopping = std::make_unique<HoppingTermMock>();
+        ALLOW_CALL(*hopping, getHoppingDistances())
+                .RETURN(std::vector<std::size_t>{1});
+        ALLOW_CALL(*hopping, calculate(_, _))
+                .WITH(HopBetween(_1) == HopBetween(0, 1))
+                .RETURN(1);
+        FockBasisGenerator baseGenerator;
+        auto fockBase = baseGenerator.generate(1, 2);
+        HamiltonianGenerator hamiltonianGenerator(std::move(fockBase), false);
+        hamiltonianGenerator.addHoppingTerm(std::move(hopping));
+
+        auto selectSecond = [](const Eigensystem &eigensystem) -> std::optional<std::vector<std::size_t>> {
+            REQUIRE_FALSE(eigensystem.hasEigenvectors());
+            REQUIRE_THAT(eigensystem.getEigenenergies(), IsApproxEqual(arma::vec{-1, 1}, 1e-8));
+            return std::vector<std::size_t>{1};
+        };
+
+        Eigensystem result = hamiltonianGenerator.calculatePartialEigensystem(selectSecond);
+
+        REQUIRE_THAT(result.getEigenenergies(), IsApproxEqual(arma::vec{-1, 1}, 1e-8));
+        REQUIRE_FALSE(result.hasEigenvector(0));
+        REQUIRE_THAT(result.getEigenstate(1), IsApproxEqual(arma::vec{M_SQRT1_2, M_SQRT1_2}, 1e-8)
+                                              || IsApproxEqual(arma::vec{-M_SQRT1_2, -M_SQRT1_2}, 1e-8));
+    }
 }
 
 TEST_CASE("HamiltonianGenerator: PBC") {
@@ -201,6 +333,32 @@ TEST_CASE("HamiltonianGenerator: PBC") {
     }
 }
 
+TEST_CASE("HamiltonianGenerator: visiting terms of given types") {
+    HamiltonianGenerator generator(FockBasisGenerator{}.generate(2, 3), false);
+    auto firstDisorder = std::make_shared<QuasiperiodicDisorder>(1, 0.3, 0);
+    auto onsite = std::make_shared<HubbardOnsite>(1);
+    auto secondDisorder = std::make_shared<QuasiperiodicDisorder>(2, 0.3, 0);
+    auto hop = std::make_shared<HubbardHop>(1);
+    generator.addDiagonalTerm(firstDisorder);
+    generator.addDiagonalTerm(onsite);
+    generator.addHoppingTerm(hop);
+    generator.addDiagonalTerm(secondDisorder);
+
+    SECTION("in the order of adding") {
+        std::vector<const void*> visited;
+        bool found = generator.visitTerms<QuasiperiodicDisorder, HubbardHop>([&visited](const auto &term) {
+            visited.push_back(&term);
+        });
+
+        REQUIRE(found);
+        REQUIRE(visited == std::vector<const void*>{firstDisorder.get(), hop.get(), secondDisorder.get()});
+    }
+
+    SECTION("no matching terms") {
+        REQUIRE_FALSE(generator.visitTerms<ListOnsite>([](const auto &) { }));
+    }
+}
+
 TEST_CASE("HamiltonianGenerator: site distance") {
     FockBasisGenerator baseGenerator;
     auto evenBase = baseGenerator.generate(1, 6);
@@ -0,0 +1,187 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#include <cmath>
+
+#include <catch2/catch.hpp>
+
+#include "matchers/ArmaApproxEqualCatchMatcher.h"
+
+#include "core/FockBasisGenerator.h"
+#include "core/HamiltonianGenerator.h"
+#include "core/SparseHamiltonianOperator.h"
+#include "core/MatrixFreeHamiltonianOperator.h"
+#include "core/terms/HubbardHop.h"
+#include "core/terms/HubbardOnsite.h"
+#include "core/terms/QuasiperiodicDisorder.h"
+#include "core/terms/LookupCavityY2.h"
+#include "core/terms/LookupCavityYZ.h"
+
+namespace {
+    std::unique_ptr<HamiltonianGenerator> hubbard_generator(std::size_t N, std::size_t K, bool usePBC) {
+        auto basis = std::shared_ptr<FockBasis>(FockBasisGenerator{}.generate(N, K));
+        auto generator = std::make_unique<HamiltonianGenerator>(basis, usePBC);
+        generator->addHoppingTerm(std::make_unique<HubbardHop>(std::vector<std::size_t>{1, 2},
+                                                               std::vector<double>{1, 0.3}));
+        generator->addDiagonalTerm(std::make_unique<HubbardOnsite>(2));
+        generator->addDiagonalTerm(std::make_unique<QuasiperiodicDisorder>(3, 0.3, 0.5));
+        return generator;
+    }
+
+    void add_cavity_y2_term(HamiltonianGenerator &generator) {
+        CavityConstants cavityConstants;
+        cavityConstants.addRealisation(CavityConstants::Realisation{0.4, {{1, 2, 0.3}, {4, 5, -0.6}, {7, 8, 0.9},
+                                                                          {1, 1, 0.2}, {2, 2, -0.7}, {3, 3, 0.5}}});
+        generator.addDoubleHoppingTerm(std::make_unique<LookupCavityY2>(1.5, cavityConstants));
+    }
+
+    arma::vec test_vector(std::size_t size) {
+        arma::vec vector(size);
+        for (std::size_t i{}; i < size; i++)
+            vector[i] = std::cos(0.7 * i) * (1 + 0.1 * i);
+        return vector;
+    }
+
+    arma::cx_vec to_complex(const arma::vec &real, const arma::vec &imag) {
+        arma::cx_vec vector(real.size());
+        for (std::size_t i{}; i < real.size(); i++)
+            vector[i] = {real[i], imag[i]};
+        return vector;
+    }
+}
+
+TEST_CASE("SparseHamiltonianOperator") {
+    arma::mat matrix = {{1, 2, 0},
+                        {2, 3, 4},
+                        {0, 4, 5}};
+    SparseHamiltonianOperator hamiltonian{arma::sp_mat(matrix)};
+    arma::vec vector = {1, -2, 3};
+
+    SECTION("size") {
+        REQUIRE(hamiltonian.size() == 3);
+    }
+
+    SECTION("real apply") {
+        arma::vec result;
+        hamiltonian.apply(vector, result);
+
+        REQUIRE_THAT(result, IsApproxEqual(arma::vec(matrix * vector), 1e-12));
+    }
+
+    SECTION("complex apply") {
+        arma::vec imagVector = {0, 1, -1};
+        arma::cx_vec result;
+        hamiltonian.apply(to_complex(vector, imagVector), result);
+
+        REQUIRE(arma::norm(result - to_complex(matrix * vector, matrix * imagVector)) < 1e-12);
+    }
+
+    SECTION("block apply") {
+        // More columns than processed at once by the kernel
+        arma::cx_mat block(3, 10);
+        for (std::size_t i{}; i < block.n_cols; i++)
+            block.col(i) = to_complex(vector * static_cast<double>(i), arma::vec{0, 1, -1} + static_cast<double>(i));
+        arma::cx_mat result;
+        hamiltonian.applyToBlock(block, result);
+
+        REQUIRE(arma::norm(result - matrix * block, "fro") < 1e-12);
+    }
+
+    SECTION("real block apply") {
+        arma::mat block(3, 10);
+        for (std::size_t i{}; i < block.n_cols; i++)
+            block.col(i) = vector * static_cast<double>(i) + arma::vec{0, 1, -1};
+        arma::mat result;
+        hamiltonian.applyToBlock(block, result);
+
+        REQUIRE(arma::norm(result - matrix * block, "fro") < 1e-12);
+    }
+}
+
+TEST_CASE("MatrixFreeHamiltonianOperator: the same as sparse matrix") {
+    bool usePBC = GENERATE(false, true);
+    bool withDoubleHops = GENERATE(false, true);
+    auto generator = hubbard_generator(3, 5, usePBC);
+    if (withDoubleHops && !usePBC)     // LookupCavityY2 does not support PBC
+        add_cavity_y2_term(*generator);
+    arma::sp_mat matrix = generator->generate();
+    MatrixFreeHamiltonianOperator hamiltonian(*generator);
+    arma::vec vector = test_vector(generator->getFockBasis()->size());
+
+    SECTION("real apply") {
+        arma::vec result;
+        hamiltonian.apply(vector, result);
+
+        REQUIRE_THAT(result, IsApproxEqual(arma::vec(matrix * vector), 1e-12));
+    }
+
+    SECTION("complex apply") {
+        arma::vec imagVector = -2 * vector;
+        imagVector[0] = 1;
+        arma::cx_vec result;
+        hamiltonian.apply(to_complex(vector, imagVector), result);
+
+        REQUIRE(arma::norm(result - to_complex(matrix * vector, matrix * imagVector)) < 1e-12);
+    }
+
+    SECTION("block apply") {
+        arma::cx_mat block(vector.size(), 3);
+        block.col(0) = to_complex(vector, -vector);
+        block.col(1) = to_complex(2 * vector, arma::vec(vector.size(), arma::fill::zeros));
+        block.col(2) = to_complex(arma::vec(vector.size(), arma::fill::ones), vector);
+        arma::cx_mat result;
+        hamiltonian.applyToBlock(block, result);
+
+        REQUIRE(arma::norm(result - arma::mat(matrix) * block, "fro") < 1e-12);
+    }
+
+    SECTION("real block apply") {
+        // Odd number of columns - the last one is not paired with any other
+        arma::mat block(vector.size(), 3);
+        block.col(0) = vector;
+        block.col(1) = -2 * vector;
+        block.col(2) = arma::vec(vector.size(), arma::fill::ones);
+        arma::mat result;
+        hamiltonian.applyToBlock(block, result);
+
+        REQUIRE(arma::norm(result - arma::mat(matrix) * block, "fro") < 1e-12);
+    }
+}
+
+TEST_CASE("MatrixFreeHamiltonianOperator: exception from a term reaches the caller") {
+    // LookupCavityYZ does not support PBC and throws when calculating the hops
+    auto generator = hubbard_generator(3, 5, true);
+    CavityConstants cavityConstants;
+    cavityConstants.addRealisation(CavityConstants::Realisation{0.4, {{1, 2, 3}, {4, 5, 6}, {7, 8, 9},
+                                                                      {1, 1, 1}, {2, 2, 2}}});
+    generator->addHoppingTerm(std::make_unique<LookupCavityYZ>(1, cavityConstants));
+    MatrixFreeHamiltonianOperator hamiltonian(*generator);
+    arma::vec vector = test_vector(generator->getFockBasis()->size());
+    arma::vec result;
+
+    REQUIRE_THROWS_AS(hamiltonian.apply(vector, result), std::runtime_error);
+}
+
+TEST_CASE("HamiltonianOperator: Lanczos spectrum bounds and ground state") {
+    auto generator = hubbard_generator(4, 6, false);
+    add_cavity_y2_term(*generator);
+    arma::vec expectedEnergies;
+    arma::mat expectedStates;
+    REQUIRE(arma::eig_sym(expectedEnergies, expectedStates, arma::mat(generator->generate())));
+    MatrixFreeHamiltonianOperator hamiltonian(*generator);
+
+    SECTION("spectrum bounds") {
+        auto [Emin, Emax] = hamiltonian.findSpectrumBounds();
+
+        REQUIRE(Emin == Approx(expectedEnergies.front()).epsilon(1e-10));
+        REQUIRE(Emax == Approx(expectedEnergies.back()).epsilon(1e-10));
+    }
+
+    SECTION("ground state") {
+        arma::vec groundState = hamiltonian.findGroundState();
+
+        REQUIRE(arma::norm(groundState) == Approx(1));
+        REQUIRE(std::abs(arma::dot(groundState, expectedStates.col(0))) == Approx(1).epsilon(1e-8));
+    }
+}
@@ -4,10 +4,27 @@
 
 #include <catch2/catch.hpp>
 
+#include "matchers/ArmaApproxEqualCatchMatcher.h"
+
 #include "core/FockBasisGenerator.h"
 #include "core/terms/LookupCavityY2.h"
 #include "core/HamiltonianGenerator.h"
 
+using Vector = FockBasis::Vector;
+
+namespace {
+    /**
+     * @brief LookupCavityY2 which does not declare itself as a square of hopping operator, so HamiltonianGenerator
+     * enumerates all pairs of hops for it.
+     */
+    class EnumeratedLookupCavityY2 : public LookupCavityY2 {
+    public:
+        using LookupCavityY2::LookupCavityY2;
+
+        [[nodiscard]] bool isSquareOfHoppingOperator() const override { return false; }
+    };
+}
+
 TEST_CASE("LookupCavityY2: correct") {
     HamiltonianGenerator generator(FockBasisGenerator{}.generate(2, 3), false);
     CavityConstants cavityConstants;
@@ -19,15 +36,18 @@ TEST_CASE("LookupCavityY2: correct") {
 
         // vector{0, 0, 2} => vector{0, 1, 1} => vector{1, 0, 1}
         // hop y constants = 6, 3, -U1/K = -1
-        REQUIRE(term.calculate({2, 1, {0, 0, 2}, {0, 1, 1}}, {1, 0, {0, 1, 1}, {1, 0, 1}}, generator) == -18);
+        REQUIRE(term.calculate({2, 1, Vector{0, 0, 2}, Vector{0, 1, 1}},
+                               {1, 0, Vector{0, 1, 1}, Vector{1, 0, 1}}, generator) == -18);
 
         // vector{0, 2, 0} => vector{1, 1, 0} => vector{2, 0, 0}
         // hop y constants = 3, 3, -U1/K = -1
-        REQUIRE(term.calculate({1, 0, {0, 2, 0}, {1, 1, 0}}, {1, 0, {1, 1, 0}, {2, 0, 0}}, generator) == -9);
+        REQUIRE(term.calculate({1, 0, Vector{0, 2, 0}, Vector{1, 1, 0}},
+                               {1, 0, Vector{1, 1, 0}, Vector{2, 0, 0}}, generator) == -9);
 
         // vector{2, 0, 0} => vector{1, 1, 0} => vector{2, 0, 0}
         // hop y constants = 3, 3, -U1/K = -1
-        REQUIRE(term.calculate({0, 1, {2, 0, 0}, {1, 1, 0}}, {1, 0, {1, 1, 0}, {2, 0, 0}}, generator) == -9);
+        REQUIRE(term.calculate({0, 1, Vector{2, 0, 0}, Vector{1, 1, 0}},
+                               {1, 0, Vector{1, 1, 0}, Vector{2, 0, 0}}, generator) == -9);
     }
 
     SECTION("explicit realisation in constructor = 1") {
@@ -35,7 +55,8 @@ TEST_CASE("LookupCavityY2: correct") {
 
         // vector{0, 0, 2} => vector{0, 1, 1} => vector{1, 0, 1}
         // hop y constants = 15, 12, -U1/K = -1
-        REQUIRE(term.calculate({2, 1, {0, 0, 2}, {0, 1, 1}}, {1, 0, {0, 1, 1}, {1, 0, 1}}, generator) == -180);
+        REQUIRE(term.calculate({2, 1, Vector{0, 0, 2}, Vector{0, 1, 1}},
+                               {1, 0, Vector{0, 1, 1}, Vector{1, 0, 1}}, generator) == -180);
     }
 
     SECTION("changing realisation to 1") {
@@ -43,7 +64,34 @@ TEST_CASE("LookupCavityY2: correct") {
 
         term.changeRealisation(1);
 
-        REQUIRE(term.calculate({2, 1, {0, 0, 2}, {0, 1, 1}}, {1, 0, {0, 1, 1}, {1, 0, 1}}, generator) == -180);
+        REQUIRE(term.calculate({2, 1, Vector{0, 0, 2}, Vector{0, 1, 1}},
+                               {1, 0, Vector{0, 1, 1}, Vector{1, 0, 1}}, generator) == -180);
+    }
+}
+
+TEST_CASE("LookupCavityY2: square of hopping operator") {
+    std::shared_ptr<const FockBasis> basis = FockBasisGenerator{}.generate(3, 4);
+    CavityConstants cavityConstants;
+    cavityConstants.addRealisation(CavityConstants::Realisation{0.4, {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}, {1, 3, 2}}});
+    HamiltonianGenerator squareGenerator(basis, false);
+    squareGenerator.addDoubleHoppingTerm(std::make_unique<LookupCavityY2>(3, cavityConstants));
+    HamiltonianGenerator enumeratedGenerator(basis, false);
+    enumeratedGenerator.addDoubleHoppingTerm(std::make_unique<EnumeratedLookupCavityY2>(3, cavityConstants));
+
+    SECTION("single hop factorization") {
+        const auto &term = *squareGenerator.getDoubleHoppingTerms().front();
+        Vector fromVector{0, 0, 2, 0}, middleVector{0, 1, 1, 0}, toVector{1, 0, 1, 0};
+        HopData firstHop{2, 1, fromVector, middleVector};
+        HopData secondHop{1, 0, middleVector, toVector};
+
+        REQUIRE(term.getSquareFactor(squareGenerator) * term.calculateSingleHop(firstHop, squareGenerator)
+                * term.calculateSingleHop(secondHop, squareGenerator)
+                == Approx(term.calculate(firstHop, secondHop, squareGenerator)));
+    }
+
+    SECTION("the same matrix as from enumerating hops") {
+        REQUIRE_THAT(arma::mat(squareGenerator.generate()),
+                     IsApproxEqual(arma::mat(enumeratedGenerator.generate()), 1e-10));
     }
 }
 
@@ -68,6 +116,7 @@ TEST_CASE("LookupCavityY2: errors") {
         smallCavityConstants.addRealisation(CavityConstants::Realisation{0.4, {{1, 2, 3}}});
         LookupCavityY2 term(2, smallCavityConstants, 0);
 
-        REQUIRE_THROWS(term.calculate({0, 1, {2, 0}, {1, 1}}, {0, 1, {1, 1}, {0, 2}}, generator));
+        REQUIRE_THROWS(term.calculate({0, 1, Vector{2, 0}, Vector{1, 1}},
+                                      {0, 1, Vector{1, 1}, Vector{0, 2}}, generator));
     }
 }
\ No newline at end of file
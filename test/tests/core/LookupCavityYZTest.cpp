@@ -10,6 +10,8 @@
 #include "core/terms/LookupCavityYZ.h"
 #include "core/HamiltonianGenerator.h"
 
+using Vector = FockBasis::Vector;
+
 TEST_CASE("LookupCavityYZ: correct") {
     HamiltonianGenerator generator(FockBasisGenerator{}.generate(2, 2), false);
     CavityConstants cavityConstants;
@@ -25,8 +27,8 @@ TEST_CASE("LookupCavityYZ: correct") {
         // hop y constant = 3, -U1/K = -1
         // -1 * 3 * (7 + 10) = -51
         // + vice versa
-        REQUIRE(term.calculate({0, 1, {1, 1}, {0, 2}}, generator) == -51);
-        REQUIRE(term.calculate({1, 0, {0, 2}, {1, 1}}, generator) == -51);
+        REQUIRE(term.calculate({0, 1, Vector{1, 1}, Vector{0, 2}}, generator) == -51);
+        REQUIRE(term.calculate({1, 0, Vector{0, 2}, Vector{1, 1}}, generator) == -51);
     }
 
     SECTION("explicit realisation in constructor = 1") {
@@ -37,8 +39,8 @@ TEST_CASE("LookupCavityYZ: correct") {
         // vector{0, 2} * wanniers{8, 11} = 22
         // hop y constant = 9, -U1/K = -1
         // + vice versa
-        REQUIRE(term.calculate({0, 1, {1, 1}, {0, 2}}, generator) == -9 * (19 + 22));
-        REQUIRE(term.calculate({1, 0, {0, 2}, {1, 1}}, generator) == -9 * (19 + 22));
+        REQUIRE(term.calculate({0, 1, Vector{1, 1}, Vector{0, 2}}, generator) == -9 * (19 + 22));
+        REQUIRE(term.calculate({1, 0, Vector{0, 2}, Vector{1, 1}}, generator) == -9 * (19 + 22));
     }
 
     SECTION("changing realisation to 1") {
@@ -46,7 +48,7 @@ TEST_CASE("LookupCavityYZ: correct") {
 
         term.changeRealisation(1);
 
-        REQUIRE(term.calculate({0, 1, {1, 1}, {0, 2}}, generator) == -9 * (19 + 22));
+        REQUIRE(term.calculate({0, 1, Vector{1, 1}, Vector{0, 2}}, generator) == -9 * (19 + 22));
     }
 }
 
@@ -65,6 +67,38 @@ TEST_CASE("LookupCavityYZ: integration with HamiltonianGenerator") {
     REQUIRE_THAT(result, IsApproxEqual(expected, 1e-8));
 }
 
+TEST_CASE("LookupCavityYZ: Z cache") {
+    std::shared_ptr<const FockBasis> basis = FockBasisGenerator{}.generate(2, 2);
+    HamiltonianGenerator generator(basis, false);
+    CavityConstants cavityConstants;
+    cavityConstants.addRealisation(CavityConstants::Realisation{0.4, {{1, 2, 3}, {4, 5, 6}}});
+    cavityConstants.addRealisation(CavityConstants::Realisation{0.5, {{7, 8, 9}, {10, 11, 12}}});
+    auto term = std::make_shared<LookupCavityYZ>(2, cavityConstants);
+    term->enableZCache(std::make_shared<CavityZCache>(generator));
+    generator.addHoppingTerm(term);
+
+    SECTION("the same as without cache") {
+        arma::mat expected = {{  0, -33,   0},
+                              {-33,   0, -51},
+                              {  0, -51,   0}};
+        expected *= M_SQRT2;
+        REQUIRE_THAT(arma::mat(generator.generate()), IsApproxEqual(expected, 1e-8));
+    }
+
+    SECTION("recomputed after changing realisation") {
+        term->changeRealisation(1);
+
+        // vector{1, 1} => vector{0, 2}, -9 * (19 + 22) from the test above
+        REQUIRE(arma::mat(generator.generate())(1, 2) == Approx(-9 * (19 + 22) * M_SQRT2));
+    }
+
+    SECTION("not used for a different basis") {
+        HamiltonianGenerator otherGenerator(FockBasisGenerator{}.generate(2, 2), false);
+
+        REQUIRE(term->calculate({0, 1, Vector{1, 1}, Vector{0, 2}, 1, 0, 2}, otherGenerator) == -51);
+    }
+}
+
 TEST_CASE("LookupCavityYZ: errors") {
     HamiltonianGenerator generator(FockBasisGenerator{}.generate(2, 2), false);
     CavityConstants cavityConstants;
@@ -86,6 +120,6 @@ TEST_CASE("LookupCavityYZ: errors") {
         smallCavityConstants.addRealisation(CavityConstants::Realisation{0.4, {{1, 2, 3}}});
         LookupCavityYZ term(2, smallCavityConstants, 0);
 
-        REQUIRE_THROWS(term.calculate({0, 1, {1, 1}, {0, 2}}, generator));
+        REQUIRE_THROWS(term.calculate({0, 1, Vector{1, 1}, Vector{0, 2}}, generator));
     }
 }
\ No newline at end of file
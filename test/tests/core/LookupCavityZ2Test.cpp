@@ -4,10 +4,14 @@
 
 #include <catch2/catch.hpp>
 
+#include "matchers/ArmaApproxEqualCatchMatcher.h"
+
 #include "core/FockBasisGenerator.h"
 #include "core/terms/LookupCavityZ2.h"
 #include "core/HamiltonianGenerator.h"
 
+using Vector = FockBasis::Vector;
+
 TEST_CASE("LookupCavityZ2: correct") {
     HamiltonianGenerator generator(FockBasisGenerator{}.generate(2, 2), false);
     CavityConstants cavityConstants;
@@ -18,14 +22,14 @@ TEST_CASE("LookupCavityZ2: correct") {
         LookupCavityZ2 term(2, cavityConstants);
 
         // (vector{1, 1} dot wanniers{2, 5}) ^ 2 * factor{-U1=2 / K=2 = -1} = -49
-        REQUIRE(term.calculate({1, 1}, generator) == -49);
+        REQUIRE(term.calculate(Vector{1, 1}, generator) == -49);
     }
 
     SECTION("explicitly given realisations index = 1") {
         LookupCavityZ2 term(2, cavityConstants, 1);
 
         // (vector{1, 1} dot wanniers{8, 11}) ^ 2 * factor{-U1=2 / K=2 = -1} = -361
-        REQUIRE(term.calculate({1, 1}, generator) == -361);
+        REQUIRE(term.calculate(Vector{1, 1}, generator) == -361);
     }
 
     SECTION("changing realisation index") {
@@ -34,10 +38,28 @@ TEST_CASE("LookupCavityZ2: correct") {
         term.changeRealisation(1);
 
         // (vector{1, 1} dot wanniers{8, 11}) ^ 2 * factor{-U1=2 / K=2 = -1} = -361
-        REQUIRE(term.calculate({1, 1}, generator) == -361);
+        REQUIRE(term.calculate(Vector{1, 1}, generator) == -361);
     }
 }
 
+TEST_CASE("LookupCavityZ2: Z cache") {
+    std::shared_ptr<const FockBasis> basis = FockBasisGenerator{}.generate(2, 2);
+    HamiltonianGenerator generator(basis, false);
+    CavityConstants cavityConstants;
+    cavityConstants.addRealisation(CavityConstants::Realisation{0.4, {{1, 2, 3}, {4, 5, 6}}});
+    cavityConstants.addRealisation(CavityConstants::Realisation{0.5, {{7, 8, 9}, {10, 11, 12}}});
+    auto term = std::make_shared<LookupCavityZ2>(2, cavityConstants);
+    term->enableZCache(std::make_shared<CavityZCache>(generator));
+    generator.addDiagonalTerm(term);
+    term->changeRealisation(1);
+
+    arma::vec expected(basis->size());
+    for (std::size_t i{}; i < basis->size(); i++)
+        expected[i] = term->calculate((*basis)[i], generator);
+    REQUIRE(generator.calculateDiagonal()[basis->findIndex(Vector{1, 1}).value()] == Approx(-361));
+    REQUIRE_THAT(generator.calculateDiagonal(), IsApproxEqual(expected, 1e-8));
+}
+
 TEST_CASE("LookupCavityZ2: errors") {
     HamiltonianGenerator generator(FockBasisGenerator{}.generate(2, 2), false);
     CavityConstants cavityConstants;
@@ -59,6 +81,6 @@ TEST_CASE("LookupCavityZ2: errors") {
         smallCavityConstants.addRealisation(CavityConstants::Realisation{0.4, {{1, 2, 3}}});
         LookupCavityZ2 term(2, smallCavityConstants, 0);
 
-        REQUIRE_THROWS(term.calculate({1, 1}, generator));
+        REQUIRE_THROWS(term.calculate(Vector{1, 1}, generator));
     }
 }
\ No newline at end of file
@@ -0,0 +1,59 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#include <catch2/catch.hpp>
+
+#include "matchers/ArmaApproxEqualCatchMatcher.h"
+
+#include "core/MatrixEntries.h"
+
+TEST_CASE("MatrixEntries: empty") {
+    MatrixEntries entries;
+
+    arma::sp_mat result = entries.toSparseMatrix(2, 3);
+
+    CHECK(entries.empty());
+    REQUIRE(result.n_rows == 2);
+    REQUIRE(result.n_cols == 3);
+    CHECK(result.n_nonzero == 0);
+}
+
+TEST_CASE("MatrixEntries: repeating entries are summed") {
+    MatrixEntries entries;
+    entries.add(0, 0, 1);
+    entries.add(1, 2, 2);
+    entries.add(0, 0, 3);
+    entries.add(2, 1, 4);
+    entries.add(1, 1, 5);
+    entries.add(1, 1, -5);
+
+    arma::mat result(entries.toSparseMatrix(3, 3));
+
+    CHECK(entries.size() == 6);
+    CHECK_THAT(result, IsApproxEqual(arma::mat{{4, 0, 0},
+                                               {0, 0, 2},
+                                               {0, 4, 0}}, 1e-15));
+}
+
+TEST_CASE("MatrixEntries: append") {
+    MatrixEntries entries1;
+    entries1.add(0, 1, 1);
+    MatrixEntries entries2;
+    entries2.add(1, 0, 2);
+    entries2.add(0, 1, 3);
+
+    entries1.append(entries2);
+    arma::mat result(entries1.toSparseMatrix(2, 2));
+
+    CHECK(entries1.size() == 3);
+    CHECK_THAT(result, IsApproxEqual(arma::mat{{0, 4},
+                                               {2, 0}}, 1e-15));
+}
+
+TEST_CASE("MatrixEntries: out of range entries throw") {
+    MatrixEntries entries;
+    entries.add(2, 0, 1);
+
+    CHECK_THROWS(entries.toSparseMatrix(2, 2));
+}
@@ -0,0 +1,78 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#include <cmath>
+#include <algorithm>
+
+#include <catch2/catch.hpp>
+
+#include "matchers/ArmaApproxEqualCatchMatcher.h"
+
+#include "core/PolynomialFilteredEigensolver.h"
+#include "core/SparseHamiltonianOperator.h"
+
+namespace {
+    // Quasiperiodic chain with additional long hops - sparse and without degenerate eigenvalues
+    arma::sp_mat chain_hamiltonian(std::size_t size) {
+        arma::sp_mat hamiltonian(size, size);
+        for (std::size_t i{}; i < size; i++) {
+            hamiltonian(i, i) = 3 * std::cos(2 * M_PI * 0.618034 * static_cast<double>(i));
+            if (i + 1 < size) {
+                hamiltonian(i, i + 1) = 1;
+                hamiltonian(i + 1, i) = 1;
+            }
+            if (i + 7 < size) {
+                hamiltonian(i, i + 7) = 0.5;
+                hamiltonian(i + 7, i) = 0.5;
+            }
+        }
+        return hamiltonian;
+    }
+}
+
+TEST_CASE("PolynomialFilteredEigensolver: eigenpairs around target energy") {
+    auto targetEpsilon = GENERATE(0.2, 0.5, 0.7);
+    arma::sp_mat matrix = chain_hamiltonian(300);
+    arma::vec expectedEnergies;
+    REQUIRE(arma::eig_sym(expectedEnergies, arma::mat(matrix)));
+    SparseHamiltonianOperator hamiltonian(matrix);
+    auto spectrumBounds = hamiltonian.findSpectrumBounds();
+    double target = spectrumBounds.first + targetEpsilon * (spectrumBounds.second - spectrumBounds.first);
+    PolynomialFilteredEigensolver eigensolver(hamiltonian, spectrumBounds);
+
+    auto [energies, eigenvectors] = eigensolver.calculateEigenpairs(target, 10);
+
+    REQUIRE(energies.size() == 10);
+    REQUIRE(eigenvectors.n_rows == 300);
+    REQUIRE(eigenvectors.n_cols == 10);
+    // The energies should be 10 subsequent ones closest to the target
+    auto firstIt = std::lower_bound(expectedEnergies.begin(), expectedEnergies.end(), energies.front() - 1e-8);
+    std::size_t firstIdx = firstIt - expectedEnergies.begin();
+    REQUIRE(firstIdx + 10 <= 300);
+    arma::vec expectedWindow = expectedEnergies.subvec(firstIdx, firstIdx + 9);
+    CHECK_THAT(energies, IsApproxEqual(expectedWindow, 1e-10));
+    double maxDistance = arma::abs(expectedWindow - target).max();
+    if (firstIdx > 0)
+        CHECK(std::abs(expectedEnergies[firstIdx - 1] - target) >= maxDistance);
+    if (firstIdx + 10 < 300)
+        CHECK(std::abs(expectedEnergies[firstIdx + 10] - target) >= maxDistance);
+    for (std::size_t i{}; i < 10; i++) {
+        arma::vec eigenvector = eigenvectors.col(i);
+        CHECK(arma::norm(eigenvector) == Approx(1));
+        CHECK(arma::norm(matrix * eigenvector - energies[i] * eigenvector) < 1e-8);
+    }
+}
+
+TEST_CASE("PolynomialFilteredEigensolver: incorrect parameters") {
+    arma::sp_mat matrix = chain_hamiltonian(20);
+    SparseHamiltonianOperator hamiltonian(matrix);
+
+    CHECK_THROWS(PolynomialFilteredEigensolver(hamiltonian, std::make_pair(1., -1.)));
+    CHECK_THROWS(PolynomialFilteredEigensolver(hamiltonian, std::make_pair(-1., 1.), 0));
+
+    PolynomialFilteredEigensolver eigensolver(hamiltonian, {-5, 5});
+    CHECK_THROWS(eigensolver.calculateEigenpairs(6, 2));
+    CHECK_THROWS(eigensolver.calculateEigenpairs(0, 0));
+    CHECK_THROWS(eigensolver.calculateEigenpairs(0, 17));
+}
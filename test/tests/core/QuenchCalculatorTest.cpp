@@ -7,19 +7,24 @@
 #include "matchers/ArmaApproxEqualCatchMatcher.h"
 
 #include "core/QuenchCalculator.h"
+#include "core/SparseHamiltonianOperator.h"
 
 TEST_CASE("QuenchCalculator: calculation") {
-    arma::sp_mat finalHamiltonian(2, 2);
-    finalHamiltonian(0, 0) = 1;
-    finalHamiltonian(1, 1) = 2;
+    arma::sp_mat finalMatrix(2, 2);
+    finalMatrix(0, 0) = 1;
+    finalMatrix(1, 1) = 2;
 
-    arma::sp_mat initialHamiltonian1(2, 2);  // ground state {1/sqrt(2), -1/sqrt(2)}
-    initialHamiltonian1(0, 0) = 1; initialHamiltonian1(0, 1) = 1;
-    initialHamiltonian1(1, 0) = 1; initialHamiltonian1(1, 1) = 1;
+    arma::sp_mat initialMatrix1(2, 2);  // ground state {1/sqrt(2), -1/sqrt(2)}
+    initialMatrix1(0, 0) = 1; initialMatrix1(0, 1) = 1;
+    initialMatrix1(1, 0) = 1; initialMatrix1(1, 1) = 1;
 
-    arma::sp_mat initialHamiltonian2(2, 2);  // ground state {-1-sqrt(2), 1} * normalization
-    initialHamiltonian2(0, 0) = -1; initialHamiltonian2(0, 1) = 1;
-    initialHamiltonian2(1, 0) =  1; initialHamiltonian2(1, 1) = 1;
+    arma::sp_mat initialMatrix2(2, 2);  // ground state {-1-sqrt(2), 1} * normalization
+    initialMatrix2(0, 0) = -1; initialMatrix2(0, 1) = 1;
+    initialMatrix2(1, 0) =  1; initialMatrix2(1, 1) = 1;
+
+    SparseHamiltonianOperator finalHamiltonian(finalMatrix);
+    SparseHamiltonianOperator initialHamiltonian1(initialMatrix1);
+    SparseHamiltonianOperator initialHamiltonian2(initialMatrix2);
 
     SECTION("single quench") {
         QuenchCalculator quenchCalculator;
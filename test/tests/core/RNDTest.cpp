@@ -0,0 +1,78 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "core/RND.h"
+
+namespace {
+    std::vector<double> draw(RND &rnd, std::size_t num) {
+        std::vector<double> result(num);
+        for (auto &value : result)
+            value = rnd.getDouble();
+        return result;
+    }
+}
+
+TEST_CASE("RND: Philox4x32-10 known answer") {
+    // Known answer for zero key and zero counter: 6627e8d5 e169c58d bc57ac4c 9b00dbd8
+    RND rnd(0);
+
+    CHECK(rnd.getDouble() == static_cast<double>(0x6627e8d5e169c58dull >> 11) * 0x1.0p-53);
+    CHECK(rnd.getDouble() == static_cast<double>(0xbc57ac4c9b00dbd8ull >> 11) * 0x1.0p-53);
+}
+
+TEST_CASE("RND: range") {
+    RND rnd(1234);
+
+    for (double value : draw(rnd, 10000)) {
+        REQUIRE(value >= 0);
+        REQUIRE(value < 1);
+    }
+}
+
+TEST_CASE("RND: simulation streams are independent of the order") {
+    RND rnd1(1234);
+    rnd1.setSimulationIndex(7);
+    auto expected = draw(rnd1, 5);
+
+    RND rnd2(1234);
+    draw(rnd2, 3);
+    rnd2.setSimulationIndex(3);
+    draw(rnd2, 10);
+    rnd2.setSimulationIndex(7);
+    auto actual = draw(rnd2, 5);
+
+    CHECK(actual == expected);
+}
+
+TEST_CASE("RND: seed rewinds the stream") {
+    RND rnd(1234);
+    auto expected = draw(rnd, 5);
+
+    rnd.setSimulationIndex(2);
+    draw(rnd, 2);
+    rnd.seed(1234);
+
+    CHECK(rnd.getSimulationIndex() == 0);
+    CHECK(draw(rnd, 5) == expected);
+}
+
+TEST_CASE("RND: different seeds, simulation indices and streams give different numbers") {
+    RND rnd(1234);
+    auto reference = draw(rnd, 5);
+
+    RND otherSeed(1235);
+    CHECK(draw(otherSeed, 5) != reference);
+
+    RND otherIndex(1234);
+    otherIndex.setSimulationIndex(1);
+    CHECK(draw(otherIndex, 5) != reference);
+
+    RND otherStream(1234, 1);
+    CHECK(otherStream.getStreamId() == 1);
+    CHECK(draw(otherStream, 5) != reference);
+}
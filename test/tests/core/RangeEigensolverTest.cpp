@@ -0,0 +1,52 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#include <cmath>
+
+#include <catch2/catch.hpp>
+
+#include "matchers/ArmaApproxEqualCatchMatcher.h"
+
+#include "core/RangeEigensolver.h"
+
+TEST_CASE("RangeEigensolver: agrees with eig_sym") {
+    // Symmetric matrix without degenerate eigenvalues
+    arma::mat matrix(20, 20);
+    for (std::size_t i{}; i < 20; i++)
+        for (std::size_t j{}; j < 20; j++)
+            matrix(i, j) = std::sin(1.0 + static_cast<double>(i * j)) + (i == j ? 0.1 * static_cast<double>(i) : 0);
+    arma::vec expectedEigenvalues;
+    arma::mat expectedEigenvectors;
+    REQUIRE(arma::eig_sym(expectedEigenvalues, expectedEigenvectors, matrix));
+
+    RangeEigensolver eigensolver(matrix);
+
+    REQUIRE(eigensolver.size() == 20);
+    REQUIRE_THAT(eigensolver.getEigenvalues(), IsApproxEqual(expectedEigenvalues, 1e-10));
+
+    SECTION("range of eigenvectors") {
+        arma::mat eigenvectors = eigensolver.calculateEigenvectors(5, 9);
+
+        REQUIRE(eigenvectors.n_rows == 20);
+        REQUIRE(eigenvectors.n_cols == 4);
+        for (std::size_t i{}; i < 4; i++) {
+            // Allow for +-eigenvectors
+            arma::vec expected = expectedEigenvectors.col(i + 5);
+            arma::vec actual = eigenvectors.col(i);
+            REQUIRE_THAT(actual, IsApproxEqual(expected, 1e-8) || IsApproxEqual(arma::vec(-expected), 1e-8));
+        }
+    }
+
+    SECTION("all eigenvectors") {
+        arma::mat eigenvectors = eigensolver.calculateEigenvectors(0, 20);
+
+        arma::mat expected = eigenvectors * arma::diagmat(expectedEigenvalues);
+        REQUIRE_THAT(arma::mat(matrix * eigenvectors), IsApproxEqual(expected, 1e-8));
+    }
+
+    SECTION("incorrect range") {
+        REQUIRE_THROWS(eigensolver.calculateEigenvectors(5, 5));
+        REQUIRE_THROWS(eigensolver.calculateEigenvectors(5, 21));
+    }
+}
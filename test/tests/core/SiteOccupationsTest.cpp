@@ -0,0 +1,100 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#include <catch2/catch.hpp>
+
+#include "matchers/ArmaApproxEqualCatchMatcher.h"
+
+#include "core/SiteOccupations.h"
+#include "core/FockBasisGenerator.h"
+#include "core/HamiltonianGenerator.h"
+#include "core/RND.h"
+#include "core/disorder_generators/UniformGenerator.h"
+#include "core/terms/HubbardOnsite.h"
+#include "core/terms/ListOnsite.h"
+#include "core/terms/OnsiteDisorder.h"
+#include "core/terms/QuasiperiodicDisorder.h"
+#include "core/terms/ConstantForce.h"
+#include "core/terms/CavityLongInteraction.h"
+#include "core/terms/LookupCavityZ2.h"
+
+namespace {
+    arma::vec diagonal_from_calculate(const DiagonalTerm &term, const HamiltonianGenerator &generator) {
+        const auto &basis = *generator.getFockBasis();
+        arma::vec diagonal(basis.size());
+        for (std::size_t i{}; i < basis.size(); i++)
+            diagonal[i] = term.calculate(basis[i], generator);
+        return diagonal;
+    }
+
+    arma::vec diagonal_from_occupations(const DiagonalTerm &term, const HamiltonianGenerator &generator) {
+        SiteOccupations occupations(*generator.getFockBasis());
+        arma::vec diagonal(occupations.size(), arma::fill::zeros);
+        term.addToDiagonal(occupations, generator, diagonal);
+        return diagonal;
+    }
+}
+
+TEST_CASE("SiteOccupations: layout and sums") {
+    FockBasis basis;
+    basis.add({2, 0, 1});
+    basis.add({0, 3, 0});
+    SiteOccupations occupations(basis);
+
+    REQUIRE(occupations.size() == 2);
+    REQUIRE(occupations.getNumberOfSites() == 3);
+    REQUIRE(occupations.getMaxOccupation() == 3);
+    REQUIRE(occupations.getSite(1)[0] == 0);
+    REQUIRE(occupations.getSite(1)[1] == 3);
+
+    SECTION("weighted sum") {
+        arma::vec sum = occupations.calculateWeightedSum({1, 2, 4});
+
+        REQUIRE_THAT(sum, IsApproxEqual(arma::vec{6, 6}, 1e-12));
+    }
+
+    SECTION("function sum") {
+        arma::vec sum = occupations.calculateFunctionSum({0, 1, 10, 100});
+
+        REQUIRE_THAT(sum, IsApproxEqual(arma::vec{11, 100}, 1e-12));
+    }
+
+    SECTION("errors") {
+        REQUIRE_THROWS(occupations.calculateWeightedSum({1, 2}));
+        REQUIRE_THROWS(occupations.calculateFunctionSum({0, 1, 2}));
+    }
+}
+
+TEST_CASE("SiteOccupations: addToDiagonal agrees with calculate") {
+    HamiltonianGenerator generator(FockBasisGenerator{}.generate(4, 5), false);
+    RND rnd(1234);
+    CavityConstants cavityConstants;
+    cavityConstants.addRealisation(CavityConstants::Realisation{0.4, {{1, 2, 3}, {4, 5, 6}, {-1, -2, -3}, {0, 1, 2},
+                                                                      {3, 4, 5}}});
+
+    std::vector<std::shared_ptr<DiagonalTerm>> terms{
+        std::make_shared<HubbardOnsite>(1.5),
+        std::make_shared<ListOnsite>(std::vector<double>{0.3, -0.2, 0.7, -0.1, 0.5}),
+        std::make_shared<OnsiteDisorder>(std::make_unique<UniformGenerator>(-1, 1), 5, rnd),
+        std::make_shared<QuasiperiodicDisorder>(2, 0.3, 0.1),
+        std::make_shared<ConstantForce>(0.7),
+        std::make_shared<CavityLongInteraction>(2, 0.3, 0.1),
+        std::make_shared<LookupCavityZ2>(2, cavityConstants)
+    };
+
+    for (const auto &term : terms)
+        REQUIRE_THAT(diagonal_from_occupations(*term, generator),
+                     IsApproxEqual(diagonal_from_calculate(*term, generator), 1e-12));
+}
+
+TEST_CASE("SiteOccupations: HamiltonianGenerator::calculateDiagonal") {
+    HamiltonianGenerator generator(FockBasisGenerator{}.generate(3, 4), false);
+    generator.addDiagonalTerm(std::make_shared<HubbardOnsite>(1.5));
+    generator.addDiagonalTerm(std::make_shared<ListOnsite>(std::vector<double>{0.3, -0.2, 0.7, -0.1}));
+
+    arma::vec expected = diagonal_from_calculate(*generator.getDiagonalTerms()[0], generator)
+                         + diagonal_from_calculate(*generator.getDiagonalTerms()[1], generator);
+    REQUIRE_THAT(generator.calculateDiagonal(), IsApproxEqual(expected, 1e-12));
+    REQUIRE_THAT(arma::vec(arma::mat(generator.generate()).diag()), IsApproxEqual(expected, 1e-12));
+}
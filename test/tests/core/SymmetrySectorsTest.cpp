@@ -0,0 +1,162 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#include <catch2/catch.hpp>
+
+#include "matchers/ArmaApproxEqualCatchMatcher.h"
+
+#include "core/SymmetrySectors.h"
+#include "core/FockBasisGenerator.h"
+#include "core/HamiltonianGenerator.h"
+#include "core/terms/HubbardHop.h"
+#include "core/terms/HubbardOnsite.h"
+#include "core/terms/QuasiperiodicDisorder.h"
+#include "core/terms/ListOnsite.h"
+
+namespace {
+    std::unique_ptr<HamiltonianGenerator> translation_invariant_generator(std::shared_ptr<FockBasis> basis) {
+        auto generator = std::make_unique<HamiltonianGenerator>(std::move(basis), true);
+        generator->addHoppingTerm(std::make_unique<HubbardHop>(std::vector<std::size_t>{1, 2},
+                                                               std::vector<double>{1, 0.4}));
+        generator->addDiagonalTerm(std::make_unique<HubbardOnsite>(1.5));
+        return generator;
+    }
+
+    std::unique_ptr<HamiltonianGenerator> reflection_symmetric_generator(std::shared_ptr<FockBasis> basis) {
+        auto generator = std::make_unique<HamiltonianGenerator>(std::move(basis), false);
+        generator->addHoppingTerm(std::make_unique<HubbardHop>(std::vector<std::size_t>{1, 2},
+                                                               std::vector<double>{1, 0.4}));
+        generator->addDiagonalTerm(std::make_unique<HubbardOnsite>(1.5));
+        generator->addDiagonalTerm(std::make_unique<ListOnsite>(std::vector<double>{0.3, -0.2, 0.7, -0.2, 0.3}));
+        return generator;
+    }
+}
+
+TEST_CASE("SymmetrySectors: translation") {
+    auto basis = std::shared_ptr<FockBasis>(FockBasisGenerator{}.generate(3, 6));
+    auto generator = translation_invariant_generator(basis);
+    arma::sp_mat hamiltonian = generator->generate();
+    auto sectors = SymmetrySectors::translation(basis);
+
+    SECTION("sectors") {
+        REQUIRE(sectors.getNumberOfSectors() == 6);
+        std::size_t totalSize{};
+        for (std::size_t m{}; m < sectors.getNumberOfSectors(); m++)
+            totalSize += sectors.getSectorSize(m);
+        REQUIRE(totalSize == basis->size());
+        // Sectors k and -k have equal sizes
+        REQUIRE(sectors.getSectorSize(1) == sectors.getSectorSize(5));
+        REQUIRE(sectors.getSectorSize(2) == sectors.getSectorSize(4));
+    }
+
+    SECTION("symmetry detection") {
+        REQUIRE(sectors.isSymmetric(hamiltonian));
+
+        generator->addDiagonalTerm(std::make_unique<QuasiperiodicDisorder>(1, 0.3, 0.5));
+        REQUIRE_FALSE(sectors.isSymmetric(generator->generate()));
+    }
+
+    SECTION("eigenenergies") {
+        arma::vec expectedEnergies;
+        REQUIRE(arma::eig_sym(expectedEnergies, arma::mat(hamiltonian)));
+
+        Eigensystem eigensystem = sectors.calculateEigensystem(hamiltonian, false);
+
+        REQUIRE_FALSE(eigensystem.hasEigenvectors());
+        REQUIRE_THAT(eigensystem.getEigenenergies(), IsApproxEqual(expectedEnergies, 1e-10));
+    }
+
+    SECTION("eigenvectors") {
+        arma::vec expectedEnergies;
+        REQUIRE(arma::eig_sym(expectedEnergies, arma::mat(hamiltonian)));
+
+        Eigensystem eigensystem = sectors.calculateEigensystem(hamiltonian, true);
+
+        REQUIRE_THAT(eigensystem.getEigenenergies(), IsApproxEqual(expectedEnergies, 1e-10));
+        REQUIRE(eigensystem.isOrthonormal());
+        arma::mat eigenstates = eigensystem.getEigenstates();
+        arma::mat residual = hamiltonian * eigenstates - eigenstates * arma::diagmat(eigensystem.getEigenenergies());
+        REQUIRE(arma::abs(residual).max() < 1e-10);
+    }
+}
+
+TEST_CASE("SymmetrySectors: HamiltonianGenerator uses momentum sectors for PBC") {
+    auto basis = std::shared_ptr<FockBasis>(FockBasisGenerator{}.generate(3, 5));
+    auto generator = translation_invariant_generator(basis);
+    generator->setSymmetrySectorsMode(HamiltonianGenerator::SymmetrySectorsMode::DETECT);
+    arma::vec expectedEnergies;
+    REQUIRE(arma::eig_sym(expectedEnergies, arma::mat(generator->generate())));
+
+    Eigensystem eigensystem = generator->calculateEigensystem(true);
+
+    REQUIRE_THAT(eigensystem.getEigenenergies(), IsApproxEqual(expectedEnergies, 1e-10));
+    REQUIRE(eigensystem.isOrthonormal());
+}
+
+TEST_CASE("SymmetrySectors: reflection") {
+    auto basis = std::shared_ptr<FockBasis>(FockBasisGenerator{}.generate(3, 5));
+    auto generator = reflection_symmetric_generator(basis);
+    arma::sp_mat hamiltonian = generator->generate();
+    auto sectors = SymmetrySectors::reflection(basis);
+
+    SECTION("sectors") {
+        REQUIRE(sectors.getNumberOfSectors() == 2);
+        REQUIRE(sectors.getSectorSize(0) + sectors.getSectorSize(1) == basis->size());
+        // Odd states vanish on reflection-symmetric vectors, so the even sector is larger
+        REQUIRE(sectors.getSectorSize(0) > sectors.getSectorSize(1));
+    }
+
+    SECTION("symmetry detection") {
+        REQUIRE(sectors.isSymmetric(hamiltonian));
+
+        generator->addDiagonalTerm(std::make_unique<ListOnsite>(std::vector<double>{1, 0, 0, 0, 0}));
+        REQUIRE_FALSE(sectors.isSymmetric(generator->generate()));
+    }
+
+    SECTION("eigensystem") {
+        arma::vec expectedEnergies;
+        REQUIRE(arma::eig_sym(expectedEnergies, arma::mat(hamiltonian)));
+
+        Eigensystem eigensystem = sectors.calculateEigensystem(hamiltonian, true);
+
+        REQUIRE_THAT(eigensystem.getEigenenergies(), IsApproxEqual(expectedEnergies, 1e-10));
+        REQUIRE(eigensystem.isOrthonormal());
+        arma::mat eigenstates = eigensystem.getEigenstates();
+        arma::mat residual = hamiltonian * eigenstates - eigenstates * arma::diagmat(eigensystem.getEigenenergies());
+        REQUIRE(arma::abs(residual).max() < 1e-10);
+    }
+}
+
+TEST_CASE("SymmetrySectors: HamiltonianGenerator symmetry sectors modes") {
+    auto basis = std::shared_ptr<FockBasis>(FockBasisGenerator{}.generate(3, 5));
+    auto generator = reflection_symmetric_generator(basis);
+    arma::vec expectedEnergies;
+    REQUIRE(arma::eig_sym(expectedEnergies, arma::mat(generator->generate())));
+
+    SECTION("detect") {
+        generator->setSymmetrySectorsMode(HamiltonianGenerator::SymmetrySectorsMode::DETECT);
+
+        Eigensystem eigensystem = generator->calculateEigensystem(true);
+
+        REQUIRE_THAT(eigensystem.getEigenenergies(), IsApproxEqual(expectedEnergies, 1e-10));
+        REQUIRE(eigensystem.isOrthonormal());
+    }
+
+    SECTION("declared") {
+        generator->setSymmetrySectorsMode(HamiltonianGenerator::SymmetrySectorsMode::DECLARED);
+
+        Eigensystem eigensystem = generator->calculateEigensystem(false);
+
+        REQUIRE_THAT(eigensystem.getEigenenergies(), IsApproxEqual(expectedEnergies, 1e-10));
+    }
+
+    SECTION("none is the default") {
+        REQUIRE(generator->getSymmetrySectorsMode() == HamiltonianGenerator::SymmetrySectorsMode::NONE);
+
+        Eigensystem eigensystem = generator->calculateEigensystem(true);
+
+        REQUIRE_THAT(eigensystem.getEigenenergies(), IsApproxEqual(expectedEnergies, 1e-10));
+        REQUIRE(eigensystem.isOrthonormal());
+    }
+}
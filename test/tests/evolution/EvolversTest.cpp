@@ -9,11 +9,14 @@
 
 #include "core/FockBasisGenerator.h"
 #include "core/HamiltonianGenerator.h"
+#include "core/SparseHamiltonianOperator.h"
+#include "core/MatrixFreeHamiltonianOperator.h"
 #include "core/terms/HubbardHop.h"
 #include "core/terms/HubbardOnsite.h"
 
 #include "evolution/EDEvolver.h"
 #include "evolution/ChebyshevEvolver.h"
+#include "evolution/KrylovEvolver.h"
 
 using namespace std::complex_literals;
 
@@ -24,6 +27,7 @@ TEST_CASE("Evolvers test") {
     hamiltonianGenerator.addHoppingTerm(std::make_unique<HubbardHop>(1));
     hamiltonianGenerator.addDiagonalTerm(std::make_unique<HubbardOnsite>(2));
     auto H = hamiltonianGenerator.generate();
+    SparseHamiltonianOperator hamiltonian(H);
     std::ostringstream loggerStream;
     Logger logger(loggerStream);
 
@@ -65,7 +69,7 @@ TEST_CASE("Evolvers test") {
     }
 
     SECTION("ChebyshevEvolver") {
-        ChebyshevEvolver chebyshevEvolver(H, logger);
+        ChebyshevEvolver chebyshevEvolver(hamiltonian, logger);
         chebyshevEvolver.prepareFor(psi0, 2, 1);
         chebyshevEvolver.evolve();
 
@@ -76,6 +80,14 @@ TEST_CASE("Evolvers test") {
             REQUIRE_THROWS(chebyshevEvolver.evolve());
         }
 
+        SECTION("order capped for large a*dt") {
+            ChebyshevEvolver longStepEvolver(hamiltonian, logger);
+            longStepEvolver.prepareFor(psi0, 1e5, 1);
+
+            REQUIRE_NOTHROW(longStepEvolver.evolve());
+            REQUIRE(loggerStream.str().find("capping the order") != std::string::npos);
+        }
+
         SECTION("second run - reset") {
             // Different evolution - different number of steps - but time after first step coincides with previous one
             // However not to use exactly the same, we take -psi0
@@ -86,6 +98,86 @@ TEST_CASE("Evolvers test") {
         }
     }
 
+    SECTION("ChebyshevEvolver - matrix-free") {
+        MatrixFreeHamiltonianOperator matrixFreeHamiltonian(hamiltonianGenerator);
+        ChebyshevEvolver chebyshevEvolver(matrixFreeHamiltonian, logger);
+        chebyshevEvolver.prepareFor(psi0, 2, 1);
+        chebyshevEvolver.evolve();
+
+        REQUIRE(arma::norm(chebyshevEvolver.getCurrentState() - expected) < 1e-10);
+    }
+
+    SECTION("ChebyshevEvolver - cached order") {
+        ChebyshevEvolver chebyshevEvolver1(hamiltonian, logger);
+        chebyshevEvolver1.prepareFor(psi0, 3, 1);
+        std::ostringstream cachedLoggerStream;
+        Logger cachedLogger(cachedLoggerStream);
+        ChebyshevEvolver chebyshevEvolver2(hamiltonian, cachedLogger);
+        chebyshevEvolver2.prepareFor(-psi0, 6, 2);
+        chebyshevEvolver1.evolve();
+        chebyshevEvolver2.evolve();
+
+        REQUIRE(cachedLoggerStream.str().find("(cached)") != std::string::npos);
+        REQUIRE(arma::norm(chebyshevEvolver1.getCurrentState() + chebyshevEvolver2.getCurrentState()) < 1e-12);
+    }
+
+    SECTION("ChebyshevEvolver - block") {
+        arma::cx_mat initialStates(basis->size(), 3, arma::fill::zeros);
+        initialStates(0, 0) = 1;
+        initialStates(0, 1) = -1i;
+        initialStates(3, 2) = 1;
+        ChebyshevEvolver singleEvolver(hamiltonian, logger);
+        singleEvolver.prepareFor(initialStates.col(2), 2, 1);
+        singleEvolver.evolve();
+
+        ChebyshevEvolver chebyshevEvolver(hamiltonian, logger);
+        REQUIRE(chebyshevEvolver.supportsBlockEvolution());
+        chebyshevEvolver.prepareForBlock(initialStates, 2, 1);
+        chebyshevEvolver.evolve();
+
+        const arma::cx_mat &states = chebyshevEvolver.getCurrentStates();
+        REQUIRE(states.n_cols == 3);
+        REQUIRE(arma::norm(states.col(0) - expected) < 1e-11);
+        REQUIRE(arma::norm(states.col(1) - (-1i * expected)) < 1e-11);
+        REQUIRE(arma::norm(states.col(2) - singleEvolver.getCurrentState()) < 1e-12);
+    }
+
+    SECTION("EDEvolver - block") {
+        arma::vec eigval;
+        arma::mat eigvec;
+        REQUIRE(arma::eig_sym(eigval, eigvec, arma::mat(H)));
+        Eigensystem eigensystem(eigval, eigvec);
+        EDEvolver edEvolver(eigensystem);
+        arma::cx_mat initialStates(basis->size(), 2, arma::fill::zeros);
+        initialStates(0, 0) = 1;
+        initialStates(0, 1) = -1;
+        edEvolver.prepareForBlock(initialStates, 2, 1);
+        edEvolver.evolve();
+
+        REQUIRE(arma::norm(edEvolver.getCurrentStates().col(0) - expected) < 1e-11);
+        REQUIRE(arma::norm(edEvolver.getCurrentStates().col(1) - (-expected)) < 1e-11);
+    }
+
+    SECTION("KrylovEvolver") {
+        KrylovEvolver krylovEvolver(hamiltonian, logger);
+        krylovEvolver.prepareFor(psi0, 2, 1);
+        krylovEvolver.evolve();
+
+        REQUIRE(arma::norm(krylovEvolver.getCurrentState() - expected) < 1e-11);
+
+        SECTION("throw on to many evolutions") {
+            krylovEvolver.evolve(); // 1 more step is permitted for convenience
+            REQUIRE_THROWS(krylovEvolver.evolve());
+        }
+
+        SECTION("second run - reset") {
+            krylovEvolver.prepareFor(-psi0, 4, 2);
+            krylovEvolver.evolve();
+
+            REQUIRE(arma::norm(krylovEvolver.getCurrentState() - (-expected)) < 1e-11);
+        }
+    }
+
     SECTION("ChebyshevEvolver - long times") {
         // We compare EDEvolver result ...
         arma::vec eigval;
@@ -96,7 +188,7 @@ TEST_CASE("Evolvers test") {
         edEvolver.prepareFor(psi0, 100, 1);
         edEvolver.evolve();
         // ... with our ChebyshevEvolver
-        ChebyshevEvolver chebyshevEvolver(H, logger);
+        ChebyshevEvolver chebyshevEvolver(hamiltonian, logger);
         chebyshevEvolver.prepareFor(psi0, 100, 100);
 
         for (std::size_t i{}; i < 100; i++)
@@ -104,4 +196,38 @@ TEST_CASE("Evolvers test") {
 
         REQUIRE(arma::norm(chebyshevEvolver.getCurrentState() - edEvolver.getCurrentState()) < 1e-8);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("KrylovEvolver: adaptive steps") {
+    FockBasisGenerator generator;
+    auto basis = std::shared_ptr<FockBasis>(generator.generate(4, 6));
+    HamiltonianGenerator hamiltonianGenerator(basis, true);
+    hamiltonianGenerator.addHoppingTerm(std::make_unique<HubbardHop>(1));
+    hamiltonianGenerator.addDiagonalTerm(std::make_unique<HubbardOnsite>(2));
+    auto H = hamiltonianGenerator.generate();
+    SparseHamiltonianOperator hamiltonian(H);
+    std::ostringstream loggerStream;
+    Logger logger(loggerStream);
+
+    arma::cx_vec psi0(basis->size(), arma::fill::zeros);
+    psi0[0] = 1;
+
+    arma::vec eigval;
+    arma::mat eigvec;
+    REQUIRE(arma::eig_sym(eigval, eigvec, arma::mat(H)));
+    Eigensystem eigensystem(eigval, eigvec);
+    EDEvolver edEvolver(eigensystem);
+    edEvolver.prepareFor(psi0, 30, 1);
+    edEvolver.evolve();
+
+    // Steps much longer than the inverse of spectrum width, and of different lengths in the segments
+    KrylovEvolver krylovEvolver(hamiltonian, logger);
+    krylovEvolver.prepareFor(psi0, 10, 2);
+    krylovEvolver.evolve();
+    krylovEvolver.evolve();
+    krylovEvolver.prepareFor(krylovEvolver.getCurrentState(), 20, 1);
+    krylovEvolver.evolve();
+
+    REQUIRE(basis->size() > 30);
+    REQUIRE(arma::norm(krylovEvolver.getCurrentState() - edEvolver.getCurrentState()) < 1e-9);
+}
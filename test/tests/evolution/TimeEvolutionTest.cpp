@@ -118,4 +118,43 @@ TEST_CASE("TimeEvolution: external vectors") {
         REQUIRE_THROWS(evolution.addEvolution(evolver, logger, {}));
         REQUIRE_THROWS(evolution.addEvolution(evolver, logger, {{1, 0}, {0, 1}}));
     }
-}
\ No newline at end of file
+}
+TEST_CASE("TimeEvolution: block evolution") {
+    auto fockBase = std::shared_ptr<FockBasis>(FockBasisGenerator{}.generate(1, 2));
+    Eigensystem eigensystem({1, 1}, arma::eye(2, 2), fockBase);
+    TimeEvolutionParameters params;
+    params.fockBasis = fockBase;
+    params.timeSegmentation = {{1, 1}};
+    params.numberOfSites = 2;
+    params.vectorsToEvolve = {FockBasis::Vector{1, 0}, TimeEvolutionParameters::ExternalVector{"external"}};
+    params.blockEvolution = true;
+    auto observable = std::make_shared<ObservableMock>();
+    ALLOW_CALL(*observable, getHeader()).RETURN(std::vector<std::string>{"o"});
+    params.storedObservables = {observable};
+
+    auto occupationEvolution = std::make_unique<OccupationEvolutionMock>();
+    REQUIRE_CALL(*occupationEvolution, performBlock(params.timeSegmentation, _, _, _))
+        .WITH(arma::approx_equal(_2, arma::cx_mat{{1, M_SQRT1_2}, {0, M_SQRT1_2}}, "absdiff", 1e-8))
+        .RETURN(std::vector<std::vector<TimeEvolutionEntry>>{
+            {{0, {1}}, {1, {2}}},
+            {{0, {3}}, {1, {4}}}
+        });
+    FORBID_CALL(*occupationEvolution, perform(_, _, _, _));
+
+    EDEvolver evolver(eigensystem);
+    TimeEvolution evolution(params, std::move(occupationEvolution));
+    std::ostringstream loggerStream;
+    Logger logger(loggerStream);
+
+    evolution.addEvolution(evolver, logger, {{M_SQRT1_2, M_SQRT1_2}});
+    std::stringstream out;
+    evolution.storeResult(out);
+
+    std::string line;
+    std::getline(out, line);
+    REQUIRE(line == "1.0_t o external_t o ");
+    std::getline(out, line);
+    REQUIRE(line == "0 1 0 3 ");
+    std::getline(out, line);
+    REQUIRE(line == "1 2 1 4 ");
+}
@@ -10,6 +10,7 @@
 #include "simulation/ChebyshevEvolution.h"
 
 #include "core/FockBasisGenerator.h"
+#include "core/SparseHamiltonianOperator.h"
 #include "core/terms/HubbardHop.h"
 #include "core/terms/HubbardOnsite.h"
 #include "core/terms/QuasiperiodicDisorder.h"
@@ -21,7 +22,7 @@ using namespace trompeloeil;
 
 namespace {
     class HamiltonianGeneratorMock {
-        MAKE_CONST_MOCK0(generate, arma::sp_mat());
+        MAKE_CONST_MOCK1(generateOperator, std::unique_ptr<HamiltonianOperator>(bool));
     };
 
     class AveragingModelMock {
@@ -33,8 +34,8 @@ namespace {
         arma::sp_mat hamiltonian;
         std::ostream &logger;
 
-        ChebyshevEvolverMock(arma::sp_mat hamiltonian, std::ostream &logger)
-                : hamiltonian{std::move(hamiltonian)}, logger{logger}
+        ChebyshevEvolverMock(const HamiltonianOperator &hamiltonian, std::ostream &logger)
+                : hamiltonian{dynamic_cast<const SparseHamiltonianOperator &>(hamiltonian).getMatrix()}, logger{logger}
         { }
     };
 
@@ -50,7 +51,7 @@ class CorrelationsTimeEvolutionMock : public trompeloeil::mock_interface<Restora
 
     class QuenchCalculatorMock : public trompeloeil::mock_interface<Restorable> {
     public:
-        MAKE_MOCK2(addQuench, void(const arma::sp_mat &, const arma::sp_mat &));
+        MAKE_MOCK2(addQuench, void(const HamiltonianOperator &, const HamiltonianOperator &));
         MAKE_MOCK0(getLastQuenchedState, const arma::vec &());
         MAKE_CONST_MOCK0(getLastQuenchEpsilon, double());
         MAKE_CONST_MOCK0(getLastQuenchEpsilonQuantumUncertainty, double());
@@ -66,6 +67,10 @@ class CorrelationsTimeEvolutionMock : public trompeloeil::mock_interface<Restora
         return arma::approx_equal(arma::mat(mat1), arma::mat(mat2), "absdiff", 1e-8);
     }
 
+    bool spMatApproxEqual(const HamiltonianOperator &hamiltonian, const arma::sp_mat &mat) {
+        return spMatApproxEqual(dynamic_cast<const SparseHamiltonianOperator &>(hamiltonian).getMatrix(), mat);
+    }
+
     bool cxVecApproxEqualVec(const arma::cx_vec &vec1, const arma::vec &vec2) {
         arma::cx_vec vec2Complex(vec2.size());
         std::copy(vec2.begin(), vec2.end(), vec2Complex.begin());
@@ -74,7 +79,7 @@ class CorrelationsTimeEvolutionMock : public trompeloeil::mock_interface<Restora
 
     using TestChebyshevEvolution = ChebyshevEvolution<HamiltonianGeneratorMock, AveragingModelMock,
                                                       CorrelationsTimeEvolutionMock, QuenchCalculatorMock,
-                                                      ChebyshevEvolverMock>;
+                                                      ChebyshevEvolverMock, ChebyshevEvolverMock>;
 }
 
 TEST_CASE("ChebyshevEvolution: evolutions") {
@@ -95,8 +100,8 @@ TEST_CASE("ChebyshevEvolution: evolutions") {
         REQUIRE_CALL(*averagingModel, setupHamiltonianGenerator(_, _, 2ul, 5ul))
                 .WITH(&_1 == hamiltonianGeneratorPtr && &_2 == rndPtr)
                 .IN_SEQUENCE(simulationSequence);
-        REQUIRE_CALL(*hamiltonianGenerator, generate())
-                .RETURN(hamiltonian2)
+        REQUIRE_CALL(*hamiltonianGenerator, generateOperator(false))
+                .RETURN(std::make_unique<SparseHamiltonianOperator>(hamiltonian2))
                 .IN_SEQUENCE(simulationSequence);
         REQUIRE_CALL(*correlationsTimeEvolution, addEvolution(_, _, _))
                 .WITH(spMatApproxEqual(_1.hamiltonian, hamiltonian2) && _3.empty())
@@ -140,14 +145,14 @@ TEST_CASE("ChebyshevEvolution: evolutions") {
         REQUIRE_CALL(*averagingModel, setupHamiltonianGenerator(_, _, 0ul, 1ul))
                 .WITH(&_1 == hamiltonianGeneratorPtr && &_2 == rndPtr)
                 .IN_SEQUENCE(simulationSequence);
-        REQUIRE_CALL(*hamiltonianGenerator, generate())
-                .RETURN(hamiltonian)
+        REQUIRE_CALL(*hamiltonianGenerator, generateOperator(false))
+                .RETURN(std::make_unique<SparseHamiltonianOperator>(hamiltonian))
                 .IN_SEQUENCE(simulationSequence);
         REQUIRE_CALL(*averagingModel, setupHamiltonianGenerator(_, _, 0ul, 1ul))
                 .WITH(&_1 == quenchHamiltonianGeneratorPtr && &_2 == quenchRndPtr)
                 .IN_SEQUENCE(simulationSequence);
-        REQUIRE_CALL(*quenchHamiltonianGenerator, generate())
-                .RETURN(quenchHamiltonian)
+        REQUIRE_CALL(*quenchHamiltonianGenerator, generateOperator(false))
+                .RETURN(std::make_unique<SparseHamiltonianOperator>(quenchHamiltonian))
                 .IN_SEQUENCE(simulationSequence);
         REQUIRE_CALL(*quenchCalculator, addQuench(_, _))
                 .WITH(spMatApproxEqual(_1, quenchHamiltonian))
@@ -18,6 +18,8 @@ namespace {
     class MockHamiltonianGenerator {
     public:
         MAKE_CONST_MOCK1(calculateEigensystem, Eigensystem(bool));
+        MAKE_CONST_MOCK1(calculatePartialEigensystem, Eigensystem(const HamiltonianGenerator::EigenvectorSelector &));
+        MAKE_CONST_MOCK2(calculateEigensystemAroundEnergy, Eigensystem(double, std::size_t));
         MAKE_CONST_MOCK0(getFockBase, std::shared_ptr<const FockBasis>());
     };
 
@@ -29,6 +31,7 @@ namespace {
     class MockAnalyzer : public trompeloeil::mock_interface<Restorable> {
     public:
         MAKE_CONST_MOCK2(analyze, void(const Eigensystem &, std::ostream &));
+        MAKE_CONST_MOCK1(getRequiredEigenvectors, std::optional<std::vector<std::size_t>>(const Eigensystem &));
         IMPLEMENT_CONST_MOCK1(storeState);
         IMPLEMENT_MOCK1(joinRestoredState);
         IMPLEMENT_MOCK0(clear);
@@ -52,9 +55,14 @@ TEST_CASE("ExactDiagonlization: 3 'random' hamiltonians") {
     REQUIRE_CALL(*averagingModel, setupHamiltonianGenerator(_, _, 1ul, 3ul))
         .WITH(&_1 == hamiltonianGeneratorPtr && &_2 == rndPtr)
         .IN_SEQUENCE(seq);
-    REQUIRE_CALL(*hamiltonianGenerator, calculateEigensystem(true))
+    // Eigenvectors are not stored, so only the ones required by the analyzer should be calculated
+    Eigensystem eigenvaluesOnly({-1, 1, 2});
+    REQUIRE_CALL(*hamiltonianGenerator, calculatePartialEigensystem(_))
+        .SIDE_EFFECT(REQUIRE(_1(eigenvaluesOnly) == std::vector<std::size_t>{1, 2}))
         .RETURN(eigensystem)
         .IN_SEQUENCE(seq);
+    REQUIRE_CALL(*analyzer, getRequiredEigenvectors(eigenvaluesOnly))
+        .RETURN(std::vector<std::size_t>{1, 2});
     REQUIRE_CALL(*analyzer, analyze(eigensystem, _))
         .IN_SEQUENCE(seq);
 
@@ -65,4 +73,138 @@ TEST_CASE("ExactDiagonlization: 3 'random' hamiltonians") {
     Logger dummyLogger(dummyLoggerStream);
 
     simulation.performSimulation(1, 3, dummyLogger);
-}
\ No newline at end of file
+}
+
+TEST_CASE("ExactDiagonlization: without eigenvectors") {
+    ExactDiagonalizationParameters params;
+    params.calculateEigenvectors = false;
+    params.storeLevel = ExactDiagonalizationParameters::StoreLevel::NONE;
+    params.fileSignature = "";
+    Eigensystem eigensystem({-1, 1, 2});
+
+    auto hamiltonianGenerator = std::make_unique<MockHamiltonianGenerator>();
+    auto averagingModel = std::make_unique<MockAveragingModel>();
+    auto analyzer = std::make_unique<MockAnalyzer>();
+    trompeloeil::sequence seq;
+    REQUIRE_CALL(*averagingModel, setupHamiltonianGenerator(_, _, 1ul, 3ul))
+        .IN_SEQUENCE(seq);
+    REQUIRE_CALL(*hamiltonianGenerator, calculateEigensystem(false))
+        .RETURN(eigensystem)
+        .IN_SEQUENCE(seq);
+    REQUIRE_CALL(*analyzer, analyze(eigensystem, _))
+        .IN_SEQUENCE(seq);
+
+    using TestSimulation = ExactDiagonalization<MockHamiltonianGenerator, MockAveragingModel, MockAnalyzer>;
+    TestSimulation simulation(std::move(hamiltonianGenerator), std::move(averagingModel), std::make_unique<RND>(),
+                              std::make_unique<FileOstreamProviderMock>(), params, std::move(analyzer));
+    std::ostringstream dummyLoggerStream;
+    Logger dummyLogger(dummyLoggerStream);
+
+    simulation.performSimulation(1, 3, dummyLogger);
+}
+
+TEST_CASE("ExactDiagonlization: polfed eigensolver") {
+    ExactDiagonalizationParameters params;
+    params.calculateEigenvectors = true;
+    params.storeLevel = ExactDiagonalizationParameters::StoreLevel::NONE;
+    params.fileSignature = "";
+    params.eigensolver = ExactDiagonalizationParameters::Eigensolver::POLFED;
+    params.polfedEpsilon = 0.4;
+    params.polfedEigenpairs = 2;
+    Eigensystem eigensystem({0, 1}, {{1, 0}, {0, 1}, {0, 0}}, std::make_pair(-1., 2.));
+
+    auto hamiltonianGenerator = std::make_unique<MockHamiltonianGenerator>();
+    auto averagingModel = std::make_unique<MockAveragingModel>();
+    auto analyzer = std::make_unique<MockAnalyzer>();
+    trompeloeil::sequence seq;
+    REQUIRE_CALL(*averagingModel, setupHamiltonianGenerator(_, _, 1ul, 3ul))
+        .IN_SEQUENCE(seq);
+    REQUIRE_CALL(*hamiltonianGenerator, calculateEigensystemAroundEnergy(0.4, 2ul))
+        .RETURN(eigensystem)
+        .IN_SEQUENCE(seq);
+    REQUIRE_CALL(*analyzer, analyze(eigensystem, _))
+        .IN_SEQUENCE(seq);
+
+    using TestSimulation = ExactDiagonalization<MockHamiltonianGenerator, MockAveragingModel, MockAnalyzer>;
+    TestSimulation simulation(std::move(hamiltonianGenerator), std::move(averagingModel), std::make_unique<RND>(),
+                              std::make_unique<FileOstreamProviderMock>(), params, std::move(analyzer));
+    std::ostringstream dummyLoggerStream;
+    Logger dummyLogger(dummyLoggerStream);
+
+    simulation.performSimulation(1, 3, dummyLogger);
+}
+
+TEST_CASE("ExactDiagonlization: pipelined") {
+    ExactDiagonalizationParameters params;
+    params.calculateEigenvectors = false;
+    params.storeLevel = ExactDiagonalizationParameters::StoreLevel::EIGENENERGIES;
+    params.fileSignature = "sig";
+    params.pipelined = true;
+    Eigensystem eigensystem0({-1, 1, 2});
+    Eigensystem eigensystem1({-2, 0, 3});
+
+    auto hamiltonianGenerator = std::make_unique<MockHamiltonianGenerator>();
+    auto hamiltonianGeneratorPtr = hamiltonianGenerator.get();
+    auto averagingModel = std::make_unique<MockAveragingModel>();
+    auto pipelineHamiltonianGenerator = std::make_unique<MockHamiltonianGenerator>();
+    auto pipelineHamiltonianGeneratorPtr = pipelineHamiltonianGenerator.get();
+    auto pipelineAveragingModel = std::make_unique<MockAveragingModel>();
+    auto analyzer = std::make_unique<MockAnalyzer>();
+    auto ostreamProvider = std::make_unique<FileOstreamProviderMock>();
+    // The generator from the constructor is set up for each realisation, since the analysis may use it, but only the
+    // first one is diagonalized on it. The second one is prepared in the background on the pipeline generator, and
+    // realisation 2 is not prepared at all, because it is beyond the span
+    REQUIRE_CALL(*averagingModel, setupHamiltonianGenerator(_, _, 0ul, 3ul))
+        .WITH(&_1 == hamiltonianGeneratorPtr);
+    REQUIRE_CALL(*averagingModel, setupHamiltonianGenerator(_, _, 1ul, 3ul))
+        .WITH(&_1 == hamiltonianGeneratorPtr);
+    REQUIRE_CALL(*pipelineAveragingModel, setupHamiltonianGenerator(_, _, 1ul, 3ul))
+        .WITH(&_1 == pipelineHamiltonianGeneratorPtr);
+    REQUIRE_CALL(*hamiltonianGenerator, calculateEigensystem(false))
+        .RETURN(eigensystem0);
+    REQUIRE_CALL(*pipelineHamiltonianGenerator, calculateEigensystem(false))
+        .RETURN(eigensystem1);
+    REQUIRE_CALL(*analyzer, analyze(eigensystem0, _));
+    REQUIRE_CALL(*analyzer, analyze(eigensystem1, _));
+    REQUIRE_CALL(*ostreamProvider, openOutputFile("sig_0_nrg.bin", _))
+        .RETURN(std::make_unique<std::ostringstream>());
+    REQUIRE_CALL(*ostreamProvider, openOutputFile("sig_1_nrg.bin", _))
+        .RETURN(std::make_unique<std::ostringstream>());
+
+    using TestSimulation = ExactDiagonalization<MockHamiltonianGenerator, MockAveragingModel, MockAnalyzer>;
+    TestSimulation simulation(std::move(hamiltonianGenerator), std::move(averagingModel), std::make_unique<RND>(),
+                              std::move(ostreamProvider), params, std::move(analyzer));
+    simulation.setPipelineResources(std::move(pipelineHamiltonianGenerator), std::move(pipelineAveragingModel),
+                                    std::make_unique<RND>());
+    std::ostringstream dummyLoggerStream;
+    Logger dummyLogger(dummyLoggerStream);
+
+    SimulationsSpan span;
+    span.from = 0;
+    span.to = 2;
+    span.total = 3;
+    simulation.prepareForSpan(span);
+    simulation.performSimulation(0, 3, dummyLogger);
+    simulation.performSimulation(1, 3, dummyLogger);
+}
+
+TEST_CASE("ExactDiagonlization: pipelined without pipeline resources throws") {
+    ExactDiagonalizationParameters params;
+    params.calculateEigenvectors = false;
+    params.storeLevel = ExactDiagonalizationParameters::StoreLevel::NONE;
+    params.pipelined = true;
+
+    auto averagingModel = std::make_unique<MockAveragingModel>();
+    auto hamiltonianGenerator = std::make_unique<MockHamiltonianGenerator>();
+    ALLOW_CALL(*averagingModel, setupHamiltonianGenerator(_, _, _, _));
+    ALLOW_CALL(*hamiltonianGenerator, calculateEigensystem(false))
+        .RETURN(Eigensystem({-1, 1, 2}));
+
+    using TestSimulation = ExactDiagonalization<MockHamiltonianGenerator, MockAveragingModel, MockAnalyzer>;
+    TestSimulation simulation(std::move(hamiltonianGenerator), std::move(averagingModel), std::make_unique<RND>(),
+                              std::make_unique<FileOstreamProviderMock>(), params, std::make_unique<MockAnalyzer>());
+    std::ostringstream dummyLoggerStream;
+    Logger dummyLogger(dummyLoggerStream);
+
+    REQUIRE_THROWS(simulation.performSimulation(0, 3, dummyLogger));
+}
@@ -6,11 +6,14 @@
 #include <vector>
 #include <ostream>
 #include <sstream>
+#include <fstream>
+#include <chrono>
 
 #include <catch2/catch.hpp>
 
 #include "simulation/RestorableSimulationExecutor.h"
 #include "simulation/RestorableHelper.h"
+#include "utils/SampleCollector.h"
 
 
 namespace {
@@ -59,6 +62,27 @@ namespace {
         void seedRandomGenerators(unsigned long seed_) override { this->seed = seed_; };
         [[nodiscard]] std::string getTagName() const override { return "simulation"; }
     };
+
+    class StreamingRestorableSimulation : public RestorableSimulation {
+    public:
+        SampleCollector values{true};
+
+        void storeState(std::ostream &binaryOut) const override {
+            RestorableHelper::storeStateForSampleCollector(this->values, binaryOut);
+        }
+
+        void joinRestoredState(std::istream &binaryIn) override {
+            RestorableHelper::joinRestoredStateForSampleCollector(this->values, binaryIn);
+        }
+
+        void performSimulation(std::size_t simulationIndex, std::size_t, Logger&) override {
+            this->values.add(1. / static_cast<double>(simulationIndex + 3));
+        }
+
+        void clear() override { this->values.clear(); }
+        void seedRandomGenerators(unsigned long) override { }
+        [[nodiscard]] std::string getTagName() const override { return "simulation"; }
+    };
 }
 
 TEST_CASE("RestorableSimulationExecutor") {
@@ -78,7 +102,7 @@ TEST_CASE("RestorableSimulationExecutor") {
 
         executor.performSimulations(restorableSimulation, 1234, logger);
 
-        CHECK(restorableSimulation.simulations == Simulations{{1, 4, 1235}, {2, 4, 1235}, {3, 4, 1235}});
+        CHECK(restorableSimulation.simulations == Simulations{{1, 4, 1234}, {2, 4, 1234}, {3, 4, 1234}});
         CHECK(executor.shouldSaveSimulation());
         CHECK_THAT(loggerStream.str(), Catch::Contains("No state file found"));
         CHECK(std::filesystem::is_empty(testDir));
@@ -99,12 +123,31 @@ TEST_CASE("RestorableSimulationExecutor") {
 
         executor.performSimulations(restorableSimulation2, 1234, logger);
 
-        CHECK(restorableSimulation2.simulations == Simulations{{0, 3, 1234}, {1, 3, 1234}, {2, 3, 1234 + 2}});
+        CHECK(restorableSimulation2.simulations == Simulations{{0, 3, 1234}, {1, 3, 1234}, {2, 3, 1234}});
         CHECK(executor.shouldSaveSimulation());
         CHECK_THAT(loggerStream.str(), Catch::Contains("State file found"));
         CHECK(std::filesystem::is_empty(testDir));
     }
 
+    SECTION("long interrupted simulation with compacted state file") {
+        MockRestorableSimulation restorableSimulation1(140);
+        RestorableSimulationExecutor executor({0, 150, 150}, "N.8_K.8_from.0_to.150_term.value", false, true, testDir);
+
+        CHECK_THROWS_WITH(executor.performSimulations(restorableSimulation1, 1234, logger), "interruption");
+
+        REQUIRE(restorableSimulation1.simulations.size() == 140);
+
+
+        MockRestorableSimulation restorableSimulation2;
+        executor.performSimulations(restorableSimulation2, 1234, logger);
+
+        Simulations expected;
+        for (std::size_t i{}; i < 150; i++)
+            expected.push_back({i, 150, 1234});
+        CHECK(restorableSimulation2.simulations == expected);
+        CHECK(std::filesystem::is_empty(testDir));
+    }
+
     SECTION("split simulation") {
         SECTION("first part [2] - not finished yet") {
             MockRestorableSimulation restorableSimulation1;
@@ -113,7 +156,7 @@ TEST_CASE("RestorableSimulationExecutor") {
 
             executor1.performSimulations(restorableSimulation1, 1234, logger);
 
-            CHECK(restorableSimulation1.simulations == Simulations{{2, 3, 1234 + 2}});
+            CHECK(restorableSimulation1.simulations == Simulations{{2, 3, 1234}});
             CHECK_FALSE(executor1.shouldSaveSimulation());
             CHECK_THAT(loggerStream.str(), Catch::Contains("Some state files are missing"));
 
@@ -124,7 +167,7 @@ TEST_CASE("RestorableSimulationExecutor") {
 
                 executor2.performSimulations(restorableSimulation2, 1234, logger);
 
-                CHECK(restorableSimulation2.simulations == Simulations{{0, 3, 1234}, {1, 3, 1234}, {2, 3, 1234 + 2}});
+                CHECK(restorableSimulation2.simulations == Simulations{{0, 3, 1234}, {1, 3, 1234}, {2, 3, 1234}});
                 CHECK(executor2.shouldSaveSimulation());
                 CHECK_THAT(loggerStream.str(), Catch::Contains("No state files are missing"));
                 CHECK_THAT(loggerStream.str(), Catch::Contains("All simulations are finished"));
@@ -161,7 +204,7 @@ TEST_CASE("RestorableSimulationExecutor") {
 
                 executor3.performSimulations(restorableSimulation3, 1234, logger);
 
-                CHECK(restorableSimulation3.simulations == Simulations{{0, 3, 1234}, {1, 3, 1234 + 1}, {2, 3, 1234+2}});
+                CHECK(restorableSimulation3.simulations == Simulations{{0, 3, 1234}, {1, 3, 1234}, {2, 3, 1234}});
                 CHECK(executor3.shouldSaveSimulation());
                 CHECK_THAT(loggerStream.str(), Catch::Contains("No state files are missing"));
                 CHECK_THAT(loggerStream.str(), Catch::Contains("All simulations are finished"));
@@ -193,6 +236,146 @@ TEST_CASE("RestorableSimulationExecutor") {
         }
     }
 
+    SECTION("parallel workers") {
+        // Parallel results are exactly the same as serial ones only with secureSimulationState = true, which is
+        // passed to all executors below
+        auto createWorker = []() { return std::make_unique<MockRestorableSimulation>(); };
+
+        SECTION("normal simulation [1, 4] out of 5") {
+            MockRestorableSimulation restorableSimulation;
+            RestorableSimulationExecutor executor({1, 5, 5}, "N.8_K.8_from.1_to.5_term.value", false, true, testDir);
+            executor.setParallelWorkers(3, createWorker);
+
+            executor.performSimulations(restorableSimulation, 1234, logger);
+
+            // Simulations joined in order
+            CHECK(restorableSimulation.simulations
+                  == Simulations{{1, 5, 1234}, {2, 5, 1234}, {3, 5, 1234}, {4, 5, 1234}});
+            CHECK(executor.shouldSaveSimulation());
+            CHECK(std::filesystem::is_empty(testDir));
+        }
+
+        SECTION("interrupted simulation [0, 1] + [2, 3] out of 4") {
+            MockRestorableSimulation restorableSimulation1;
+            RestorableSimulationExecutor executor({0, 4, 4}, "N.8_K.8_from.0_to.4_term.value", false, true, testDir);
+            executor.setParallelWorkers(2, []() { return std::make_unique<MockRestorableSimulation>(2); });
+
+            CHECK_THROWS_WITH(executor.performSimulations(restorableSimulation1, 1234, logger), "interruption");
+
+            CHECK(restorableSimulation1.simulations == Simulations{{0, 4, 1234}, {1, 4, 1234}});
+            CHECK_FALSE(executor.shouldSaveSimulation());
+
+
+            MockRestorableSimulation restorableSimulation2;
+            executor.setParallelWorkers(2, createWorker);
+            loggerStream.clear();
+
+            executor.performSimulations(restorableSimulation2, 1234, logger);
+
+            // The same as if there was no interruption
+            CHECK(restorableSimulation2.simulations
+                  == Simulations{{0, 4, 1234}, {1, 4, 1234}, {2, 4, 1234}, {3, 4, 1234}});
+            CHECK(executor.shouldSaveSimulation());
+            CHECK_THAT(loggerStream.str(), Catch::Contains("State file found"));
+            CHECK(std::filesystem::is_empty(testDir));
+        }
+
+        SECTION("streamed statistics with secureSimulationState = false agree with serial up to rounding") {
+            StreamingRestorableSimulation serialSimulation;
+            RestorableSimulationExecutor serialExecutor({0, 7, 7}, "N.8_K.8_from.0_to.7_term.value", false, false,
+                                                        testDir);
+            serialExecutor.performSimulations(serialSimulation, 1234, logger);
+
+            StreamingRestorableSimulation parallelSimulation;
+            RestorableSimulationExecutor parallelExecutor({0, 7, 7}, "N.8_K.8_from.0_to.7_term.value", false, false,
+                                                          testDir);
+            parallelExecutor.setParallelWorkers(3, []() { return std::make_unique<StreamingRestorableSimulation>(); });
+            parallelExecutor.performSimulations(parallelSimulation, 1234, logger);
+
+            const Accumulator &serial = serialSimulation.values.getAccumulator();
+            const Accumulator &parallel = parallelSimulation.values.getAccumulator();
+            CHECK(parallel.getCount() == serial.getCount());
+            CHECK(parallel.getMean() == Approx(serial.getMean()));
+            CHECK(parallel.getVariance() == Approx(serial.getVariance()));
+        }
+    }
+
+    SECTION("dynamic scheduling") {
+        SECTION("single process performs all chunks") {
+            MockRestorableSimulation restorableSimulation;
+            RestorableSimulationExecutor executor({0, 5, 5}, "N.8_K.8_from.0_to.5_term.value", true, true, testDir);
+            executor.setDynamicScheduling(2, std::chrono::seconds(3600));
+
+            executor.performSimulations(restorableSimulation, 1234, logger);
+
+            CHECK(restorableSimulation.simulations
+                  == Simulations{{0, 5, 1234}, {1, 5, 1234}, {2, 5, 1234}, {3, 5, 1234}, {4, 5, 1234}});
+            CHECK(executor.shouldSaveSimulation());
+            CHECK_THAT(loggerStream.str(), Catch::Contains("All simulations are finished"));
+            CHECK(std::filesystem::is_empty(testDir));
+        }
+
+        SECTION("chunk claimed by other process is skipped and stolen after the claim expires") {
+            std::string claimFilename = "N.8_K.8_from.2_to.4_term.value_state_simulation.bin.claim.0";
+            std::ofstream claimFile(testDir / claimFilename);
+            claimFile.close();
+
+            MockRestorableSimulation restorableSimulation1;
+            RestorableSimulationExecutor executor1({0, 5, 5}, "N.8_K.8_from.0_to.5_term.value", true, true, testDir);
+            executor1.setDynamicScheduling(2, std::chrono::seconds(3600));
+
+            executor1.performSimulations(restorableSimulation1, 1234, logger);
+
+            CHECK(restorableSimulation1.simulations.empty());
+            CHECK_FALSE(executor1.shouldSaveSimulation());
+            CHECK_THAT(loggerStream.str(), Catch::Contains("Some state files are missing"));
+
+
+            auto expiredTime = std::filesystem::file_time_type::clock::now() - std::chrono::hours(2);
+            std::filesystem::last_write_time(testDir / claimFilename, expiredTime);
+            MockRestorableSimulation restorableSimulation2;
+            RestorableSimulationExecutor executor2({0, 5, 5}, "N.8_K.8_from.0_to.5_term.value", true, true, testDir);
+            executor2.setDynamicScheduling(2, std::chrono::seconds(3600));
+            loggerStream.clear();
+
+            executor2.performSimulations(restorableSimulation2, 1234, logger);
+
+            CHECK(restorableSimulation2.simulations
+                  == Simulations{{0, 5, 1234}, {1, 5, 1234}, {2, 5, 1234}, {3, 5, 1234}, {4, 5, 1234}});
+            CHECK(executor2.shouldSaveSimulation());
+            CHECK_THAT(loggerStream.str(), Catch::Contains("stealing the chunk"));
+            CHECK(std::filesystem::is_empty(testDir));
+        }
+
+        SECTION("interrupted chunk is continued by other process") {
+            MockRestorableSimulation restorableSimulation1(3);
+            RestorableSimulationExecutor executor1({0, 5, 5}, "N.8_K.8_from.0_to.5_term.value", true, true, testDir);
+            executor1.setDynamicScheduling(2, std::chrono::seconds(1));
+
+            CHECK_THROWS_WITH(executor1.performSimulations(restorableSimulation1, 1234, logger), "interruption");
+
+            CHECK(restorableSimulation1.simulations == Simulations{{2, 5, 1234}});
+
+
+            auto expiredTime = std::filesystem::file_time_type::clock::now() - std::chrono::hours(2);
+            std::filesystem::last_write_time(
+                testDir / "N.8_K.8_from.2_to.4_term.value_state_simulation.bin.claim.0", expiredTime
+            );
+            MockRestorableSimulation restorableSimulation2;
+            RestorableSimulationExecutor executor2({0, 5, 5}, "N.8_K.8_from.0_to.5_term.value", true, true, testDir);
+            executor2.setDynamicScheduling(2, std::chrono::seconds(1));
+            loggerStream.clear();
+
+            executor2.performSimulations(restorableSimulation2, 1234, logger);
+
+            CHECK(restorableSimulation2.simulations
+                  == Simulations{{0, 5, 1234}, {1, 5, 1234}, {2, 5, 1234}, {3, 5, 1234}, {4, 5, 1234}});
+            CHECK(executor2.shouldSaveSimulation());
+            CHECK_THAT(loggerStream.str(), Catch::Contains("State file found"));
+            CHECK(std::filesystem::is_empty(testDir));
+        }
+    }
+
     SECTION("not storing simulation") {
         MockRestorableSimulation restorableSimulation1(1);
         RestorableSimulationExecutor executor({0, 2, 2}, "N.8_K.8_from.0_to.2_term.value", false, false, testDir);
@@ -0,0 +1,170 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "simulation/SimulationJournal.h"
+#include "simulation/RestorableHelper.h"
+
+namespace {
+    class VectorRestorable : public Restorable {
+    public:
+        std::vector<int> values;
+
+        VectorRestorable() = default;
+        explicit VectorRestorable(std::vector<int> values) : values{std::move(values)} { }
+
+        void storeState(std::ostream &binaryOut) const override {
+            RestorableHelper::storeStateForVector(this->values, binaryOut);
+        }
+
+        void joinRestoredState(std::istream &binaryIn) override {
+            RestorableHelper::joinRestoredStateForVector(this->values, binaryIn);
+        }
+
+        void clear() override { this->values.clear(); }
+    };
+}
+
+TEST_CASE("SimulationJournal") {
+    std::filesystem::path testDir = "SimulationJournal_test/";
+    std::filesystem::remove_all(testDir);
+    std::filesystem::create_directory(testDir);
+    std::filesystem::path journalPath = testDir / "journal.bin";
+
+    SimulationJournal journal(journalPath, {2, 6, 10});
+
+    SECTION("non-existent") {
+        VectorRestorable restorable;
+
+        CHECK_FALSE(journal.restore(restorable));
+        CHECK_FALSE(SimulationJournal::isFinished(journalPath));
+        CHECK(journal.getNextSimulationIndex() == 2);
+    }
+
+    SECTION("appending and restoring") {
+        journal.append(VectorRestorable({1, 2}), 3);
+        journal.append(VectorRestorable({3}), 4);
+
+        SimulationJournal restoredJournal(journalPath, {2, 6, 10});
+        VectorRestorable restorable({0});
+        REQUIRE(restoredJournal.restore(restorable));
+
+        CHECK(restorable.values == std::vector<int>{0, 1, 2, 3});
+        CHECK(restoredJournal.getNextSimulationIndex() == 4);
+        CHECK_FALSE(restoredJournal.isFinished());
+        CHECK_FALSE(restoredJournal.hasDroppedTornRecord());
+        CHECK_FALSE(SimulationJournal::isFinished(journalPath));
+
+        SECTION("finishing") {
+            restoredJournal.append(VectorRestorable({4}), 6);
+
+            CHECK(restoredJournal.isFinished());
+            CHECK(SimulationJournal::isFinished(journalPath));
+        }
+    }
+
+    SECTION("torn final record is dropped") {
+        journal.append(VectorRestorable({1, 2}), 3);
+        auto validSize = std::filesystem::file_size(journalPath);
+        journal.append(VectorRestorable({3, 4, 5}), 4);
+        std::filesystem::resize_file(journalPath, std::filesystem::file_size(journalPath) - 5);
+
+        SimulationJournal restoredJournal(journalPath, {2, 6, 10});
+        VectorRestorable restorable;
+        REQUIRE(restoredJournal.restore(restorable));
+
+        CHECK(restorable.values == std::vector<int>{1, 2});
+        CHECK(restoredJournal.getNextSimulationIndex() == 3);
+        CHECK(restoredJournal.hasDroppedTornRecord());
+        CHECK(std::filesystem::file_size(journalPath) == validSize);
+
+        SECTION("appending after dropping") {
+            restoredJournal.append(VectorRestorable({6}), 4);
+
+            SimulationJournal restoredJournal2(journalPath, {2, 6, 10});
+            VectorRestorable restorable2;
+            REQUIRE(restoredJournal2.restore(restorable2));
+            CHECK(restorable2.values == std::vector<int>{1, 2, 6});
+            CHECK_FALSE(restoredJournal2.hasDroppedTornRecord());
+        }
+    }
+
+    SECTION("corrupted final record is dropped") {
+        journal.append(VectorRestorable({1, 2}), 3);
+        journal.append(VectorRestorable({3}), 4);
+        {
+            std::fstream file(journalPath, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(-1, std::ios::end);
+            file.put('\x7f');
+        }
+
+        SimulationJournal restoredJournal(journalPath, {2, 6, 10});
+        VectorRestorable restorable;
+        REQUIRE(restoredJournal.restore(restorable));
+
+        CHECK(restorable.values == std::vector<int>{1, 2});
+        CHECK(restoredJournal.getNextSimulationIndex() == 3);
+        CHECK(restoredJournal.hasDroppedTornRecord());
+    }
+
+    SECTION("file with invalid header is removed") {
+        SECTION("short") {
+            journal.append(VectorRestorable({1, 2}), 3);
+            std::filesystem::resize_file(journalPath, 12);
+        }
+        SECTION("old format") {
+            std::ofstream file(journalPath, std::ios::out | std::ios::binary);
+            file << "some state file from before the journal";
+        }
+
+        SimulationJournal restoredJournal(journalPath, {2, 6, 10});
+        VectorRestorable restorable;
+        CHECK_FALSE(SimulationJournal::isFinished(journalPath));
+        CHECK_FALSE(restoredJournal.restore(restorable));
+
+        CHECK(restorable.values.empty());
+        CHECK(restoredJournal.getNextSimulationIndex() == 2);
+        CHECK(restoredJournal.hasDroppedInvalidHeader());
+        CHECK_FALSE(std::filesystem::exists(journalPath));
+
+        SECTION("appending after removing") {
+            restoredJournal.append(VectorRestorable({6}), 3);
+
+            SimulationJournal restoredJournal2(journalPath, {2, 6, 10});
+            VectorRestorable restorable2;
+            REQUIRE(restoredJournal2.restore(restorable2));
+            CHECK(restorable2.values == std::vector<int>{6});
+            CHECK_FALSE(restoredJournal2.hasDroppedInvalidHeader());
+        }
+    }
+
+    SECTION("compaction") {
+        SimulationJournal longJournal(journalPath, {0, 1000, 1000});
+        VectorRestorable accumulated;
+        std::size_t numRecordsBeforeCompaction{};
+        for (int i{}; i < 200 && !longJournal.shouldBeCompacted(); i++) {
+            longJournal.append(VectorRestorable({i}), i + 1);
+            accumulated.values.push_back(i);
+            numRecordsBeforeCompaction++;
+        }
+        REQUIRE(longJournal.shouldBeCompacted());
+        CHECK(numRecordsBeforeCompaction == 65);
+
+        longJournal.compact(accumulated);
+
+        CHECK_FALSE(longJournal.shouldBeCompacted());
+        SimulationJournal restoredJournal(journalPath, {0, 1000, 1000});
+        VectorRestorable restorable;
+        REQUIRE(restoredJournal.restore(restorable));
+        CHECK(restorable.values == accumulated.values);
+        CHECK(restoredJournal.getNextSimulationIndex() == 65);
+    }
+
+    std::filesystem::remove_all(testDir);
+}
@@ -0,0 +1,81 @@
+//
+// Created by pkua on 16.10.2026.
+//
+
+#include <catch2/catch.hpp>
+
+#include "utils/Accumulator.h"
+#include "utils/Quantity.h"
+
+TEST_CASE("Accumulator: empty and single sample") {
+    Accumulator accumulator;
+
+    REQUIRE(accumulator.empty());
+    REQUIRE(accumulator.getMean() == 0);
+    REQUIRE(accumulator.getMeanError() == 0);
+
+    accumulator.add(3);
+
+    REQUIRE(accumulator.getCount() == 1);
+    REQUIRE(accumulator.getMean() == 3);
+    REQUIRE(accumulator.getVariance() == 0);
+    REQUIRE(accumulator.getMeanError() == 0);
+}
+
+TEST_CASE("Accumulator: moments") {
+    Accumulator accumulator;
+    for (double sample : {2., 4., 4., 4., 5., 5., 7., 9.})
+        accumulator.add(sample);
+
+    REQUIRE(accumulator.getCount() == 8);
+    REQUIRE(accumulator.getMean() == Approx(5));
+    REQUIRE(accumulator.getVariance() == Approx(32./7));
+    REQUIRE(accumulator.getMeanError() == Approx(std::sqrt(32./7/8)));
+    // Central moments: m2 = 4, m3 = 5.25, m4 = 44.5
+    REQUIRE(accumulator.getSkewness() == Approx(5.25 / 8));
+    REQUIRE(accumulator.getExcessKurtosis() == Approx(44.5 / 16 - 3));
+}
+
+TEST_CASE("Accumulator: merging") {
+    std::vector<double> samples = {0.3, -1.2, 4.5, 2.25, 0.75, -3.5, 1.125, 6.0, -0.5};
+    Accumulator all;
+    for (double sample : samples)
+        all.add(sample);
+
+    SECTION("split in two") {
+        Accumulator first, second;
+        for (std::size_t i{}; i < samples.size(); i++)
+            (i < 4 ? first : second).add(samples[i]);
+        first.merge(second);
+
+        REQUIRE(first.getCount() == all.getCount());
+        REQUIRE(first.getMean() == Approx(all.getMean()));
+        REQUIRE(first.getVariance() == Approx(all.getVariance()));
+        REQUIRE(first.getSkewness() == Approx(all.getSkewness()));
+        REQUIRE(first.getExcessKurtosis() == Approx(all.getExcessKurtosis()));
+    }
+
+    SECTION("with empty") {
+        Accumulator empty;
+        empty.merge(all);
+        empty.merge(Accumulator{});
+
+        REQUIRE(empty.getCount() == all.getCount());
+        REQUIRE(empty.getMean() == all.getMean());
+        REQUIRE(empty.getVariance() == all.getVariance());
+    }
+}
+
+TEST_CASE("Accumulator: quantity matches the one from samples") {
+    std::vector<double> samples = {0.611111, 1, 0.5, 0.75};
+    Accumulator accumulator;
+    for (double sample : samples)
+        accumulator.add(sample);
+
+    Quantity fromSamples, fromAccumulator;
+    fromSamples.calculateFromSamples(samples);
+    fromAccumulator.calculateFromAccumulator(accumulator);
+
+    REQUIRE(fromAccumulator.value == Approx(fromSamples.value));
+    REQUIRE(fromAccumulator.error == Approx(fromSamples.error));
+}
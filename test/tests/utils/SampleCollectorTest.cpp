@@ -0,0 +1,68 @@
+//
+// Created by pkua on 17.10.2026.
+//
+
+#include <sstream>
+
+#include <catch2/catch.hpp>
+
+#include "utils/SampleCollector.h"
+#include "utils/Quantity.h"
+#include "simulation/RestorableHelper.h"
+
+TEST_CASE("SampleCollector: quantity in both modes") {
+    std::vector<double> samples = {0.611111, 1, 0.5, 0.75};
+    SampleCollector keeping;
+    SampleCollector streaming(true);
+    for (double sample : samples) {
+        keeping.add(sample);
+        streaming.add(sample);
+    }
+
+    Quantity fromSamples, fromKeeping, fromStreaming;
+    fromSamples.calculateFromSamples(samples);
+    fromKeeping.calculateFromCollector(keeping);
+    fromStreaming.calculateFromCollector(streaming);
+
+    REQUIRE_FALSE(keeping.isStreaming());
+    REQUIRE(keeping.getSamples() == samples);
+    REQUIRE(fromKeeping.value == fromSamples.value);
+    REQUIRE(fromKeeping.error == fromSamples.error);
+    REQUIRE(streaming.isStreaming());
+    REQUIRE(streaming.getCount() == 4);
+    REQUIRE(fromStreaming.value == Approx(fromSamples.value));
+    REQUIRE(fromStreaming.error == Approx(fromSamples.error));
+}
+
+TEST_CASE("SampleCollector: storing and joining state") {
+    SECTION("keeping samples uses the vector format") {
+        SampleCollector collector;
+        collector.add(1);
+        collector.add(2);
+        std::stringstream collectorState, vectorState;
+        RestorableHelper::storeStateForSampleCollector(collector, collectorState);
+        RestorableHelper::storeStateForVector(std::vector<double>{1, 2}, vectorState);
+        REQUIRE(collectorState.str() == vectorState.str());
+
+        SampleCollector restored;
+        restored.add(3);
+        RestorableHelper::joinRestoredStateForSampleCollector(restored, collectorState);
+        REQUIRE(restored.getSamples() == std::vector<double>{3, 1, 2});
+    }
+
+    SECTION("streaming merges accumulators") {
+        std::vector<SampleCollector> collectors(2, SampleCollector(true));
+        collectors[0].add(1);
+        collectors[1].add(2);
+        std::stringstream state;
+        RestorableHelper::storeStateForSampleCollectors(collectors, state);
+
+        std::vector<SampleCollector> restored(2, SampleCollector(true));
+        restored[0].add(3);
+        RestorableHelper::joinRestoredStateForSampleCollectors(restored, state);
+        REQUIRE(restored[0].getCount() == 2);
+        REQUIRE(restored[0].getMean() == Approx(2));
+        REQUIRE(restored[1].getCount() == 1);
+        REQUIRE(restored[1].getMean() == Approx(2));
+    }
+}